@@ -1,26 +1,58 @@
 #pragma once
 
-#include <thread>
+#include "../application/tsc.h"
+
 #include <chrono>
+#include <cstddef>
+#include <cstdint>
 
 namespace application {
 namespace pc {
 
+//==========================================================
+// A unit of work for the consumers to execute. It spins for
+// the given time against the calibrated timestamp counter,
+// see application/tsc.h, rather than yielding, which
+// would measure the scheduler instead of the structure
+//==========================================================
 class RandomComputationCommand
 {
 public:
     void execute(std::chrono::nanoseconds time) const noexcept
     {
-        auto start = std::chrono::high_resolution_clock::now();
-        auto end = start + time;
-
-        do 
-        {
-            std::this_thread::yield();
-        } 
-        while (std::chrono::high_resolution_clock::now() < end);
+        tsc::spin_for(time);
     }
 };
 
+//==========================================================
+// A command that carries a payload of the given size, so
+// that benchmarks can measure the cost of moving values
+// through a structure
+//==========================================================
+template<std::size_t Size>
+class PayloadCommand : public RandomComputationCommand
+{
+private:
+    char m_Payload[Size];
+};
+
+//==========================================================
+// A command stamped with the time it was produced, so that
+// benchmarks can measure how long it spent in a structure
+//==========================================================
+class TimestampedCommand : public RandomComputationCommand
+{
+public:
+    TimestampedCommand() = default;
+
+    explicit TimestampedCommand(std::uint64_t stamp)
+        : m_Stamp(stamp) {}
+
+    std::uint64_t stamp() const noexcept { return m_Stamp; }
+
+private:
+    std::uint64_t m_Stamp = 0;
+};
+
 }  // namespace pc
 }  // namespace application
@@ -0,0 +1,381 @@
+#pragma once
+
+#include "../src/cds/deque/work_stealing_deque.h"
+#include "../src/cds/queue/lockfree_queue.h"
+#include "../src/cds/queue/locked_queue.h"
+#include "../src/utility/backoff.h"
+#include "../src/utility/event_count.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <type_traits>
+
+namespace application {
+
+//==========================================================
+// Executors that run tasks on a fixed set of worker threads,
+// built on the project's own structures:
+//
+//   WorkStealingExecutor     - Each worker has a Chase-Lev
+//                              deque for the tasks it spawns,
+//                              and steals from the others
+//                              when it runs out. Outside
+//                              threads submit to a shared
+//                              injection queue
+//   SharedQueueExecutor<Q>   - Every task goes through one
+//                              queue that all workers share,
+//                              e.g. a LockFreeQueue or a
+//                              LockedQueue. This is the design
+//                              the first one is measured
+//                              against
+//
+// Both park idle workers on an eventcount, so submitting
+// only costs a syscall when a worker is actually asleep. On
+// destruction they run every task that's still queued,
+// including any those tasks submit, then join the workers
+//==========================================================
+namespace executor {
+
+//==========================================================
+// A unit of work. Tasks are submitted by pointer and are
+// owned by the caller, who must keep them alive until they
+// have run; a task may delete itself at the end of run()
+//==========================================================
+class Task
+{
+public:
+    virtual ~Task() = default;
+    virtual void run() = 0;
+};
+
+//==========================================================
+// A task that calls a function once and deletes itself,
+// which is what the executors' submit(function) allocates
+//==========================================================
+template<typename Function>
+class FunctionTask : public Task
+{
+public:
+    explicit FunctionTask(Function function)
+        : m_Function(std::move(function)) {}
+
+    virtual void run() override
+    {
+        m_Function();
+        delete this;
+    }
+
+private:
+    Function m_Function;
+};
+
+// The times an idle worker looks for work again before it
+// parks. Each look tries every source of work once
+constexpr std::size_t kSearchesBeforeParking = 16;
+
+//==========================================================
+// The worker threads, and the parking shared by both
+// executors. Derived provides find(worker, task), which
+// looks everywhere the worker may take a task from
+//==========================================================
+template<typename Derived>
+class Workers
+{
+public:
+    std::size_t worker_count() const { return m_Threads.size(); }
+
+protected:
+    Workers() = default;
+    ~Workers() = default;
+
+    // Prevent copying
+    Workers(const Workers& other) = delete;
+    Workers& operator=(const Workers& other) = delete;
+
+    static std::size_t default_workers()
+    {
+        auto count = std::thread::hardware_concurrency();
+        return count == 0 ? 1 : count;
+    }
+
+    //======================================================
+    // Starts \param{count} workers. Derived's state must be
+    // fully constructed first
+    //======================================================
+    void start(std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            m_Threads.emplace_back([this, i] { run(i); });
+    }
+
+    //======================================================
+    // Lets the workers finish the queued tasks, and joins
+    // them. Derived's destructor must call it
+    //======================================================
+    void stop()
+    {
+        m_Stopping.store(true, std::memory_order_release);
+        m_Idle.notify_all();
+
+        for (auto& thread : m_Threads)
+            thread.join();
+
+        m_Threads.clear();
+    }
+
+    void notify_one() { m_Idle.notify_one(); }
+    void notify_all() { m_Idle.notify_all(); }
+
+    //======================================================
+    // Returns the index of the calling worker if it belongs
+    // to this executor, or -1 for any other thread
+    //======================================================
+    long current_worker() const
+    {
+        auto& current = this_worker();
+        return current.first == this ? current.second : -1;
+    }
+
+private:
+    static std::pair<const void*, long>& this_worker()
+    {
+        static thread_local std::pair<const void*, long> current{ nullptr, -1 };
+        return current;
+    }
+
+    //======================================================
+    // A worker's loop. It runs tasks while it finds them,
+    // searches a while when it doesn't, and then parks until
+    // a submission wakes it. It announces that it's about to
+    // park before searching one last time, so a submission
+    // that races with the search still wakes it
+    //======================================================
+    void run(std::size_t worker)
+    {
+        this_worker() = std::make_pair(static_cast<const void*>(this), static_cast<long>(worker));
+
+        Task* pTask = nullptr;
+        while (true)
+        {
+            auto found = false;
+            for (std::size_t search = 0; search < kSearchesBeforeParking && !found; ++search)
+            {
+                found = derived().find(worker, pTask);
+                if (!found)
+                    utility::cpu_relax();
+            }
+
+            if (found)
+            {
+                pTask->run();
+                continue;
+            }
+
+            auto key = m_Idle.prepare_wait();
+            if (derived().find(worker, pTask))
+            {
+                m_Idle.cancel_wait();
+                pTask->run();
+                continue;
+            }
+
+            if (m_Stopping.load(std::memory_order_acquire))
+            {
+                m_Idle.cancel_wait();
+                return;
+            }
+
+            m_Idle.wait(key);
+        }
+    }
+
+    Derived& derived() { return static_cast<Derived&>(*this); }
+
+    std::vector<std::thread> m_Threads;
+    std::atomic<bool> m_Stopping{ false };
+    utility::EventCount m_Idle;
+};
+
+//==========================================================
+// Runs tasks on workers that each own a work-stealing deque.
+// A task submitted by a worker goes onto that worker's
+// deque, where the worker finds it again without touching
+// shared state. Outside threads submit to the injection
+// queue, from which workers take a batch at a time. A worker
+// with nothing of its own steals, starting from a random
+// victim so that thieves spread out
+//==========================================================
+class WorkStealingExecutor : public Workers<WorkStealingExecutor>
+{
+public:
+    // The most tasks a worker takes from the injection queue
+    // at once. The rest of the batch goes onto its deque, where
+    // other workers can steal it
+    static constexpr std::size_t kInjectionBatch = 32;
+
+    explicit WorkStealingExecutor(std::size_t workers = default_workers())
+    {
+        for (std::size_t i = 0; i < workers; ++i)
+            m_Deques.emplace_back(new Deque{});
+
+        start(workers);
+    }
+
+    ~WorkStealingExecutor() { stop(); }
+
+    //======================================================
+    // Submits a task, onto the calling worker's deque or
+    // else onto the injection queue
+    //======================================================
+    void submit(Task* pTask)
+    {
+        auto worker = current_worker();
+        if (worker >= 0)
+            m_Deques[static_cast<std::size_t>(worker)]->push(pTask);
+        else
+            m_Injection.enqueue(pTask);
+
+        notify_one();
+    }
+
+    template<typename Function, typename = typename std::enable_if<
+        !std::is_convertible<Function, Task*>::value>::type>
+    void submit(Function function)
+    {
+        submit(static_cast<Task*>(new FunctionTask<Function>(std::move(function))));
+    }
+
+    //======================================================
+    // Submits the tasks in [first, last) with one wake up.
+    // Outside threads enqueue them in one go
+    //======================================================
+    template<typename InputIt>
+    void submit_bulk(InputIt first, InputIt last)
+    {
+        if (first == last)
+            return;
+
+        auto worker = current_worker();
+        if (worker >= 0)
+        {
+            for (; first != last; ++first)
+                m_Deques[static_cast<std::size_t>(worker)]->push(*first);
+        }
+        else
+        {
+            m_Injection.enqueue_bulk(first, last);
+        }
+
+        notify_all();
+    }
+
+private:
+    friend class Workers<WorkStealingExecutor>;
+
+    using Deque = deque::direct::WorkStealingDeque<Task*>;
+
+    //======================================================
+    // Looks for a task for \param{worker}: on its own deque,
+    // then on the injection queue, then on the others'
+    // deques
+    //======================================================
+    bool find(std::size_t worker, Task*& pTask)
+    {
+        auto& own = *m_Deques[worker];
+        if (own.pop(pTask))
+            return true;
+
+        if (m_Injection.dequeue(pTask))
+        {
+            // Take a batch, so the injection queue's ends are
+            // touched once per batch rather than once per task
+            Task* pExtra = nullptr;
+            std::size_t taken = 1;
+            while (taken < kInjectionBatch && m_Injection.dequeue(pExtra))
+            {
+                own.push(pExtra);
+                ++taken;
+            }
+
+            if (taken > 1)
+                notify_one();
+
+            return true;
+        }
+
+        auto count = m_Deques.size();
+        auto start = static_cast<std::size_t>(utility::backoff::next_random()) % count;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            auto victim = (start + i) % count;
+            if (victim != worker && m_Deques[victim]->steal(pTask))
+                return true;
+        }
+
+        return false;
+    }
+
+    std::vector<std::unique_ptr<Deque>> m_Deques;
+    queue::direct::LockFreeQueue<Task*> m_Injection;
+};
+
+//==========================================================
+// Runs tasks on workers that all take them from one shared
+// queue, whoever submitted them
+//
+// \tparam Queue  - A queue::direct queue of Task*
+//==========================================================
+template<typename Queue>
+class SharedQueueExecutor : public Workers<SharedQueueExecutor<Queue>>
+{
+public:
+    explicit SharedQueueExecutor(std::size_t workers = Workers<SharedQueueExecutor>::default_workers())
+    {
+        this->start(workers);
+    }
+
+    ~SharedQueueExecutor() { this->stop(); }
+
+    void submit(Task* pTask)
+    {
+        m_Queue.enqueue(pTask);
+        this->notify_one();
+    }
+
+    template<typename Function, typename = typename std::enable_if<
+        !std::is_convertible<Function, Task*>::value>::type>
+    void submit(Function function)
+    {
+        submit(static_cast<Task*>(new FunctionTask<Function>(std::move(function))));
+    }
+
+    template<typename InputIt>
+    void submit_bulk(InputIt first, InputIt last)
+    {
+        if (first == last)
+            return;
+
+        m_Queue.enqueue_bulk(first, last);
+        this->notify_all();
+    }
+
+private:
+    friend class Workers<SharedQueueExecutor>;
+
+    bool find(std::size_t, Task*& pTask)
+    {
+        return m_Queue.dequeue(pTask);
+    }
+
+    Queue m_Queue;
+};
+
+using LockFreeQueueExecutor = SharedQueueExecutor<queue::direct::LockFreeQueue<Task*>>;
+using LockedQueueExecutor = SharedQueueExecutor<queue::direct::LockedQueue<Task*>>;
+
+}  // namespace executor
+}  // namespace application
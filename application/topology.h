@@ -0,0 +1,412 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <utility>
+#include <algorithm>
+#include <initializer_list>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <dirent.h>
+#endif
+
+namespace application {
+
+//==========================================================
+// Where the benchmark threads run. The host's layout is read
+// from /sys/devices/system/cpu, and threads are pinned to
+// logical CPUs so that producers and consumers talk across a
+// chosen distance: two hyperthreads of a core, two cores of
+// a socket, two NUMA nodes, or two sockets. Pinning is only supported on
+// Linux; elsewhere every thread runs unpinned
+//==========================================================
+namespace topology {
+
+//==========================================================
+// A logical CPU, and the core, socket and NUMA node it
+// belongs to
+//==========================================================
+struct Cpu
+{
+    int id;
+    int core;
+    int socket;
+    int node;
+};
+
+//==========================================================
+// The placements the fixtures can run under:
+//
+//   Unpinned     - The scheduler decides, as before
+//   Explicit     - Producers and consumers run on the CPUs
+//                  listed in CDS_PRODUCER_CPUS and
+//                  CDS_CONSUMER_CPUS, e.g. "0,2,4-7"
+//   SmtSiblings  - Threads 2k and 2k+1 share a core
+//   SameSocket   - Every thread has its own core, all on
+//                  one socket
+//   CrossNode    - Every thread has its own core, and
+//                  consecutive threads are on different
+//                  NUMA nodes, which may share a socket
+//                  when it's split into several nodes
+//   CrossSocket  - Every thread has its own core, and
+//                  consecutive threads are on different
+//                  sockets
+//
+// Under the 1:1 profile even threads consume and odd threads
+// produce, so each producer is paired with a consumer at the
+// placement's distance
+//==========================================================
+enum class Placement { Unpinned, Explicit, SmtSiblings, SameSocket, CrossNode, CrossSocket };
+
+// What Topology::cpu_for returns when the host can't provide
+// a placement, e.g. CrossSocket on a single socket
+constexpr int kUnavailable = -2;
+
+inline const char* placement_name(Placement placement)
+{
+    switch (placement)
+    {
+    case Placement::Explicit:       return "explicit";
+    case Placement::SmtSiblings:    return "smt";
+    case Placement::SameSocket:     return "same_socket";
+    case Placement::CrossNode:      return "cross_node";
+    case Placement::CrossSocket:    return "cross_socket";
+    default:                        return "unpinned";
+    }
+}
+
+//==========================================================
+// Parses a CPU list in the kernel's format, e.g. "0-3,8,10"
+//==========================================================
+inline std::vector<int> parse_cpu_list(const std::string& list)
+{
+    std::vector<int> cpus;
+
+    std::size_t pos = 0;
+    while (pos < list.size())
+    {
+        auto end = list.find(',', pos);
+        if (end == std::string::npos)
+            end = list.size();
+
+        auto range = list.substr(pos, end - pos);
+        auto dash = range.find('-');
+        if (!range.empty() && range.find_first_not_of("0123456789-\n ") == std::string::npos)
+        {
+            auto first = std::atoi(range.c_str());
+            auto last = dash == std::string::npos ? first : std::atoi(range.c_str() + dash + 1);
+
+            for (auto cpu = first; cpu <= last; ++cpu)
+                cpus.push_back(cpu);
+        }
+
+        pos = end + 1;
+    }
+
+    return cpus;
+}
+
+//==========================================================
+// The logical CPUs this process may run on
+//==========================================================
+class Topology
+{
+public:
+    //======================================================
+    // Returns the host's topology, discovered on first use
+    //======================================================
+    static const Topology& host()
+    {
+        static const Topology topology{ discover() };
+        return topology;
+    }
+
+    const std::vector<Cpu>& cpus() const { return m_Cpus; }
+
+    //======================================================
+    // Returns the CPU thread \param{index} of \param{count}
+    // runs on under \param{placement}
+    //
+    // \param produces  - Whether the thread is a producer
+    // \param rank      - The thread's index among the
+    //                    threads with the same role
+    //
+    // \return          - The CPU, -1 to leave the thread
+    //                    unpinned, or kUnavailable
+    //======================================================
+    int cpu_for(Placement placement, int index, int count, bool produces, int rank) const
+    {
+        if (placement == Placement::Unpinned || m_Cpus.empty())
+            return placement == Placement::Unpinned ? -1 : kUnavailable;
+
+        if (placement == Placement::Explicit)
+        {
+            auto cpus = parse_cpu_list(env(produces ? "CDS_PRODUCER_CPUS" : "CDS_CONSUMER_CPUS"));
+            return cpus.empty() ? kUnavailable : cpus[static_cast<std::size_t>(rank) % cpus.size()];
+        }
+
+        if (placement == Placement::SmtSiblings)
+        {
+            // A lone thread can run on any core
+            auto cores = this->cores(-1);
+            auto core = static_cast<std::size_t>(index / 2);
+            if (count == 1)
+                return cores.front().front();
+
+            if (core >= cores.size() || cores[core].size() < 2)
+                return kUnavailable;
+
+            return cores[core][static_cast<std::size_t>(index % 2)];
+        }
+
+        auto sockets = this->sockets();
+        if (placement == Placement::SameSocket)
+        {
+            // The socket with the most cores
+            auto best = sockets.front();
+            for (auto socket : sockets)
+            {
+                if (cores(socket).size() > cores(best).size())
+                    best = socket;
+            }
+
+            auto cores = this->cores(best);
+            if (static_cast<std::size_t>(count) > cores.size())
+                return kUnavailable;
+
+            return cores[static_cast<std::size_t>(index)].front();
+        }
+
+        // CrossNode and CrossSocket: alternate between the first
+        // two nodes or sockets
+        auto crossNode = placement == Placement::CrossNode;
+        auto domains = crossNode ? nodes() : sockets;
+        auto coresIn = [&](int domain) { return crossNode ? cores(-1, domain) : cores(domain); };
+
+        if (count == 1)
+            return coresIn(domains.front()).front().front();
+
+        if (domains.size() < 2)
+            return kUnavailable;
+
+        auto cores = coresIn(domains[static_cast<std::size_t>(index % 2)]);
+        auto core = static_cast<std::size_t>(index / 2);
+        return core < cores.size() ? cores[core].front() : kUnavailable;
+    }
+
+private:
+    explicit Topology(std::vector<Cpu> cpus)
+        : m_Cpus(std::move(cpus)) {}
+
+    static std::string env(const char* name)
+    {
+        auto pValue = std::getenv(name);
+        return pValue ? pValue : "";
+    }
+
+    static int read_int(const std::string& path, int fallback)
+    {
+        std::ifstream file{ path };
+        int value = fallback;
+        if (!(file >> value))
+            return fallback;
+
+        return value;
+    }
+
+    //======================================================
+    // Reads the layout of every CPU in this process's
+    // affinity mask. A CPU whose topology can't be read is
+    // treated as a core of its own on socket 0
+    //======================================================
+    static std::vector<Cpu> discover()
+    {
+        std::vector<Cpu> cpus;
+
+#if defined(__linux__)
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+            return cpus;
+
+        std::ifstream online{ "/sys/devices/system/cpu/online" };
+        std::string list;
+        std::getline(online, list);
+
+        auto ids = parse_cpu_list(list);
+        if (ids.empty())
+        {
+            for (auto id = 0; id < CPU_SETSIZE; ++id)
+                ids.push_back(id);
+        }
+
+        for (auto id : ids)
+        {
+            if (id >= CPU_SETSIZE || !CPU_ISSET(id, &allowed))
+                continue;
+
+            auto path = "/sys/devices/system/cpu/cpu" + std::to_string(id);
+            Cpu cpu{ id, read_int(path + "/topology/core_id", id),
+                     read_int(path + "/topology/physical_package_id", 0), 0 };
+
+            // The node is only named by a nodeN link in the CPU's directory
+            if (auto pDir = ::opendir(path.c_str()))
+            {
+                while (auto pEntry = ::readdir(pDir))
+                {
+                    std::string name = pEntry->d_name;
+                    if (name.compare(0, 4, "node") == 0 && name.size() > 4 && std::isdigit(static_cast<unsigned char>(name[4])))
+                        cpu.node = std::atoi(name.c_str() + 4);
+                }
+
+                ::closedir(pDir);
+            }
+
+            cpus.push_back(cpu);
+        }
+#endif
+
+        return cpus;
+    }
+
+    // The sockets that have CPUs, in order
+    std::vector<int> sockets() const { return distinct(&Cpu::socket); }
+
+    // The NUMA nodes that have CPUs, in order
+    std::vector<int> nodes() const { return distinct(&Cpu::node); }
+
+    std::vector<int> distinct(int Cpu::*field) const
+    {
+        std::vector<int> values;
+        for (auto& cpu : m_Cpus)
+        {
+            if (std::find(values.begin(), values.end(), cpu.*field) == values.end())
+                values.push_back(cpu.*field);
+        }
+
+        std::sort(values.begin(), values.end());
+        return values;
+    }
+
+    //======================================================
+    // Returns the CPUs of each core on \param{socket} and
+    // \param{node}, either of which is -1 to take them all.
+    // Cores are ordered by socket and core id, and their
+    // CPUs by id
+    //======================================================
+    std::vector<std::vector<int>> cores(int socket, int node = -1) const
+    {
+        auto cpus = m_Cpus;
+        std::sort(cpus.begin(), cpus.end(), [](const Cpu& lhs, const Cpu& rhs)
+        {
+            if (lhs.socket != rhs.socket)
+                return lhs.socket < rhs.socket;
+
+            return lhs.core != rhs.core ? lhs.core < rhs.core : lhs.id < rhs.id;
+        });
+
+        std::vector<std::vector<int>> cores;
+        const Cpu* pLast = nullptr;
+        for (auto& cpu : cpus)
+        {
+            if ((socket != -1 && cpu.socket != socket) || (node != -1 && cpu.node != node))
+                continue;
+
+            if (!pLast || pLast->socket != cpu.socket || pLast->core != cpu.core)
+                cores.emplace_back();
+
+            cores.back().push_back(cpu.id);
+            pLast = &cpu;
+        }
+
+        return cores;
+    }
+
+    std::vector<Cpu> m_Cpus;
+};
+
+//==========================================================
+// Returns the placement to run unpinned workloads under,
+// from CDS_PLACEMENT: one of the names placement_name()
+// returns. Without it, threads are placed explicitly if
+// CDS_PRODUCER_CPUS or CDS_CONSUMER_CPUS is set, and are
+// otherwise left unpinned
+//==========================================================
+inline Placement default_placement()
+{
+    static const Placement placement = []() -> Placement
+    {
+        if (auto pName = std::getenv("CDS_PLACEMENT"))
+        {
+            for (auto candidate : { Placement::Explicit, Placement::SmtSiblings, Placement::SameSocket, Placement::CrossNode, Placement::CrossSocket })
+            {
+                if (std::string{ pName } == placement_name(candidate))
+                    return candidate;
+            }
+
+            return Placement::Unpinned;
+        }
+
+        if (std::getenv("CDS_PRODUCER_CPUS") || std::getenv("CDS_CONSUMER_CPUS"))
+            return Placement::Explicit;
+
+        return Placement::Unpinned;
+    }();
+
+    return placement;
+}
+
+//==========================================================
+// Pins the calling thread to a CPU for its lifetime, and
+// restores the thread's previous affinity when destroyed
+//==========================================================
+class Pin
+{
+public:
+    //======================================================
+    // \param cpu   - The CPU to run on, or a negative value
+    //                to leave the thread where it is
+    //======================================================
+    explicit Pin(int cpu)
+    {
+#if defined(__linux__)
+        if (cpu < 0 || cpu >= CPU_SETSIZE || ::sched_getaffinity(0, sizeof(m_Previous), &m_Previous) != 0)
+            return;
+
+        cpu_set_t target;
+        CPU_ZERO(&target);
+        CPU_SET(cpu, &target);
+
+        m_Pinned = ::sched_setaffinity(0, sizeof(target), &target) == 0;
+#else
+        (void)cpu;
+#endif
+    }
+
+    ~Pin()
+    {
+#if defined(__linux__)
+        if (m_Pinned)
+            ::sched_setaffinity(0, sizeof(m_Previous), &m_Previous);
+#endif
+    }
+
+    // Prevent copying
+    Pin(const Pin& other) = delete;
+    Pin& operator=(const Pin& other) = delete;
+
+    bool pinned() const { return m_Pinned; }
+
+private:
+#if defined(__linux__)
+    cpu_set_t m_Previous;
+#endif
+    bool m_Pinned = false;
+};
+
+}  // namespace topology
+}  // namespace application
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "../src/utility/backoff.h"
+
+#include <chrono>
+#include <cstdint>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+namespace application {
+
+//==========================================================
+// Timestamps for the workloads and benchmarks. On x86 they're
+// read from the time stamp counter, which costs a few
+// nanoseconds and is synchronized across cores on any
+// processor with an invariant TSC. Elsewhere they fall back
+// to the steady clock, in nanoseconds
+//==========================================================
+namespace tsc {
+
+inline std::uint64_t now()
+{
+#if defined(_MSC_VER) || defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+//==========================================================
+// Measures how many ticks pass per nanosecond, against the
+// steady clock. It's measured once, on first use, which
+// takes about 20ms; call it before timing anything
+//==========================================================
+inline double ticks_per_ns()
+{
+    static const double rate = []
+    {
+        using clock = std::chrono::steady_clock;
+
+        auto start = clock::now();
+        auto startTicks = now();
+
+        while (clock::now() - start < std::chrono::milliseconds(20));
+
+        auto ticks = static_cast<double>(now() - startTicks);
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - start).count();
+        return ticks / static_cast<double>(elapsed);
+    }();
+
+    return rate;
+}
+
+//==========================================================
+// Converts a duration to ticks
+//==========================================================
+inline std::uint64_t to_ticks(std::chrono::nanoseconds time)
+{
+    return static_cast<std::uint64_t>(static_cast<double>(time.count()) * ticks_per_ns());
+}
+
+//==========================================================
+// Spins for \param{ticks} timestamp ticks, which is the
+// processor's reference cycles on x86. The thread never
+// gives up its core, so short work items cost what they
+// say rather than a trip through the scheduler
+//==========================================================
+inline void spin_ticks(std::uint64_t ticks)
+{
+    if (ticks == 0)
+        return;
+
+    auto end = now() + ticks;
+    while (now() < end)
+        utility::cpu_relax();
+}
+
+//==========================================================
+// Spins for \param{time}, see spin_ticks
+//==========================================================
+inline void spin_for(std::chrono::nanoseconds time)
+{
+    if (time.count() > 0)
+        spin_ticks(to_ticks(time));
+}
+
+}  // namespace tsc
+}  // namespace application
@@ -0,0 +1,265 @@
+#pragma once
+
+#include "../application/tsc.h"
+#include "../application/topology.h"
+
+#include <cmath>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+
+namespace application {
+namespace workload {
+
+//==========================================================
+// A cheap per-thread random source (xorshift64*), so that
+// sampling the workload doesn't add a shared or expensive
+// generator to the loop being measured
+//==========================================================
+class Random
+{
+public:
+    explicit Random(std::uint64_t seed)
+        : m_State(seed * 0x9E3779B97F4A7C15ull | 1) {}
+
+    std::uint64_t next()
+    {
+        m_State ^= m_State >> 12;
+        m_State ^= m_State << 25;
+        m_State ^= m_State >> 27;
+        return m_State * 0x2545F4914F6CDD1Dull;
+    }
+
+    // Returns a value in [0, 1)
+    double uniform()
+    {
+        return static_cast<double>(next() >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+private:
+    std::uint64_t m_State;
+};
+
+//==========================================================
+// A distribution of durations, used for the consumers' work
+// per item and the producers' think time between items
+//==========================================================
+class Distribution
+{
+public:
+    enum class Kind { Constant, Uniform, Exponential };
+
+    // No time at all
+    Distribution() = default;
+
+    // Always \param{mean}
+    static Distribution constant(std::chrono::nanoseconds mean) { return { Kind::Constant, mean }; }
+
+    // Uniform over [0, 2 * \param{mean}]
+    static Distribution uniform(std::chrono::nanoseconds mean) { return { Kind::Uniform, mean }; }
+
+    // Exponential with the given mean, as for Poisson arrivals
+    static Distribution exponential(std::chrono::nanoseconds mean) { return { Kind::Exponential, mean }; }
+
+    std::chrono::nanoseconds mean() const { return m_Mean; }
+
+    std::chrono::nanoseconds sample(Random& random) const
+    {
+        auto mean = static_cast<double>(m_Mean.count());
+
+        switch (m_Kind)
+        {
+        case Kind::Uniform:
+            return std::chrono::nanoseconds(static_cast<std::int64_t>(2.0 * mean * random.uniform()));
+        case Kind::Exponential:
+            return std::chrono::nanoseconds(static_cast<std::int64_t>(-mean * std::log(1.0 - random.uniform())));
+        default:
+            return m_Mean;
+        }
+    }
+
+private:
+    Distribution(Kind kind, std::chrono::nanoseconds mean)
+        : m_Kind(kind), m_Mean(mean) {}
+
+    Kind m_Kind = Kind::Constant;
+    std::chrono::nanoseconds m_Mean{ 0 };
+};
+
+//==========================================================
+// How producers space their items out, on top of their think
+// time:
+//
+//   steady()          - Evenly, by the think time alone
+//   bursty(n, gap)    - In bursts of n items with no think
+//                       time, separated by an idle gap
+//   phased(n, factor) - Alternating phases of n items, the
+//                       second of which thinks factor times
+//                       as long, like a daily peak and trough
+//==========================================================
+class Arrival
+{
+public:
+    enum class Kind { Steady, Bursty, Phased };
+
+    Arrival() = default;
+
+    static Arrival steady() { return {}; }
+
+    static Arrival bursty(std::size_t burst, std::chrono::nanoseconds gap)
+    {
+        return { Kind::Bursty, burst, gap, 1 };
+    }
+
+    static Arrival phased(std::size_t period, unsigned slowdown)
+    {
+        return { Kind::Phased, period, std::chrono::nanoseconds(0), slowdown };
+    }
+
+    Kind kind() const { return m_Kind; }
+    std::size_t period() const { return m_Period; }
+    std::chrono::nanoseconds gap() const { return m_Gap; }
+    unsigned slowdown() const { return m_Slowdown; }
+
+private:
+    Arrival(Kind kind, std::size_t period, std::chrono::nanoseconds gap, unsigned slowdown)
+        : m_Kind(kind), m_Period(period == 0 ? 1 : period), m_Gap(gap), m_Slowdown(slowdown) {}
+
+    Kind m_Kind = Kind::Steady;
+    std::size_t m_Period = 1;
+    std::chrono::nanoseconds m_Gap{ 0 };
+    unsigned m_Slowdown = 1;
+};
+
+//==========================================================
+// Describes a producer/consumer workload: how the threads
+// split into producers and consumers and where they run,
+// how producers pace their items, and how long consumers
+// work on each one. The
+// payload size is the size of the value type the structure
+// is instantiated with, e.g. application::pc::PayloadCommand
+//==========================================================
+struct Profile
+{
+    // Threads are assigned round robin in groups of producers +
+    // consumers; the consumers come first in each group. With
+    // fewer threads than a group, they alternate instead
+    unsigned producers = 1;
+    unsigned consumers = 1;
+
+    // Unpinned runs follow topology::default_placement()
+    topology::Placement placement = topology::Placement::Unpinned;
+
+    Arrival arrival;
+    Distribution think;
+    Distribution work;
+
+    Profile& ratio(unsigned producerCount, unsigned consumerCount)
+    {
+        producers = producerCount;
+        consumers = consumerCount;
+        return *this;
+    }
+
+    Profile& place(topology::Placement where) { placement = where; return *this; }
+    Profile& arrive(Arrival pattern) { arrival = pattern; return *this; }
+    Profile& think_for(Distribution time) { think = time; return *this; }
+    Profile& work_for(Distribution time) { work = time; return *this; }
+
+    //======================================================
+    // Returns whether thread \param{index} of \param{count}
+    // produces. A lone thread both produces and consumes
+    //======================================================
+    bool produces(int index, int count) const
+    {
+        auto group = producers + consumers;
+        if (count == 1)
+            return true;
+
+        if (static_cast<unsigned>(count) < group)
+            return index % 2 == 1;
+
+        return static_cast<unsigned>(index) % group >= consumers;
+    }
+
+    bool consumes(int index, int count) const
+    {
+        return count == 1 || !produces(index, count);
+    }
+
+    //======================================================
+    // Returns thread \param{index}'s position among the
+    // threads that share its role
+    //======================================================
+    int rank(int index, int count) const
+    {
+        auto role = produces(index, count);
+
+        int rank = 0;
+        for (int i = 0; i < index; ++i)
+        {
+            if (produces(i, count) == role)
+                ++rank;
+        }
+
+        return rank;
+    }
+
+    // Returns the placement the threads actually run under
+    topology::Placement where() const
+    {
+        return placement == topology::Placement::Unpinned ? topology::default_placement() : placement;
+    }
+
+    //======================================================
+    // Returns the CPU thread \param{index} of \param{count}
+    // should run on, see topology::Topology::cpu_for
+    //======================================================
+    int cpu_for(int index, int count) const
+    {
+        return topology::Topology::host().cpu_for(where(), index, count, produces(index, count), rank(index, count));
+    }
+};
+
+//==========================================================
+// Paces one producer thread according to a Profile. Call
+// wait() before producing each item
+//==========================================================
+class Pacer
+{
+public:
+    Pacer(const Profile& profile, Random& random)
+        : m_Profile(profile), m_Random(random) {}
+
+    void wait()
+    {
+        auto& arrival = m_Profile.arrival;
+        auto position = m_Produced++ % (arrival.kind() == Arrival::Kind::Phased ? 2 * arrival.period() : arrival.period());
+
+        switch (arrival.kind())
+        {
+        case Arrival::Kind::Bursty:
+            // Idle before each burst, and produce the burst back to back
+            if (position == 0)
+                tsc::spin_for(arrival.gap());
+            break;
+        case Arrival::Kind::Phased:
+            if (position >= arrival.period())
+                tsc::spin_for(m_Profile.think.sample(m_Random) * arrival.slowdown());
+            else
+                tsc::spin_for(m_Profile.think.sample(m_Random));
+            break;
+        default:
+            tsc::spin_for(m_Profile.think.sample(m_Random));
+            break;
+        }
+    }
+
+private:
+    const Profile& m_Profile;
+    Random& m_Random;
+    std::size_t m_Produced = 0;
+};
+
+}  // namespace workload
+}  // namespace application
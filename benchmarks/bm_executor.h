@@ -0,0 +1,291 @@
+#pragma once
+
+#include "../application/executor.h"
+#include "../application/command.h"
+#include "../application/tsc.h"
+#include "../benchmarks/bm_instrumentation.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+//------------------------------------------------------------------------
+// Executor benchmarks. The work-stealing executor against the same pool
+// of workers sharing one LockFreeQueue or one LockedQueue. The benchmark
+// thread submits the way a server's accept loop would, and the number of
+// workers is the benchmark's argument
+//------------------------------------------------------------------------
+
+//------------------------------------------------------------------------
+// A request: a command executed for a fixed time. Requests are reused,
+// so each one says when it has run
+//------------------------------------------------------------------------
+class RequestTask : public application::executor::Task
+{
+public:
+    virtual void run() override
+    {
+        m_Command.execute(m_Work);
+        m_Done.store(true, std::memory_order_release);
+    }
+
+    void reset(std::chrono::nanoseconds work)
+    {
+        m_Work = work;
+        m_Done.store(false, std::memory_order_relaxed);
+    }
+
+    bool done() const { return m_Done.load(std::memory_order_acquire); }
+
+private:
+    application::pc::RandomComputationCommand m_Command;
+    std::chrono::nanoseconds m_Work{ 0 };
+    std::atomic<bool> m_Done{ true };
+};
+
+//------------------------------------------------------------------------
+// A node of a binary task tree. Each node executes its command and then
+// submits its children from the worker that ran it, as a divide and
+// conquer handler would. The leaves count down the tree's remaining
+// leaves
+//------------------------------------------------------------------------
+template<typename Executor>
+class TreeTask : public application::executor::Task
+{
+public:
+    virtual void run() override
+    {
+        m_Command.execute(m_Work);
+
+        auto left = 2 * m_Index + 1;
+        if (left >= m_pTree->size())
+        {
+            m_pRemaining->fetch_sub(1, std::memory_order_release);
+            return;
+        }
+
+        m_pExecutor->submit(&(*m_pTree)[left]);
+        m_pExecutor->submit(&(*m_pTree)[left + 1]);
+    }
+
+    void reset(Executor* pExecutor, std::vector<TreeTask>* pTree, std::size_t index,
+               std::atomic<std::size_t>* pRemaining, std::chrono::nanoseconds work)
+    {
+        m_pExecutor = pExecutor;
+        m_pTree = pTree;
+        m_Index = index;
+        m_pRemaining = pRemaining;
+        m_Work = work;
+    }
+
+private:
+    application::pc::RandomComputationCommand m_Command;
+    Executor* m_pExecutor = nullptr;
+    std::vector<TreeTask>* m_pTree = nullptr;
+    std::size_t m_Index = 0;
+    std::atomic<std::size_t>* m_pRemaining = nullptr;
+    std::chrono::nanoseconds m_Work{ 0 };
+};
+
+template<typename Executor>
+class ExecutorFixture : public benchmark::Fixture
+{
+protected:
+    // The most requests in flight at once. The submitter waits for the
+    // oldest one before reusing it
+    static constexpr std::size_t kMaxInFlight = 1024;
+
+    // Requests are submitted in batches of this many by submit_bulk
+    static constexpr std::size_t kBatchSize = 32;
+
+    // The depth of each fork/join tree, which has 2^kTreeDepth - 1 nodes
+    static constexpr std::size_t kTreeDepth = 8;
+
+protected:
+    virtual void SetUp(benchmark::State& state)
+    {
+        // Calibrate the work loop before any worker starts
+        application::tsc::ticks_per_ns();
+
+        m_pExecutor = std::make_shared<Executor>(static_cast<std::size_t>(state.range(0)));
+        m_Requests = std::vector<RequestTask>(kMaxInFlight);
+        m_Contention.start(state);
+    }
+
+    virtual void TearDown(benchmark::State& state)
+    {
+        m_pExecutor.reset();
+        m_Contention.report(state);
+    }
+
+    //--------------------------------------------------------------------
+    // Submits one request per iteration, each executing for \param{work},
+    // and waits for every one to run before stopping the clock
+    //--------------------------------------------------------------------
+    void requests(benchmark::State& state, std::chrono::nanoseconds work)
+    {
+        std::size_t next = 0;
+        for (auto _ : state)
+        {
+            auto& request = m_Requests[next++ % kMaxInFlight];
+            wait_for(request);
+
+            request.reset(work);
+            m_pExecutor->submit(&request);
+        }
+
+        for (auto& request : m_Requests)
+            wait_for(request);
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    //--------------------------------------------------------------------
+    // The same, submitting kBatchSize requests per iteration in one go
+    //--------------------------------------------------------------------
+    void requests_bulk(benchmark::State& state, std::chrono::nanoseconds work)
+    {
+        std::vector<application::executor::Task*> batch(kBatchSize);
+
+        std::size_t next = 0;
+        for (auto _ : state)
+        {
+            for (auto& pTask : batch)
+            {
+                auto& request = m_Requests[next++ % kMaxInFlight];
+                wait_for(request);
+
+                request.reset(work);
+                pTask = &request;
+            }
+
+            m_pExecutor->submit_bulk(batch.begin(), batch.end());
+        }
+
+        for (auto& request : m_Requests)
+            wait_for(request);
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kBatchSize));
+    }
+
+    //--------------------------------------------------------------------
+    // Submits the root of a task tree per iteration, whose nodes each
+    // execute for \param{work}, and waits for the whole tree. Every task
+    // but the root is submitted by a worker
+    //--------------------------------------------------------------------
+    void fork_join(benchmark::State& state, std::chrono::nanoseconds work)
+    {
+        std::vector<TreeTask<Executor>> tree((std::size_t{ 1 } << kTreeDepth) - 1);
+        std::atomic<std::size_t> remaining{ 0 };
+
+        for (std::size_t i = 0; i < tree.size(); ++i)
+            tree[i].reset(m_pExecutor.get(), &tree, i, &remaining, work);
+
+        for (auto _ : state)
+        {
+            remaining.store(std::size_t{ 1 } << (kTreeDepth - 1), std::memory_order_relaxed);
+            m_pExecutor->submit(&tree.front());
+
+            while (remaining.load(std::memory_order_acquire) != 0)
+                std::this_thread::yield();
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(tree.size()));
+    }
+
+private:
+    // Yields rather than spins, so the workers get the core on small hosts
+    static void wait_for(const RequestTask& request)
+    {
+        while (!request.done())
+            std::this_thread::yield();
+    }
+
+protected:
+    ContentionReport m_Contention;
+
+    std::vector<RequestTask> m_Requests;
+    std::shared_ptr<Executor> m_pExecutor = { nullptr };
+};
+
+template<typename Executor>
+constexpr std::size_t ExecutorFixture<Executor>::kMaxInFlight;
+
+template<typename Executor>
+constexpr std::size_t ExecutorFixture<Executor>::kBatchSize;
+
+template<typename Executor>
+constexpr std::size_t ExecutorFixture<Executor>::kTreeDepth;
+
+//------------------------------------------------------------------------
+// Work-stealing executor
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(ExecutorFixture, RequestsWorkStealing, application::executor::WorkStealingExecutor)(benchmark::State& state)
+{
+    requests(state, std::chrono::nanoseconds(500));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(ExecutorFixture, RequestsBulkWorkStealing, application::executor::WorkStealingExecutor)(benchmark::State& state)
+{
+    requests_bulk(state, std::chrono::nanoseconds(500));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(ExecutorFixture, ForkJoinWorkStealing, application::executor::WorkStealingExecutor)(benchmark::State& state)
+{
+    fork_join(state, std::chrono::nanoseconds(500));
+}
+
+//------------------------------------------------------------------------
+// Shared LockFreeQueue executor
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(ExecutorFixture, RequestsLockFree, application::executor::LockFreeQueueExecutor)(benchmark::State& state)
+{
+    requests(state, std::chrono::nanoseconds(500));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(ExecutorFixture, RequestsBulkLockFree, application::executor::LockFreeQueueExecutor)(benchmark::State& state)
+{
+    requests_bulk(state, std::chrono::nanoseconds(500));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(ExecutorFixture, ForkJoinLockFree, application::executor::LockFreeQueueExecutor)(benchmark::State& state)
+{
+    fork_join(state, std::chrono::nanoseconds(500));
+}
+
+//------------------------------------------------------------------------
+// Shared LockedQueue executor
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(ExecutorFixture, RequestsLocked, application::executor::LockedQueueExecutor)(benchmark::State& state)
+{
+    requests(state, std::chrono::nanoseconds(500));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(ExecutorFixture, RequestsBulkLocked, application::executor::LockedQueueExecutor)(benchmark::State& state)
+{
+    requests_bulk(state, std::chrono::nanoseconds(500));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(ExecutorFixture, ForkJoinLocked, application::executor::LockedQueueExecutor)(benchmark::State& state)
+{
+    fork_join(state, std::chrono::nanoseconds(500));
+}
+
+BENCHMARK_REGISTER_F(ExecutorFixture, RequestsWorkStealing)->ArgName("workers")->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(ExecutorFixture, RequestsBulkWorkStealing)->ArgName("workers")->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(ExecutorFixture, ForkJoinWorkStealing)->ArgName("workers")->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(ExecutorFixture, RequestsLockFree)->ArgName("workers")->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(ExecutorFixture, RequestsBulkLockFree)->ArgName("workers")->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(ExecutorFixture, ForkJoinLockFree)->ArgName("workers")->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(ExecutorFixture, RequestsLocked)->ArgName("workers")->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(ExecutorFixture, RequestsBulkLocked)->ArgName("workers")->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(ExecutorFixture, ForkJoinLocked)->ArgName("workers")->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
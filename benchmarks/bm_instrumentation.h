@@ -0,0 +1,64 @@
+#pragma once
+
+#include "../src/utility/instrumentation.h"
+
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <cstddef>
+
+//------------------------------------------------------------------------
+// Reports the contention counters gathered over a benchmark run, when
+// the structures were built with CDS_INSTRUMENTATION. The counters are
+// already summed over the threads, so only the first thread reports
+//------------------------------------------------------------------------
+class ContentionReport
+{
+public:
+    void start(benchmark::State& state)
+    {
+        if (!state.thread_index())
+            m_Before = utility::instrumentation::snapshot();
+    }
+
+    void report(benchmark::State& state)
+    {
+        if (!utility::instrumentation::enabled() || state.thread_index())
+            return;
+
+        using utility::instrumentation::Counter;
+        auto delta = utility::instrumentation::snapshot() - m_Before;
+
+        for (std::size_t i = 0; i < utility::instrumentation::kCounterCount; ++i)
+        {
+            auto counter = static_cast<Counter>(i);
+            if (delta[counter] != 0)
+                state.counters[utility::instrumentation::counter_name(counter)] = static_cast<double>(delta[counter]);
+        }
+
+        for (std::size_t i = 0; i < utility::instrumentation::kRetryBuckets; ++i)
+        {
+            if (delta.retries[i] != 0)
+            {
+                state.counters[bucket_name(i)] = static_cast<double>(delta.retries[i]);
+            }
+        }
+    }
+
+private:
+    // Names the retry bucket by its range, e.g. retries_4-7
+    static std::string bucket_name(std::size_t bucket)
+    {
+        auto low = utility::instrumentation::bucket_floor(bucket);
+        if (bucket + 1 == utility::instrumentation::kRetryBuckets)
+            return "retries_" + std::to_string(low) + "+";
+
+        auto high = utility::instrumentation::bucket_floor(bucket + 1) - 1;
+        if (low == high)
+            return "retries_" + std::to_string(low);
+
+        return "retries_" + std::to_string(low) + "-" + std::to_string(high);
+    }
+
+    utility::instrumentation::Snapshot m_Before;
+};
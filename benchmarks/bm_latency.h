@@ -0,0 +1,193 @@
+#pragma once
+
+#include "../application/tsc.h"
+
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+//------------------------------------------------------------------------
+// A log-linear histogram in the style of HdrHistogram. Values below
+// kSubBuckets are counted exactly; above that, each power of two is
+// split into kSubBuckets / 2 equal buckets, so every value is known to
+// within about 3%. Recording is an index computation and an increment,
+// so each thread records into its own histogram and they're merged once
+// the run is over
+//------------------------------------------------------------------------
+class LatencyHistogram
+{
+public:
+    static constexpr unsigned kSubBucketBits = 6;
+    static constexpr std::uint64_t kSubBuckets = std::uint64_t{ 1 } << kSubBucketBits;
+    static constexpr std::size_t kBucketCount = kSubBuckets + (64 - kSubBucketBits) * (kSubBuckets / 2);
+
+    LatencyHistogram()
+        : m_Counts(kBucketCount, 0) {}
+
+    void record(std::uint64_t value)
+    {
+        ++m_Counts[index_of(value)];
+        ++m_Total;
+        m_Max = std::max(m_Max, value);
+    }
+
+    void merge(const LatencyHistogram& other)
+    {
+        for (std::size_t i = 0; i < kBucketCount; ++i)
+            m_Counts[i] += other.m_Counts[i];
+
+        m_Total += other.m_Total;
+        m_Max = std::max(m_Max, other.m_Max);
+    }
+
+    void clear()
+    {
+        std::fill(m_Counts.begin(), m_Counts.end(), 0);
+        m_Total = 0;
+        m_Max = 0;
+    }
+
+    std::uint64_t count() const { return m_Total; }
+    std::uint64_t max() const { return m_Max; }
+
+    //--------------------------------------------------------------------
+    // Returns the highest value that's equivalent to the one at the given
+    // percentile, so the result never understates the latency
+    //--------------------------------------------------------------------
+    std::uint64_t percentile(double percent) const
+    {
+        if (m_Total == 0)
+            return 0;
+
+        auto rank = static_cast<std::uint64_t>(percent / 100.0 * static_cast<double>(m_Total) + 0.5);
+        rank = std::min(std::max<std::uint64_t>(rank, 1), m_Total);
+
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < kBucketCount; ++i)
+        {
+            seen += m_Counts[i];
+            if (seen >= rank)
+                return std::min(highest_in(i), m_Max);
+        }
+
+        return m_Max;
+    }
+
+private:
+    static unsigned log2(std::uint64_t value)
+    {
+#if defined(__GNUC__)
+        return 63 - static_cast<unsigned>(__builtin_clzll(value));
+#else
+        unsigned bit = 0;
+        while (value >>= 1)
+            ++bit;
+
+        return bit;
+#endif
+    }
+
+    static std::size_t index_of(std::uint64_t value)
+    {
+        if (value < kSubBuckets)
+            return static_cast<std::size_t>(value);
+
+        // Keep the top kSubBucketBits bits of the value; the shift picks
+        // the power of two, and the kept bits the bucket within it
+        auto shift = log2(value) - kSubBucketBits + 1;
+        auto sub = value >> shift;
+
+        return static_cast<std::size_t>(kSubBuckets + (shift - 1) * (kSubBuckets / 2) + (sub - kSubBuckets / 2));
+    }
+
+    static std::uint64_t highest_in(std::size_t index)
+    {
+        if (index < kSubBuckets)
+            return index;
+
+        auto shift = (index - kSubBuckets) / (kSubBuckets / 2) + 1;
+        auto sub = (index - kSubBuckets) % (kSubBuckets / 2) + kSubBuckets / 2;
+
+        return ((sub + 1) << shift) - 1;
+    }
+
+    std::vector<std::uint64_t> m_Counts;
+    std::uint64_t m_Total = 0;
+    std::uint64_t m_Max = 0;
+};
+
+//------------------------------------------------------------------------
+// The latencies recorded by one benchmark thread, in timestamp ticks:
+// how long each producing and consuming operation took, and how long
+// each consumed value spent in the structure
+//------------------------------------------------------------------------
+struct ThreadLatencies
+{
+    LatencyHistogram produce;
+    LatencyHistogram consume;
+    LatencyHistogram sojourn;
+
+    void merge(const ThreadLatencies& other)
+    {
+        produce.merge(other.produce);
+        consume.merge(other.consume);
+        sojourn.merge(other.sojourn);
+    }
+
+    void clear()
+    {
+        produce.clear();
+        consume.clear();
+        sojourn.clear();
+    }
+};
+
+//------------------------------------------------------------------------
+// Gathers every thread's latencies at the end of a run, and reports the
+// percentiles in nanoseconds. Google Benchmark sums counters over the
+// threads, so only the thread that merges last reports them
+//------------------------------------------------------------------------
+class LatencyReport
+{
+public:
+    void merge(benchmark::State& state, const ThreadLatencies& local,
+               const char* produceName, const char* consumeName)
+    {
+        std::lock_guard<std::mutex> lock{ m_Mut };
+
+        m_Total.merge(local);
+        if (++m_Merged < state.threads())
+            return;
+
+        report(state, produceName, m_Total.produce);
+        report(state, consumeName, m_Total.consume);
+        report(state, "sojourn", m_Total.sojourn);
+
+        m_Total.clear();
+        m_Merged = 0;
+    }
+
+private:
+    static void report(benchmark::State& state, const std::string& name, const LatencyHistogram& histogram)
+    {
+        static const std::pair<const char*, double> kPercentiles[] = {
+            { "_p50", 50.0 }, { "_p90", 90.0 }, { "_p99", 99.0 }, { "_p99.9", 99.9 }
+        };
+
+        auto rate = application::tsc::ticks_per_ns();
+        for (auto& percentile : kPercentiles)
+            state.counters[name + percentile.first] = static_cast<double>(histogram.percentile(percentile.second)) / rate;
+
+        state.counters[name + "_max"] = static_cast<double>(histogram.max()) / rate;
+    }
+
+    std::mutex m_Mut;
+    ThreadLatencies m_Total;
+    int m_Merged = 0;
+};
@@ -0,0 +1,175 @@
+#pragma once
+
+#include "../src/cds/queue/locked_queue.h"
+#include "../src/cds/queue/lockfree_queue.h"
+#include "../src/cds/queue/flat_combining_queue.h"
+#include "../src/cds/queue/bounded_queue.h"
+#include "../src/cds/queue/spsc_queue.h"
+#include "../src/cds/queue/faa_queue.h"
+
+#include "../application/command.h"
+#include "../benchmarks/bm_latency.h"
+#include "../benchmarks/bm_workload.h"
+#include "../benchmarks/bm_perf_counters.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+//------------------------------------------------------------------------
+// Latency benchmarks. Every operation is timed on its own, and every
+// value carries the timestamp it was enqueued at, so the suite reports
+// percentiles of the enqueue and dequeue latencies and of the sojourn
+// time: how long a value waited between the start of its enqueue and
+// the end of its dequeue
+//------------------------------------------------------------------------
+
+template<typename Queue>
+class LatencyQueueFixture : public benchmark::Fixture
+{
+protected:
+    using TimedCMD = typename Queue::value_type;
+
+    // Polymorphic queues are driven through their base class, like in
+    // QueueFixture
+    using TimedCMDQueue = typename std::conditional<
+        std::is_base_of<queue::QueueBase<TimedCMD>, Queue>::value,
+        queue::QueueBase<TimedCMD>, Queue>::type;
+
+    // Producers hold off while this many values are queued, so that the
+    // sojourn time measures the queue rather than an ever growing backlog
+    static constexpr int kMaxBacklog = 1024;
+
+protected:
+    virtual void SetUp(benchmark::State& state)
+    {
+        if (!state.thread_index())
+        {
+            m_pQueue = std::make_shared<Queue>();
+            m_Backlog = 0;
+        }
+
+        // Calibrate before any thread starts timing
+        application::tsc::ticks_per_ns();
+
+        m_Perf.start(state);
+    }
+
+    virtual void TearDown(benchmark::State& state)
+    {
+        m_Perf.report(state);
+    }
+
+    //--------------------------------------------------------------------
+    // Odd threads enqueue and even threads dequeue; a single thread does
+    // both in turn. Dequeues that find the queue empty aren't timed
+    //--------------------------------------------------------------------
+    void produce_consume(benchmark::State& state)
+    {
+        // The roles match the default profile's, so it places the threads
+        workloads::Profile profile{};
+        auto cpu = profile.cpu_for(state.thread_index(), state.threads());
+        application::topology::Pin pin{ cpu };
+        workloads::label_placement(state, profile, cpu, pin);
+
+        ThreadLatencies local{};
+        std::int64_t items = 0;
+
+        for (auto _ : state)
+        {
+            if (state.threads() == 1 || state.thread_index() % 2)
+                produce(local);
+
+            if (state.threads() == 1 || state.thread_index() % 2 == 0)
+                items += consume(local);
+        }
+
+        state.SetItemsProcessed(items);
+        m_Report.merge(state, local, "enqueue", "dequeue");
+    }
+
+private:
+    void produce(ThreadLatencies& local)
+    {
+        if (m_Backlog.load(std::memory_order_relaxed) >= kMaxBacklog)
+        {
+            std::this_thread::yield();
+            return;
+        }
+
+        auto start = application::tsc::now();
+        auto enqueued = m_pQueue->try_enqueue(TimedCMD{ start });
+        auto end = application::tsc::now();
+
+        if (enqueued)
+        {
+            local.produce.record(end - start);
+            m_Backlog.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    int consume(ThreadLatencies& local)
+    {
+        TimedCMD out{};
+
+        auto start = application::tsc::now();
+        auto dequeued = m_pQueue->dequeue(out);
+        auto end = application::tsc::now();
+
+        if (!dequeued)
+            return 0;
+
+        local.consume.record(end - start);
+        local.sojourn.record(end > out.stamp() ? end - out.stamp() : 0);
+        m_Backlog.fetch_sub(1, std::memory_order_relaxed);
+
+        return 1;
+    }
+
+protected:
+    std::atomic<int> m_Backlog = { 0 };
+    LatencyReport m_Report;
+    PerfCounters m_Perf;
+
+    std::shared_ptr<TimedCMDQueue> m_pQueue = { nullptr };
+};
+
+BENCHMARK_TEMPLATE_DEFINE_F(LatencyQueueFixture, LatencyLocked, queue::LockedQueue<application::pc::TimestampedCommand>)(benchmark::State& state)
+{
+    produce_consume(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(LatencyQueueFixture, LatencyLockFree, queue::LockFreeQueue<application::pc::TimestampedCommand>)(benchmark::State& state)
+{
+    produce_consume(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(LatencyQueueFixture, LatencyFlatCombining, queue::FlatCombiningQueue<application::pc::TimestampedCommand>)(benchmark::State& state)
+{
+    produce_consume(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(LatencyQueueFixture, LatencyFaa, queue::FaaQueue<application::pc::TimestampedCommand>)(benchmark::State& state)
+{
+    produce_consume(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(LatencyQueueFixture, LatencyBounded, queue::BoundedQueue<application::pc::TimestampedCommand>)(benchmark::State& state)
+{
+    produce_consume(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(LatencyQueueFixture, LatencySpsc, queue::SpscQueue<application::pc::TimestampedCommand>)(benchmark::State& state)
+{
+    produce_consume(state);
+}
+
+BENCHMARK_REGISTER_F(LatencyQueueFixture, LatencyLocked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(LatencyQueueFixture, LatencyLockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(LatencyQueueFixture, LatencyFlatCombining)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(LatencyQueueFixture, LatencyFaa)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(LatencyQueueFixture, LatencyBounded)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(LatencyQueueFixture, LatencySpsc)->Threads(1)->Threads(2)->UseRealTime();
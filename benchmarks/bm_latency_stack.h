@@ -0,0 +1,158 @@
+#pragma once
+
+#include "../src/cds/stack/locked_stack.h"
+#include "../src/cds/stack/lockfree_stack.h"
+#include "../src/cds/stack/flat_combining_stack.h"
+#include "../src/cds/stack/elimination_stack.h"
+
+#include "../application/command.h"
+#include "../benchmarks/bm_latency.h"
+#include "../benchmarks/bm_workload.h"
+#include "../benchmarks/bm_perf_counters.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+//------------------------------------------------------------------------
+// Latency benchmarks. Every operation is timed on its own, and every
+// value carries the timestamp it was pushed at, so the suite reports
+// percentiles of the push and pop latencies and of the sojourn time.
+// Stacks are LIFO, so under load the sojourn time's tail is made of
+// the values that were buried
+//------------------------------------------------------------------------
+
+template<typename Stack>
+class LatencyStackFixture : public benchmark::Fixture
+{
+protected:
+    using TimedCMD = typename Stack::value_type;
+
+    // Polymorphic stacks are driven through their base class, like in
+    // StackFixture
+    using TimedCMDStack = typename std::conditional<
+        std::is_base_of<stack::StackBase<TimedCMD>, Stack>::value,
+        stack::StackBase<TimedCMD>, Stack>::type;
+
+    // Producers hold off while this many values are pushed, so that the
+    // sojourn time measures the stack rather than an ever growing backlog
+    static constexpr int kMaxBacklog = 1024;
+
+protected:
+    virtual void SetUp(benchmark::State& state)
+    {
+        if (!state.thread_index())
+        {
+            m_pStack = std::make_shared<Stack>();
+            m_Backlog = 0;
+        }
+
+        // Calibrate before any thread starts timing
+        application::tsc::ticks_per_ns();
+
+        m_Perf.start(state);
+    }
+
+    virtual void TearDown(benchmark::State& state)
+    {
+        m_Perf.report(state);
+    }
+
+    //--------------------------------------------------------------------
+    // Odd threads push and even threads pop; a single thread does both
+    // in turn. Pops that find the stack empty aren't timed
+    //--------------------------------------------------------------------
+    void produce_consume(benchmark::State& state)
+    {
+        // The roles match the default profile's, so it places the threads
+        workloads::Profile profile{};
+        auto cpu = profile.cpu_for(state.thread_index(), state.threads());
+        application::topology::Pin pin{ cpu };
+        workloads::label_placement(state, profile, cpu, pin);
+
+        ThreadLatencies local{};
+        std::int64_t items = 0;
+
+        for (auto _ : state)
+        {
+            if (state.threads() == 1 || state.thread_index() % 2)
+                produce(local);
+
+            if (state.threads() == 1 || state.thread_index() % 2 == 0)
+                items += consume(local);
+        }
+
+        state.SetItemsProcessed(items);
+        m_Report.merge(state, local, "push", "pop");
+    }
+
+private:
+    void produce(ThreadLatencies& local)
+    {
+        if (m_Backlog.load(std::memory_order_relaxed) >= kMaxBacklog)
+        {
+            std::this_thread::yield();
+            return;
+        }
+
+        auto start = application::tsc::now();
+        m_pStack->push(TimedCMD{ start });
+        auto end = application::tsc::now();
+
+        local.produce.record(end - start);
+        m_Backlog.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    int consume(ThreadLatencies& local)
+    {
+        TimedCMD out{};
+
+        auto start = application::tsc::now();
+        auto popped = m_pStack->pop(out);
+        auto end = application::tsc::now();
+
+        if (!popped)
+            return 0;
+
+        local.consume.record(end - start);
+        local.sojourn.record(end > out.stamp() ? end - out.stamp() : 0);
+        m_Backlog.fetch_sub(1, std::memory_order_relaxed);
+
+        return 1;
+    }
+
+protected:
+    std::atomic<int> m_Backlog = { 0 };
+    LatencyReport m_Report;
+    PerfCounters m_Perf;
+
+    std::shared_ptr<TimedCMDStack> m_pStack = { nullptr };
+};
+
+BENCHMARK_TEMPLATE_DEFINE_F(LatencyStackFixture, LatencyLocked, stack::LockedStack<application::pc::TimestampedCommand>)(benchmark::State& state)
+{
+    produce_consume(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(LatencyStackFixture, LatencyLockFree, stack::LockFreeStack<application::pc::TimestampedCommand>)(benchmark::State& state)
+{
+    produce_consume(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(LatencyStackFixture, LatencyElimination, stack::EliminationStack<application::pc::TimestampedCommand>)(benchmark::State& state)
+{
+    produce_consume(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(LatencyStackFixture, LatencyFlatCombining, stack::FlatCombiningStack<application::pc::TimestampedCommand>)(benchmark::State& state)
+{
+    produce_consume(state);
+}
+
+BENCHMARK_REGISTER_F(LatencyStackFixture, LatencyLocked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(LatencyStackFixture, LatencyLockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(LatencyStackFixture, LatencyElimination)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(LatencyStackFixture, LatencyFlatCombining)->ThreadRange(1, 16)->UseRealTime();
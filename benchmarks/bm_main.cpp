@@ -1,5 +1,13 @@
 #include "../benchmarks/bm_producer_consumer_queue.h"
 #include "../benchmarks/bm_producer_consumer_stack.h"
+#include "../benchmarks/bm_latency_queue.h"
+#include "../benchmarks/bm_latency_stack.h"
+#include "../benchmarks/bm_work_stealing_deque.h"
+#include "../benchmarks/bm_executor.h"
+#include "../benchmarks/bm_priority_queue.h"
+#include "../benchmarks/bm_map.h"
+#include "../benchmarks/bm_ordered_map.h"
+#include "../benchmarks/bm_sharded_queue.h"
 
 #include <benchmark/benchmark.h>
 
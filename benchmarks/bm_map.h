@@ -0,0 +1,114 @@
+#pragma once
+
+#include "../src/cds/map/split_ordered_map.h"
+#include "../src/cds/map/locked_map.h"
+
+#include "../application/workload.h"
+#include "../benchmarks/bm_instrumentation.h"
+#include "../benchmarks/bm_perf_counters.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+//------------------------------------------------------------------------
+// Map benchmarks. Every thread looks up and updates random keys in one
+// shared map, as the request handlers of a session cache would. The
+// split-ordered map is measured against a std::unordered_map behind a
+// mutex, which is what such a cache usually starts out as
+//------------------------------------------------------------------------
+
+template<typename Map>
+class MapFixture : public benchmark::Fixture
+{
+protected:
+    using Key = typename Map::key_type;
+    using Value = typename Map::mapped_type;
+
+    // Keys are drawn uniformly from [0, kKeyRange), and half of them
+    // are present at the start
+    static constexpr std::uint64_t kKeyRange = 1 << 16;
+
+protected:
+    virtual void SetUp(benchmark::State& state)
+    {
+        if (!state.thread_index())
+        {
+            m_pMap = std::make_shared<Map>();
+            for (std::uint64_t key = 0; key < kKeyRange; key += 2)
+                m_pMap->insert(key, Value(key));
+        }
+
+        m_Contention.start(state);
+        m_Perf.start(state);
+    }
+
+    virtual void TearDown(benchmark::State& state)
+    {
+        m_Perf.report(state);
+        m_Contention.report(state);
+    }
+
+    //--------------------------------------------------------------------
+    // Each iteration looks up a random key, except that \param{writes}
+    // percent of them upsert or erase it instead, half and half, which
+    // keeps about half of the keys present
+    //--------------------------------------------------------------------
+    void mixed(benchmark::State& state, std::uint64_t writes)
+    {
+        application::workload::Random random{ static_cast<std::uint64_t>(state.thread_index()) + 1 };
+
+        Value out{};
+        for (auto _ : state)
+        {
+            auto draw = random.next();
+            auto key = static_cast<Key>(draw % kKeyRange);
+            auto roll = (draw >> 32) % 200;
+
+            if (roll >= 2 * writes)
+                benchmark::DoNotOptimize(m_pMap->find(key, out));
+            else if (roll % 2 == 0)
+                benchmark::DoNotOptimize(m_pMap->upsert(key, Value(draw)));
+            else
+                benchmark::DoNotOptimize(m_pMap->erase(key));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+protected:
+    ContentionReport m_Contention;
+    PerfCounters m_Perf;
+
+    std::shared_ptr<Map> m_pMap = { nullptr };
+};
+
+template<typename Map>
+constexpr std::uint64_t MapFixture<Map>::kKeyRange;
+
+BENCHMARK_TEMPLATE_DEFINE_F(MapFixture, ReadHeavySplitOrdered, map::direct::SplitOrderedMap<std::uint64_t, std::uint64_t>)(benchmark::State& state)
+{
+    mixed(state, 5);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(MapFixture, ReadHeavyLocked, map::direct::LockedMap<std::uint64_t, std::uint64_t>)(benchmark::State& state)
+{
+    mixed(state, 5);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(MapFixture, ReadOnlySplitOrdered, map::direct::SplitOrderedMap<std::uint64_t, std::uint64_t>)(benchmark::State& state)
+{
+    mixed(state, 0);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(MapFixture, ReadOnlyLocked, map::direct::LockedMap<std::uint64_t, std::uint64_t>)(benchmark::State& state)
+{
+    mixed(state, 0);
+}
+
+BENCHMARK_REGISTER_F(MapFixture, ReadHeavySplitOrdered)->DenseThreadRange(1, 10)->UseRealTime();
+BENCHMARK_REGISTER_F(MapFixture, ReadHeavyLocked)->DenseThreadRange(1, 10)->UseRealTime();
+BENCHMARK_REGISTER_F(MapFixture, ReadOnlySplitOrdered)->DenseThreadRange(1, 10)->UseRealTime();
+BENCHMARK_REGISTER_F(MapFixture, ReadOnlyLocked)->DenseThreadRange(1, 10)->UseRealTime();
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "../src/cds/map/skiplist_map.h"
+
+#include "../application/workload.h"
+#include "../benchmarks/bm_instrumentation.h"
+#include "../benchmarks/bm_perf_counters.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+
+//------------------------------------------------------------------------
+// Ordered map benchmarks. Every thread looks up, updates, and scans short
+// ranges of random keys in one shared map, as the matching threads of an
+// order book keyed by price and time would. The argument is the number of
+// keys, from one that fits in the L1 cache to one that spills out of the
+// last level cache, since a skiplist traversal is a chain of dependent
+// loads, and where those loads are served from decides its cost
+//------------------------------------------------------------------------
+
+template<typename Map>
+class OrderedMapFixture : public benchmark::Fixture
+{
+protected:
+    using Key = typename Map::key_type;
+    using Value = typename Map::mapped_type;
+
+    // The number of entries each scan visits
+    static constexpr std::size_t kScanLength = 16;
+
+protected:
+    //--------------------------------------------------------------------
+    // Keys are drawn uniformly from [0, range(0)), and half of them are
+    // present at the start
+    //--------------------------------------------------------------------
+    virtual void SetUp(benchmark::State& state)
+    {
+        if (!state.thread_index())
+        {
+            m_KeyRange = static_cast<std::uint64_t>(state.range(0));
+            m_pMap = std::make_shared<Map>();
+            for (std::uint64_t key = 0; key < m_KeyRange; key += 2)
+                m_pMap->insert(key, Value(key));
+        }
+
+        m_Contention.start(state);
+        m_Perf.start(state);
+    }
+
+    virtual void TearDown(benchmark::State& state)
+    {
+        m_Perf.report(state);
+        m_Contention.report(state);
+    }
+
+    //--------------------------------------------------------------------
+    // Each iteration looks up a random key, except that \param{writes}
+    // percent of them upsert or erase it instead, half and half, and
+    // \param{scans} percent read the kScanLength entries from it on
+    //--------------------------------------------------------------------
+    void mixed(benchmark::State& state, std::uint64_t writes, std::uint64_t scans)
+    {
+        application::workload::Random random{ static_cast<std::uint64_t>(state.thread_index()) + 1 };
+
+        Value out{};
+        for (auto _ : state)
+        {
+            auto draw = random.next();
+            auto key = static_cast<Key>(draw % m_KeyRange);
+            auto roll = (draw >> 32) % 200;
+
+            if (roll < 2 * scans)
+            {
+                auto pIter = m_pMap->lower_bound(key);
+                for (std::size_t i = 0; i < kScanLength && pIter != m_pMap->end(); ++i, ++pIter)
+                    benchmark::DoNotOptimize(pIter->second);
+            }
+            else if (roll >= 2 * (scans + writes))
+                benchmark::DoNotOptimize(m_pMap->find(key, out));
+            else if (roll % 2 == 0)
+                benchmark::DoNotOptimize(m_pMap->upsert(key, Value(draw)));
+            else
+                benchmark::DoNotOptimize(m_pMap->erase(key));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+protected:
+    ContentionReport m_Contention;
+    PerfCounters m_Perf;
+
+    std::uint64_t m_KeyRange = 0;
+    std::shared_ptr<Map> m_pMap = { nullptr };
+};
+
+template<typename Map>
+constexpr std::size_t OrderedMapFixture<Map>::kScanLength;
+
+BENCHMARK_TEMPLATE_DEFINE_F(OrderedMapFixture, LookupHeavySkipList, map::direct::SkipListMap<std::uint64_t, std::uint64_t>)(benchmark::State& state)
+{
+    mixed(state, 5, 5);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(OrderedMapFixture, ScanHeavySkipList, map::direct::SkipListMap<std::uint64_t, std::uint64_t>)(benchmark::State& state)
+{
+    mixed(state, 10, 40);
+}
+
+BENCHMARK_REGISTER_F(OrderedMapFixture, LookupHeavySkipList)->ArgName("keys")->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 18)->Arg(1 << 20)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_REGISTER_F(OrderedMapFixture, ScanHeavySkipList)->ArgName("keys")->Arg(1 << 10)->Arg(1 << 14)->Arg(1 << 18)->Arg(1 << 20)->ThreadRange(1, 8)->UseRealTime();
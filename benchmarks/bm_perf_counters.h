@@ -0,0 +1,241 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <cstddef>
+
+//------------------------------------------------------------------------
+// CDS_PERF_COUNTERS turns on the hardware performance counters of the
+// benchmark fixtures. They're read through perf_event_open, so they're
+// only available on Linux; elsewhere, or when the option is off,
+// PerfCounters does nothing
+//------------------------------------------------------------------------
+#ifndef CDS_PERF_COUNTERS
+#define CDS_PERF_COUNTERS 0
+#endif
+
+#if CDS_PERF_COUNTERS && defined(__linux__)
+#define CDS_PERF_COUNTERS_ACTIVE 1
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <cpuid.h>
+#endif
+
+#include <cerrno>
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#else
+#define CDS_PERF_COUNTERS_ACTIVE 0
+#endif
+
+#if CDS_PERF_COUNTERS_ACTIVE
+
+//------------------------------------------------------------------------
+// Counts hardware and scheduler events on each benchmark thread, and
+// reports them per iteration:
+//
+//   cycles        - Core cycles
+//   instructions  - Instructions retired
+//   llc_misses    - Last level cache misses
+//   hitm          - Loads served by another core's modified line, i.e.
+//                   cache-line transfers between cores. There's no
+//                   generic event for these, so it's a raw event; see
+//                   hitm_config()
+//   ctx_switches  - Context switches
+//
+// Each thread opens its own counters in start() and reads them in
+// report(). Every thread sets the same user counters, which Google
+// Benchmark sums over the threads and divides by the total iterations.
+// Events the kernel or processor doesn't support are left out
+//------------------------------------------------------------------------
+class PerfCounters
+{
+public:
+    static constexpr bool enabled() { return true; }
+
+    void start(benchmark::State&)
+    {
+        auto& counters = local();
+        for (std::size_t i = 0; i < kEventCount; ++i)
+            counters.fds[i] = open(events()[i]);
+
+        for (auto fd : counters.fds)
+        {
+            if (fd >= 0)
+            {
+                ::ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+                ::ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+    }
+
+    void report(benchmark::State& state)
+    {
+        auto& counters = local();
+        for (std::size_t i = 0; i < kEventCount; ++i)
+        {
+            auto fd = counters.fds[i];
+            if (fd < 0)
+                continue;
+
+            ::ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+
+            double value = 0;
+            if (read(fd, value))
+                state.counters[events()[i].name] = benchmark::Counter(value, benchmark::Counter::kAvgIterations);
+
+            ::close(fd);
+            counters.fds[i] = -1;
+        }
+    }
+
+private:
+    struct Event
+    {
+        const char* name;
+        std::uint32_t type;
+        std::uint64_t config;
+        bool userOnly;
+    };
+
+    static constexpr std::size_t kEventCount = 5;
+
+    // Raw config that marks an event unsupported on this processor
+    static constexpr std::uint64_t kUnsupported = ~std::uint64_t{ 0 };
+
+    // Hardware events only count user mode, so that they describe the
+    // structure's code rather than the kernel's; context switches happen
+    // in the kernel, so they can't
+    static const Event* events()
+    {
+        static const Event kEvents[kEventCount] = {
+            { "cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES, true },
+            { "instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS, true },
+            { "llc_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, true },
+            { "hitm", PERF_TYPE_RAW, 0, true },
+            { "ctx_switches", PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES, false },
+        };
+
+        return kEvents;
+    }
+
+    struct ThreadCounters
+    {
+        ThreadCounters()
+        {
+            for (auto& fd : fds)
+                fd = -1;
+        }
+
+        int fds[kEventCount];
+    };
+
+    static ThreadCounters& local()
+    {
+        static thread_local ThreadCounters counters;
+        return counters;
+    }
+
+    //--------------------------------------------------------------------
+    // The raw config for HITM loads. The CDS_PERF_HITM environment
+    // variable overrides it, e.g. CDS_PERF_HITM=0x20d2 on pre-Skylake
+    // Intel parts. Otherwise it's MEM_LOAD_L3_HIT_RETIRED.XSNP_HITM
+    // (event 0xd2, umask 0x04) on Intel, and unsupported elsewhere
+    //--------------------------------------------------------------------
+    static std::uint64_t hitm_config()
+    {
+        static const std::uint64_t config = []() -> std::uint64_t
+        {
+            if (auto pOverride = std::getenv("CDS_PERF_HITM"))
+                return static_cast<std::uint64_t>(std::strtoull(pOverride, nullptr, 0));
+
+#if defined(__x86_64__) || defined(__i386__)
+            unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+            if (__get_cpuid(0, &eax, &ebx, &ecx, &edx) && ebx == 0x756e6547 && edx == 0x49656e69 && ecx == 0x6c65746e)
+                return std::uint64_t{ 0x04d2 };
+#endif
+
+            return kUnsupported;
+        }();
+
+        return config;
+    }
+
+    //--------------------------------------------------------------------
+    // Opens a disabled counter for \param{event} on the calling thread
+    //
+    // \return      - The counter's descriptor, or -1 if it's unsupported
+    //--------------------------------------------------------------------
+    static int open(const Event& event)
+    {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+
+        attr.size = sizeof(attr);
+        attr.type = event.type;
+        attr.config = event.type == PERF_TYPE_RAW ? hitm_config() : event.config;
+        attr.disabled = 1;
+        attr.exclude_kernel = event.userOnly;
+        attr.exclude_hv = event.userOnly;
+        attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        if (attr.config == kUnsupported)
+            return -1;
+
+        auto fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+        if (fd < 0)
+            warn(event, errno);
+
+        return fd;
+    }
+
+    //--------------------------------------------------------------------
+    // Reads a counter, scaled up for the time it was multiplexed out
+    //--------------------------------------------------------------------
+    static bool read(int fd, double& value)
+    {
+        std::uint64_t values[3] = {};
+        if (::read(fd, values, sizeof(values)) != static_cast<ssize_t>(sizeof(values)) || values[2] == 0)
+            return false;
+
+        value = static_cast<double>(values[0]);
+        if (values[2] < values[1])
+            value *= static_cast<double>(values[1]) / static_cast<double>(values[2]);
+
+        return true;
+    }
+
+    // Says once per event why it's missing from the results
+    static void warn(const Event& event, int error)
+    {
+        static std::atomic<unsigned> warned{ 0 };
+
+        auto bit = 1u << (&event - events());
+        if (warned.fetch_or(bit) & bit)
+            return;
+
+        std::fprintf(stderr, "perf counters: can't count %s (%s)%s\n", event.name, std::strerror(error),
+            error == EACCES || error == EPERM ? ", check /proc/sys/kernel/perf_event_paranoid" : "");
+    }
+};
+
+#else
+
+class PerfCounters
+{
+public:
+    static constexpr bool enabled() { return false; }
+
+    void start(benchmark::State&) {}
+    void report(benchmark::State&) {}
+};
+
+#endif
@@ -0,0 +1,174 @@
+#pragma once
+
+#include "../src/cds/priority_queue/multi_queue.h"
+
+#include "../application/tsc.h"
+#include "../application/workload.h"
+#include "../benchmarks/bm_instrumentation.h"
+#include "../benchmarks/bm_perf_counters.h"
+#include "../benchmarks/bm_rank_error.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+//------------------------------------------------------------------------
+// Priority queue benchmarks. Every thread pushes a random deadline and
+// pops the earliest one it can get, as the workers of a deadline
+// scheduler would, with the queue kept at a steady size. The argument is
+// the MultiQueue's relaxation factor, which trades ordering for
+// contention, so the runs report both sides of that trade: throughput,
+// and the rank error of the values the pops returned
+//------------------------------------------------------------------------
+
+template<typename Queue>
+class PriorityQueueFixture : public benchmark::Fixture
+{
+protected:
+    using Key = typename Queue::value_type;
+
+    // The queue holds about this many values throughout a run
+    static constexpr std::size_t kPrefill = 1 << 14;
+
+    // Deadlines are drawn uniformly from [0, kKeyRange)
+    static constexpr std::uint64_t kKeyRange = 1 << 16;
+
+    // Values pushed per push_bulk by the batched benchmarks
+    static constexpr std::size_t kBatchSize = 16;
+
+protected:
+    virtual void SetUp(benchmark::State& state)
+    {
+        if (!state.thread_index())
+        {
+            m_pQueue = std::make_shared<Queue>(static_cast<std::size_t>(state.range(0)),
+                                               static_cast<std::size_t>(state.threads()));
+
+            // The prefill is replayed as if pushed before the run
+            m_Prefill.clear();
+            application::workload::Random random{ 0 };
+            for (std::size_t i = 0; i < kPrefill; ++i)
+            {
+                auto key = random.next() % kKeyRange;
+                m_pQueue->push(key);
+                m_Prefill.push_back(RankEvent{ 0, key, false });
+            }
+        }
+
+        m_Contention.start(state);
+        m_Perf.start(state);
+    }
+
+    virtual void TearDown(benchmark::State& state)
+    {
+        m_Perf.report(state);
+        m_Contention.report(state);
+    }
+
+    //--------------------------------------------------------------------
+    // Each iteration pushes one deadline and pops one
+    //--------------------------------------------------------------------
+    void throughput(benchmark::State& state)
+    {
+        application::workload::Random random{ static_cast<std::uint64_t>(state.thread_index()) + 1 };
+
+        Key out{};
+        for (auto _ : state)
+        {
+            m_pQueue->push(random.next() % kKeyRange);
+            benchmark::DoNotOptimize(m_pQueue->try_pop(out));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    //--------------------------------------------------------------------
+    // Each iteration pushes kBatchSize deadlines with one push_bulk, and
+    // pops as many
+    //--------------------------------------------------------------------
+    void throughput_bulk(benchmark::State& state)
+    {
+        application::workload::Random random{ static_cast<std::uint64_t>(state.thread_index()) + 1 };
+        std::vector<Key> batch(kBatchSize);
+
+        Key out{};
+        for (auto _ : state)
+        {
+            for (auto& key : batch)
+                key = random.next() % kKeyRange;
+
+            m_pQueue->push_bulk(batch.begin(), batch.end());
+            for (std::size_t i = 0; i < kBatchSize; ++i)
+                benchmark::DoNotOptimize(m_pQueue->try_pop(out));
+        }
+
+        state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(kBatchSize));
+    }
+
+    //--------------------------------------------------------------------
+    // The same as throughput, stamping every push and pop so the rank
+    // error can be measured once the run is over. Stamping costs a few
+    // nanoseconds an operation, so this throughput is a little lower
+    //--------------------------------------------------------------------
+    void rank_error(benchmark::State& state)
+    {
+        application::workload::Random random{ static_cast<std::uint64_t>(state.thread_index()) + 1 };
+
+        std::vector<RankEvent> local;
+        if (!state.thread_index())
+            local = m_Prefill;
+
+        Key out{};
+        for (auto _ : state)
+        {
+            auto key = random.next() % kKeyRange;
+            local.push_back(RankEvent{ application::tsc::now(), key, false });
+            m_pQueue->push(key);
+
+            if (m_pQueue->try_pop(out))
+                local.push_back(RankEvent{ application::tsc::now(), out, true });
+        }
+
+        state.SetItemsProcessed(state.iterations());
+        m_Report.merge(state, local);
+    }
+
+protected:
+    ContentionReport m_Contention;
+    PerfCounters m_Perf;
+    RankErrorReport m_Report{ "rank_error" };
+
+    std::vector<RankEvent> m_Prefill;
+    std::shared_ptr<Queue> m_pQueue = { nullptr };
+};
+
+template<typename Queue>
+constexpr std::size_t PriorityQueueFixture<Queue>::kPrefill;
+
+template<typename Queue>
+constexpr std::uint64_t PriorityQueueFixture<Queue>::kKeyRange;
+
+template<typename Queue>
+constexpr std::size_t PriorityQueueFixture<Queue>::kBatchSize;
+
+BENCHMARK_TEMPLATE_DEFINE_F(PriorityQueueFixture, ThroughputMultiQueue, priority_queue::direct::MultiQueue<std::uint64_t>)(benchmark::State& state)
+{
+    throughput(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(PriorityQueueFixture, ThroughputBulkMultiQueue, priority_queue::direct::MultiQueue<std::uint64_t>)(benchmark::State& state)
+{
+    throughput_bulk(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(PriorityQueueFixture, RankErrorMultiQueue, priority_queue::direct::MultiQueue<std::uint64_t>)(benchmark::State& state)
+{
+    rank_error(state);
+}
+
+BENCHMARK_REGISTER_F(PriorityQueueFixture, ThroughputMultiQueue)->ArgName("factor")->Arg(1)->Arg(2)->Arg(4)->DenseThreadRange(1, 10)->UseRealTime();
+BENCHMARK_REGISTER_F(PriorityQueueFixture, ThroughputBulkMultiQueue)->ArgName("factor")->Arg(1)->Arg(2)->Arg(4)->DenseThreadRange(1, 10)->UseRealTime();
+BENCHMARK_REGISTER_F(PriorityQueueFixture, RankErrorMultiQueue)->ArgName("factor")->Arg(1)->Arg(2)->Arg(4)->DenseThreadRange(1, 10)->Iterations(1 << 16)->UseRealTime();
@@ -2,14 +2,29 @@
 
 #include "../src/cds/queue/locked_queue.h"
 #include "../src/cds/queue/lockfree_queue.h"
+#include "../src/cds/queue/flat_combining_queue.h"
+#include "../src/cds/queue/bounded_queue.h"
+#include "../src/cds/queue/spsc_queue.h"
+#include "../src/cds/queue/faa_queue.h"
+#include "../src/cds/queue/blocking_queue.h"
 
 #include "../application/command.h"
+#include "../application/workload.h"
+#include "../benchmarks/bm_latency.h"
+#include "../benchmarks/bm_workload.h"
+#include "../benchmarks/bm_reclamation.h"
+#include "../benchmarks/bm_instrumentation.h"
+#include "../benchmarks/bm_perf_counters.h"
 
 #include <benchmark/benchmark.h>
 
 #include <random>
 #include <memory>
+#include <chrono>
+#include <vector>
+#include <iterator>
 #include <iostream>
+#include <type_traits>
 
 //------------------------------------------------------------------------
 // Lock-based benchmarks
@@ -19,116 +34,632 @@ template<typename Queue>
 class QueueFixture : public benchmark::Fixture
 {
 protected:
-    using RandomCMD = application::pc::RandomComputationCommand;
-    using RandomCMDQueue = queue::QueueBase<RandomCMD>;
+    using RandomCMD = typename Queue::value_type;
+
+    // Polymorphic queues are driven through their base class, so that
+    // every operation pays for the virtual call. The direct queues are
+    // driven as themselves
+    using RandomCMDQueue = typename std::conditional<
+        std::is_base_of<queue::QueueBase<RandomCMD>, Queue>::value,
+        queue::QueueBase<RandomCMD>, Queue>::type;
 
 protected:
     virtual void SetUp(benchmark::State& state)
     {
-        if (!state.thread_index)
+        if (!state.thread_index())
         {
             m_pQueue = std::make_shared<Queue>();
         }
+
+        // Calibrate the work loop before any thread starts timing
+        application::tsc::ticks_per_ns();
+
+        m_Contention.start(state);
+        m_Perf.start(state);
     }
 
     virtual void TearDown(benchmark::State& state)
     {
-        if (!state.thread_index)
+        m_Perf.report(state);
+        m_Contention.report(state);
+
+        if (!state.thread_index())
         {
             produced = 0;
             consumed = 0;
         }
     }
 
-protected:
-    std::atomic<int> count = { 0 };
-    std::atomic<int> produced = { 0 };
-    std::atomic<int> consumed = { 0 };
-
-    std::shared_ptr<RandomCMDQueue> m_pQueue = { nullptr };
-};
+    //--------------------------------------------------------------------
+    // Runs the producer/consumer workload described by the profile: its
+    // producers enqueue at the pace it sets, and its consumers dequeue and
+    // execute the work it samples for each value. A single thread fills
+    // the queue, then drains it. Producers only count values that a
+    // bounded queue had room for. Threads run where the profile places
+    // them. The sampler is given every iteration
+    //--------------------------------------------------------------------
+    template<typename Sampler>
+    void produce_consume(benchmark::State& state, const application::workload::Profile& profile, Sampler& sampler)
+    {
+        application::workload::Random random{ static_cast<std::uint64_t>(state.thread_index()) + 1 };
+        application::workload::Pacer pacer{ profile, random };
+        auto produces = profile.produces(state.thread_index(), state.threads());
 
-//------------------------------------------------------------------------
-// Lock-based benchmarks
-//------------------------------------------------------------------------
+        auto cpu = profile.cpu_for(state.thread_index(), state.threads());
+        application::topology::Pin pin{ cpu };
+        workloads::label_placement(state, profile, cpu, pin);
 
-BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeLocked, queue::LockedQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
-{
-    RandomCMD out{};
-    for (auto _ : state)
-    {
-        // sequential environment
-        if (!state.thread_index && state.threads == 1)
+        RandomCMD out{};
+        for (auto _ : state)
         {
-            for (auto i = 0; i < state.max_iterations; ++i)
-            { 
-                m_pQueue->enqueue({});
-                ++produced;
-            }
+            // sequential environment
+            if (!state.thread_index() && state.threads() == 1)
+            {
+                for (auto i = 0; i < state.max_iterations; ++i)
+                {
+                    pacer.wait();
+                    if (!m_pQueue->try_enqueue({}))
+                        break;
+
+                    ++produced;
+                }
 
-            for (auto i = 0; i < state.max_iterations; ++i)
+                while (m_pQueue->dequeue(out))
+                {
+                    out.execute(profile.work.sample(random));
+                    ++consumed;
+                }
+            }
+            else if (produces)
             {
-                m_pQueue->dequeue(out);
-                out.execute(std::chrono::nanoseconds(10));
-                ++consumed;
+                pacer.wait();
+                if (m_pQueue->try_enqueue({}))
+                    ++produced;
             }
-        }
-        else if (state.thread_index % 2)
-        {
-            m_pQueue->enqueue({});
-            ++produced;
-        }
-        else
-        {         
-            if (m_pQueue->dequeue(out));
+            else
             {
-                out.execute(std::chrono::nanoseconds(10));
-                ++consumed;
+                if (m_pQueue->dequeue(out))
+                {
+                    out.execute(profile.work.sample(random));
+                    ++consumed;
+                }
             }
+
+            sampler.sample(state);
         }
+
+        sampler.report(state);
+        state.SetItemsProcessed(consumed.load());
     }
-    
-    state.SetItemsProcessed(consumed.load());
-}
 
-BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeLockFree, queue::LockFreeQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
-{
-    RandomCMD out{};
-    for (auto _ : state)
+    void produce_consume(benchmark::State& state, const application::workload::Profile& profile)
+    {
+        NoSampler sampler{};
+        produce_consume(state, profile, sampler);
+    }
+
+    //--------------------------------------------------------------------
+    // Runs the workload with a constant amount of work per value, split
+    // evenly between producers and consumers: odd threads produce, and
+    // even threads consume
+    //--------------------------------------------------------------------
+    void produce_consume(benchmark::State& state, std::chrono::nanoseconds work)
+    {
+        produce_consume(state, workloads::constant_work(work));
+    }
+
+    //--------------------------------------------------------------------
+    // Runs the workload, reporting the peak memory held by the queue's
+    // reclamation policy
+    //--------------------------------------------------------------------
+    void produce_consume_reclaimed(benchmark::State& state, std::chrono::nanoseconds work)
     {
-        // sequential environment
-        if (!state.thread_index && state.threads == 1)
+        RetiredSampler<typename Queue::reclaimer_type, queue::lf::Node<RandomCMD>> sampler{};
+        produce_consume(state, workloads::constant_work(work), sampler);
+    }
+
+    //--------------------------------------------------------------------
+    // Runs the workload in batches of state.range(0) commands: odd threads
+    // enqueue a batch, and even threads dequeue up to a batch and execute
+    // it. A single thread enqueues a batch, then drains it
+    //--------------------------------------------------------------------
+    void produce_consume_bulk(benchmark::State& state, std::chrono::nanoseconds work)
+    {
+        auto batch = static_cast<std::size_t>(state.range(0));
+        std::vector<RandomCMD> in(batch);
+        std::vector<RandomCMD> out;
+        out.reserve(batch);
+
+        for (auto _ : state)
         {
-            for (auto i = 0; i < state.max_iterations; ++i)
+            out.clear();
+
+            if (state.thread_index() % 2 || state.threads() == 1)
             {
-                m_pQueue->enqueue({});
-                ++produced;
+                m_pQueue->enqueue_bulk(in.begin(), in.end());
+                produced += static_cast<int>(batch);
             }
 
-            for (auto i = 0; i < state.max_iterations; ++i)
+            if (state.thread_index() % 2 == 0)
             {
-                m_pQueue->dequeue(out);
-                out.execute(std::chrono::nanoseconds(100));
-                ++consumed;
+                m_pQueue->try_dequeue_bulk(std::back_inserter(out), batch);
+                for (auto& cmd : out)
+                    cmd.execute(work);
+
+                consumed += static_cast<int>(out.size());
             }
         }
-        else if (state.thread_index % 2)
-        {
-            m_pQueue->enqueue({});
-            ++produced;
-        }
-        else
+
+        state.SetItemsProcessed(consumed.load());
+    }
+
+    //--------------------------------------------------------------------
+    // Measures how long a blocking queue takes to wake a waiting consumer.
+    // Odd threads enqueue a stamped value and then hold off for a while,
+    // so the consumers run dry and wait; even threads wait for a value
+    // under the queue's wait strategy. The sojourn is the wake latency,
+    // from the stamp to the return of the wait. A single thread enqueues,
+    // then waits
+    //--------------------------------------------------------------------
+    void wake_latency(benchmark::State& state)
+    {
+        const auto gap = std::chrono::microseconds(20);
+        const auto timeout = std::chrono::milliseconds(1);
+
+        ThreadLatencies local{};
+        std::int64_t items = 0;
+
+        RandomCMD out{};
+        for (auto _ : state)
         {
-            if (m_pQueue->dequeue(out));
+            if (state.threads() == 1 || state.thread_index() % 2)
+            {
+                auto start = application::tsc::now();
+                m_pQueue->enqueue(RandomCMD{ start });
+                local.produce.record(application::tsc::now() - start);
+
+                if (state.threads() > 1)
+                    application::tsc::spin_for(gap);
+            }
+
+            if (state.threads() == 1 || state.thread_index() % 2 == 0)
             {
-                out.execute(std::chrono::nanoseconds(100));
-                ++consumed;
+                auto start = application::tsc::now();
+                if (m_pQueue->wait_dequeue_for(out, timeout))
+                {
+                    auto end = application::tsc::now();
+                    local.consume.record(end - start);
+                    local.sojourn.record(end > out.stamp() ? end - out.stamp() : 0);
+                    ++items;
+                }
             }
         }
+
+        state.SetItemsProcessed(items);
+        m_Latency.merge(state, local, "enqueue", "wait");
     }
 
-    state.SetItemsProcessed(consumed.load());
+protected:
+    std::atomic<int> count = { 0 };
+    std::atomic<int> produced = { 0 };
+    std::atomic<int> consumed = { 0 };
+
+    ContentionReport m_Contention;
+    PerfCounters m_Perf;
+    LatencyReport m_Latency;
+
+    std::shared_ptr<RandomCMDQueue> m_pQueue = { nullptr };
+};
+
+//------------------------------------------------------------------------
+// Lock-based benchmarks
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeLocked, queue::LockedQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(10));
+}
+
+//------------------------------------------------------------------------
+// Lock-free benchmarks, one per reclamation policy
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeLockFree, queue::LockFreeQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume_reclaimed(state, std::chrono::nanoseconds(100));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeLockFreeLeak, queue::LockFreeQueue<application::pc::RandomComputationCommand, utility::reclaim::Leak>)(benchmark::State& state)
+{
+    produce_consume_reclaimed(state, std::chrono::nanoseconds(100));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeLockFreeEpoch, queue::LockFreeQueue<application::pc::RandomComputationCommand, utility::reclaim::Epoch>)(benchmark::State& state)
+{
+    produce_consume_reclaimed(state, std::chrono::nanoseconds(100));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeLockFreeQSBR, queue::LockFreeQueue<application::pc::RandomComputationCommand, utility::reclaim::QSBR>)(benchmark::State& state)
+{
+    produce_consume_reclaimed(state, std::chrono::nanoseconds(100));
+}
+
+//------------------------------------------------------------------------
+// Fetch-and-add segment queue benchmarks
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeFaa, queue::FaaQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(100));
+}
+
+//------------------------------------------------------------------------
+// Bounded benchmarks
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeBounded, queue::BoundedQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(100));
+}
+
+//------------------------------------------------------------------------
+// Single producer/single consumer benchmarks. Thread 1 produces and
+// thread 0 consumes, so these only run with one or two threads
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeSpsc, queue::SpscQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(100));
+}
+
+//------------------------------------------------------------------------
+// Flat combining benchmarks
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeFlatCombining, queue::FlatCombiningQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(100));
+}
+
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeLockFreeLeak)->DenseThreadRange(1, 10)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeLockFreeEpoch)->DenseThreadRange(1, 10)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeLockFreeQSBR)->DenseThreadRange(1, 10)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeBounded)->DenseThreadRange(1, 10)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeSpsc)->Threads(1)->Threads(2)->UseRealTime();
+
+//------------------------------------------------------------------------
+// Contention sweep: flat combining and fetch-and-add against the locked
+// and lock-free queues
+//------------------------------------------------------------------------
+
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeLocked)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeLockFree)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeFlatCombining)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeFaa)->ThreadRange(1, 64)->UseRealTime();
+
+//------------------------------------------------------------------------
+// Bulk benchmarks, in batches of 64 and 512
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeBulkLocked, queue::LockedQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume_bulk(state, std::chrono::nanoseconds(100));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeBulkLockFree, queue::LockFreeQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume_bulk(state, std::chrono::nanoseconds(100));
+}
+
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeBulkLocked)->Arg(64)->Arg(512)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeBulkLockFree)->Arg(64)->Arg(512)->ThreadRange(1, 8)->UseRealTime();
+
+//------------------------------------------------------------------------
+// Blocking benchmarks. The lock-free queue behind queue::BlockingQueue,
+// under each wait strategy, measuring how quickly an enqueue wakes a
+// consumer that's waiting on an empty queue
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WakeLatencyBusySpin, queue::BlockingQueue<queue::LockFreeQueue<application::pc::TimestampedCommand>, utility::wait::BusySpin>)(benchmark::State& state)
+{
+    wake_latency(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WakeLatencySpinYield, queue::BlockingQueue<queue::LockFreeQueue<application::pc::TimestampedCommand>, utility::wait::SpinYield>)(benchmark::State& state)
+{
+    wake_latency(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WakeLatencySpinPark, queue::BlockingQueue<queue::LockFreeQueue<application::pc::TimestampedCommand>, utility::wait::SpinPark>)(benchmark::State& state)
+{
+    wake_latency(state);
+}
+
+BENCHMARK_REGISTER_F(QueueFixture, WakeLatencyBusySpin)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WakeLatencySpinYield)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WakeLatencySpinPark)->ThreadRange(1, 8)->UseRealTime();
+
+//------------------------------------------------------------------------
+// Dispatch benchmarks. The direct queues run the same workload without
+// virtual calls or the pImpl indirection, so the difference from their
+// polymorphic counterparts above is the cost of dispatch
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeLockedDirect, queue::direct::LockedQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(10));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeLockFreeDirect, queue::direct::LockFreeQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume_reclaimed(state, std::chrono::nanoseconds(100));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeFaaDirect, queue::direct::FaaQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(100));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeBoundedDirect, queue::direct::BoundedQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(100));
+}
+
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeLockedDirect)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeLockFreeDirect)->DenseThreadRange(1, 10)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeFaaDirect)->DenseThreadRange(1, 10)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeBoundedDirect)->DenseThreadRange(1, 10)->UseRealTime();
+
+//------------------------------------------------------------------------
+// Backoff benchmarks. The same lock-free queue with each backoff policy,
+// swept well past the point where immediate retries saturate the line
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeBackoffNone, queue::LockFreeQueue<application::pc::RandomComputationCommand, utility::reclaim::HazardPointers, utility::backoff::None>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(10));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeBackoffConstant, queue::LockFreeQueue<application::pc::RandomComputationCommand, utility::reclaim::HazardPointers, utility::backoff::Constant>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(10));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeBackoffExponential, queue::LockFreeQueue<application::pc::RandomComputationCommand, utility::reclaim::HazardPointers, utility::backoff::Exponential>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(10));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, ProduceConsumeBackoffAdaptive, queue::LockFreeQueue<application::pc::RandomComputationCommand, utility::reclaim::HazardPointers, utility::backoff::Adaptive>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(10));
+}
+
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeBackoffNone)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeBackoffConstant)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeBackoffExponential)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeBackoffAdaptive)->ThreadRange(1, 64)->UseRealTime();
+
+//------------------------------------------------------------------------
+// Workload benchmarks. Each structure under the profiles in
+// bm_workload.h, and then with payloads from 8 bytes to 4KB
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadSteadyLocked, queue::LockedQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadSteadyLockFree, queue::LockFreeQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadSteadyFaa, queue::FaaQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadBurstyLocked, queue::LockedQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::bursty());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadBurstyLockFree, queue::LockFreeQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::bursty());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadBurstyFaa, queue::FaaQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::bursty());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadPhasedLocked, queue::LockedQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::phased());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadPhasedLockFree, queue::LockFreeQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::phased());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadPhasedFaa, queue::FaaQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::phased());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadFanInLocked, queue::LockedQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::fan_in());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadFanInLockFree, queue::LockFreeQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::fan_in());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadFanInFaa, queue::FaaQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::fan_in());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadFanOutLocked, queue::LockedQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::fan_out());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadFanOutLockFree, queue::LockFreeQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::fan_out());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadFanOutFaa, queue::FaaQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::fan_out());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadPayload8Locked, queue::LockedQueue<application::pc::PayloadCommand<8>>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadPayload8LockFree, queue::LockFreeQueue<application::pc::PayloadCommand<8>>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadPayload64Locked, queue::LockedQueue<application::pc::PayloadCommand<64>>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadPayload64LockFree, queue::LockFreeQueue<application::pc::PayloadCommand<64>>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadPayload512Locked, queue::LockedQueue<application::pc::PayloadCommand<512>>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadPayload512LockFree, queue::LockFreeQueue<application::pc::PayloadCommand<512>>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadPayload4096Locked, queue::LockedQueue<application::pc::PayloadCommand<4096>>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, WorkloadPayload4096LockFree, queue::LockFreeQueue<application::pc::PayloadCommand<4096>>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadSteadyLocked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadSteadyLockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadSteadyFaa)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadBurstyLocked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadBurstyLockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadBurstyFaa)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadPhasedLocked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadPhasedLockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadPhasedFaa)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadFanInLocked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadFanInLockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadFanInFaa)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadFanOutLocked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadFanOutLockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadFanOutFaa)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadPayload8Locked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadPayload8LockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadPayload64Locked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadPayload64LockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadPayload512Locked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadPayload512LockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadPayload4096Locked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, WorkloadPayload4096LockFree)->ThreadRange(1, 16)->UseRealTime();
+
+//------------------------------------------------------------------------
+// Placement benchmarks. The ProduceConsume workload with each producer
+// and its consumer on two hyperthreads of a core, on two cores of a
+// socket, on two NUMA nodes, and on two sockets. Runs the host can't
+// place are skipped
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, PlacementSmtLocked, queue::LockedQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::SmtSiblings));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, PlacementSmtLockFree, queue::LockFreeQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::SmtSiblings));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, PlacementSmtFaa, queue::FaaQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::SmtSiblings));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, PlacementSameSocketLocked, queue::LockedQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::SameSocket));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, PlacementSameSocketLockFree, queue::LockFreeQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::SameSocket));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, PlacementSameSocketFaa, queue::FaaQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::SameSocket));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, PlacementCrossNodeLocked, queue::LockedQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::CrossNode));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, PlacementCrossNodeLockFree, queue::LockFreeQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::CrossNode));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, PlacementCrossNodeFaa, queue::FaaQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::CrossNode));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, PlacementCrossSocketLocked, queue::LockedQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::CrossSocket));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, PlacementCrossSocketLockFree, queue::LockFreeQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::CrossSocket));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(QueueFixture, PlacementCrossSocketFaa, queue::FaaQueue<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::CrossSocket));
 }
 
-//BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeLocked)->DenseThreadRange(1, 4)->UseRealTime();
-BENCHMARK_REGISTER_F(QueueFixture, ProduceConsumeLockFree)->DenseThreadRange(1, 10)->UseRealTime();
\ No newline at end of file
+BENCHMARK_REGISTER_F(QueueFixture, PlacementSmtLocked)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, PlacementSmtLockFree)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, PlacementSmtFaa)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, PlacementSameSocketLocked)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, PlacementSameSocketLockFree)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, PlacementSameSocketFaa)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, PlacementCrossNodeLocked)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, PlacementCrossNodeLockFree)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, PlacementCrossNodeFaa)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, PlacementCrossSocketLocked)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, PlacementCrossSocketLockFree)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(QueueFixture, PlacementCrossSocketFaa)->DenseThreadRange(2, 16, 2)->UseRealTime();
@@ -2,14 +2,27 @@
 
 #include "../src/cds/stack/locked_stack.h"
 #include "../src/cds/stack/lockfree_stack.h"
+#include "../src/cds/stack/flat_combining_stack.h"
+#include "../src/cds/stack/elimination_stack.h"
+#include "../src/cds/stack/blocking_stack.h"
 
 #include "../application/command.h"
+#include "../application/workload.h"
+#include "../benchmarks/bm_latency.h"
+#include "../benchmarks/bm_workload.h"
+#include "../benchmarks/bm_reclamation.h"
+#include "../benchmarks/bm_instrumentation.h"
+#include "../benchmarks/bm_perf_counters.h"
 
 #include <benchmark/benchmark.h>
 
 #include <random>
 #include <memory>
+#include <chrono>
+#include <vector>
+#include <iterator>
 #include <iostream>
+#include <type_traits>
 
 //------------------------------------------------------------------------
 // Lock-based benchmarks
@@ -19,116 +32,598 @@ template<typename Stack>
 class StackFixture : public benchmark::Fixture
 {
 protected:
-    using RandomCMD = application::pc::RandomComputationCommand;
-    using RandomCMDStack = stack::StackBase<RandomCMD>;
+    using RandomCMD = typename Stack::value_type;
+
+    // Polymorphic stacks are driven through their base class, so that
+    // every operation pays for the virtual call. The direct stacks are
+    // driven as themselves
+    using RandomCMDStack = typename std::conditional<
+        std::is_base_of<stack::StackBase<RandomCMD>, Stack>::value,
+        stack::StackBase<RandomCMD>, Stack>::type;
 
 protected:
     virtual void SetUp(benchmark::State& state)
     {
-        if (!state.thread_index)
+        if (!state.thread_index())
         {
             m_pStack = std::make_shared<Stack>();
         }
+
+        // Calibrate the work loop before any thread starts timing
+        application::tsc::ticks_per_ns();
+
+        m_Contention.start(state);
+        m_Perf.start(state);
     }
 
     virtual void TearDown(benchmark::State& state)
     {
-        if (!state.thread_index)
+        m_Perf.report(state);
+        m_Contention.report(state);
+
+        if (!state.thread_index())
         {
             produced = 0;
             consumed = 0;
         }
     }
 
-protected:
-    std::atomic<int> count = { 0 };
-    std::atomic<int> produced = { 0 };
-    std::atomic<int> consumed = { 0 };
-
-    std::shared_ptr<RandomCMDStack> m_pStack = { nullptr };
-};
+    //--------------------------------------------------------------------
+    // Runs the producer/consumer workload described by the profile: its
+    // producers push at the pace it sets, and its consumers pop and
+    // execute the work it samples for each value. A single thread fills
+    // the stack, then drains it. Threads run where the profile places them.
+    // The sampler is given every iteration
+    //--------------------------------------------------------------------
+    template<typename Sampler>
+    void produce_consume(benchmark::State& state, const application::workload::Profile& profile, Sampler& sampler)
+    {
+        application::workload::Random random{ static_cast<std::uint64_t>(state.thread_index()) + 1 };
+        application::workload::Pacer pacer{ profile, random };
+        auto produces = profile.produces(state.thread_index(), state.threads());
 
-//------------------------------------------------------------------------
-// Lock-based benchmarks
-//------------------------------------------------------------------------
+        auto cpu = profile.cpu_for(state.thread_index(), state.threads());
+        application::topology::Pin pin{ cpu };
+        workloads::label_placement(state, profile, cpu, pin);
 
-BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeLocked, stack::LockedStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
-{
-    RandomCMD out{};
-    for (auto _ : state)
-    {
-        // sequential environment
-        if (!state.thread_index && state.threads == 1)
+        RandomCMD out{};
+        for (auto _ : state)
         {
-            for (auto i = 0; i < state.max_iterations; ++i)
-            { 
+            // sequential environment
+            if (!state.thread_index() && state.threads() == 1)
+            {
+                for (auto i = 0; i < state.max_iterations; ++i)
+                {
+                    pacer.wait();
+                    m_pStack->push({});
+                    ++produced;
+                }
+
+                for (auto i = 0; i < state.max_iterations; ++i)
+                {
+                    m_pStack->pop(out);
+                    out.execute(profile.work.sample(random));
+                    ++consumed;
+                }
+            }
+            else if (produces)
+            {
+                pacer.wait();
                 m_pStack->push({});
                 ++produced;
             }
-
-            for (auto i = 0; i < state.max_iterations; ++i)
+            else
             {
-                m_pStack->pop(out);
-                out.execute(std::chrono::nanoseconds(10));
-                ++consumed;
-            }
-        }
-        else if (state.thread_index % 2)
-        {
-            m_pStack->push({});
-            ++produced;
-        }
-        else
-        {         
-            if (m_pStack->pop(out));
-            {
-                out.execute(std::chrono::nanoseconds(10));
-                ++consumed;
+                if (m_pStack->pop(out))
+                {
+                    out.execute(profile.work.sample(random));
+                    ++consumed;
+                }
             }
+
+            sampler.sample(state);
         }
+
+        sampler.report(state);
+        state.SetItemsProcessed(consumed.load());
     }
-    
-    state.SetItemsProcessed(consumed.load());
-}
 
-BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeLockFree, stack::LockFreeStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
-{
-    RandomCMD out{};
-    for (auto _ : state)
+    void produce_consume(benchmark::State& state, const application::workload::Profile& profile)
+    {
+        NoSampler sampler{};
+        produce_consume(state, profile, sampler);
+    }
+
+    //--------------------------------------------------------------------
+    // Runs the workload with a constant amount of work per value, split
+    // evenly between producers and consumers: odd threads produce, and
+    // even threads consume
+    //--------------------------------------------------------------------
+    void produce_consume(benchmark::State& state, std::chrono::nanoseconds work)
+    {
+        produce_consume(state, workloads::constant_work(work));
+    }
+
+    //--------------------------------------------------------------------
+    // Runs the workload, reporting the peak memory held by the stack's
+    // reclamation policy
+    //--------------------------------------------------------------------
+    void produce_consume_reclaimed(benchmark::State& state, std::chrono::nanoseconds work)
     {
-        // sequential environment
-        if (!state.thread_index && state.threads == 1)
+        RetiredSampler<typename Stack::reclaimer_type, stack::lf::Node<RandomCMD>> sampler{};
+        produce_consume(state, workloads::constant_work(work), sampler);
+    }
+
+    //--------------------------------------------------------------------
+    // Runs the workload in batches of state.range(0) commands: odd threads
+    // push a batch, and even threads pop everything on the stack and
+    // execute it. A single thread pushes a batch, then drains it
+    //--------------------------------------------------------------------
+    void produce_consume_bulk(benchmark::State& state, std::chrono::nanoseconds work)
+    {
+        auto batch = static_cast<std::size_t>(state.range(0));
+        std::vector<RandomCMD> in(batch);
+        std::vector<RandomCMD> out;
+
+        for (auto _ : state)
         {
-            for (auto i = 0; i < state.max_iterations; ++i)
+            out.clear();
+
+            if (state.thread_index() % 2 || state.threads() == 1)
             {
-                m_pStack->push({});
-                ++produced;
+                m_pStack->push_bulk(in.begin(), in.end());
+                produced += static_cast<int>(batch);
             }
 
-            for (auto i = 0; i < state.max_iterations; ++i)
+            if (state.thread_index() % 2 == 0)
             {
-                m_pStack->pop(out);
-                out.execute(std::chrono::nanoseconds(10));
-                ++consumed;
+                m_pStack->pop_all(std::back_inserter(out));
+                for (auto& cmd : out)
+                    cmd.execute(work);
+
+                consumed += static_cast<int>(out.size());
             }
         }
-        else if (state.thread_index % 2)
-        {
-            m_pStack->push({});
-            ++produced;
-        }
-        else
+
+        state.SetItemsProcessed(consumed.load());
+    }
+
+    //--------------------------------------------------------------------
+    // Measures how long a blocking stack takes to wake a waiting consumer,
+    // like QueueFixture::wake_latency: odd threads push a stamped value
+    // and hold off, and even threads wait to pop one
+    //--------------------------------------------------------------------
+    void wake_latency(benchmark::State& state)
+    {
+        const auto gap = std::chrono::microseconds(20);
+        const auto timeout = std::chrono::milliseconds(1);
+
+        ThreadLatencies local{};
+        std::int64_t items = 0;
+
+        RandomCMD out{};
+        for (auto _ : state)
         {
-            if (m_pStack->pop(out));
+            if (state.threads() == 1 || state.thread_index() % 2)
             {
-                out.execute(std::chrono::nanoseconds(10));
-                ++consumed;
+                auto start = application::tsc::now();
+                m_pStack->push(RandomCMD{ start });
+                local.produce.record(application::tsc::now() - start);
+
+                if (state.threads() > 1)
+                    application::tsc::spin_for(gap);
+            }
+
+            if (state.threads() == 1 || state.thread_index() % 2 == 0)
+            {
+                auto start = application::tsc::now();
+                if (m_pStack->wait_pop_for(out, timeout))
+                {
+                    auto end = application::tsc::now();
+                    local.consume.record(end - start);
+                    local.sojourn.record(end > out.stamp() ? end - out.stamp() : 0);
+                    ++items;
+                }
             }
         }
+
+        state.SetItemsProcessed(items);
+        m_Latency.merge(state, local, "push", "wait");
     }
 
-    state.SetItemsProcessed(consumed.load());
+protected:
+    std::atomic<int> count = { 0 };
+    std::atomic<int> produced = { 0 };
+    std::atomic<int> consumed = { 0 };
+
+    ContentionReport m_Contention;
+    PerfCounters m_Perf;
+    LatencyReport m_Latency;
+
+    std::shared_ptr<RandomCMDStack> m_pStack = { nullptr };
+};
+
+//------------------------------------------------------------------------
+// Lock-based benchmarks
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeLocked, stack::LockedStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(10));
+}
+
+//------------------------------------------------------------------------
+// Lock-free benchmarks, one per reclamation policy
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeLockFree, stack::LockFreeStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume_reclaimed(state, std::chrono::nanoseconds(10));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeLockFreeLeak, stack::LockFreeStack<application::pc::RandomComputationCommand, utility::reclaim::Leak>)(benchmark::State& state)
+{
+    produce_consume_reclaimed(state, std::chrono::nanoseconds(10));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeLockFreeEpoch, stack::LockFreeStack<application::pc::RandomComputationCommand, utility::reclaim::Epoch>)(benchmark::State& state)
+{
+    produce_consume_reclaimed(state, std::chrono::nanoseconds(10));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeLockFreeQSBR, stack::LockFreeStack<application::pc::RandomComputationCommand, utility::reclaim::QSBR>)(benchmark::State& state)
+{
+    produce_consume_reclaimed(state, std::chrono::nanoseconds(10));
+}
+
+//------------------------------------------------------------------------
+// Elimination-backoff benchmarks
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeElimination, stack::EliminationStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume_reclaimed(state, std::chrono::nanoseconds(10));
+}
+
+//------------------------------------------------------------------------
+// Flat combining benchmarks
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeFlatCombining, stack::FlatCombiningStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(10));
+}
+
+BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeLockFreeLeak)->DenseThreadRange(1, 4)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeLockFreeEpoch)->DenseThreadRange(1, 4)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeLockFreeQSBR)->DenseThreadRange(1, 4)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeElimination)->DenseThreadRange(1, 4)->UseRealTime();
+
+//------------------------------------------------------------------------
+// Contention sweep: flat combining against the locked and lock-free stacks
+//------------------------------------------------------------------------
+
+BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeLocked)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeLockFree)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeFlatCombining)->ThreadRange(1, 64)->UseRealTime();
+
+//------------------------------------------------------------------------
+// Bulk benchmarks, in batches of 64 and 512
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeBulkLocked, stack::LockedStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume_bulk(state, std::chrono::nanoseconds(10));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeBulkLockFree, stack::LockFreeStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume_bulk(state, std::chrono::nanoseconds(10));
+}
+
+BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeBulkLocked)->Arg(64)->Arg(512)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeBulkLockFree)->Arg(64)->Arg(512)->ThreadRange(1, 8)->UseRealTime();
+
+//------------------------------------------------------------------------
+// Blocking benchmarks. The lock-free stack behind stack::BlockingStack,
+// under each wait strategy, measuring how quickly a push wakes a consumer
+// that's waiting on an empty stack
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WakeLatencyBusySpin, stack::BlockingStack<stack::LockFreeStack<application::pc::TimestampedCommand>, utility::wait::BusySpin>)(benchmark::State& state)
+{
+    wake_latency(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WakeLatencySpinYield, stack::BlockingStack<stack::LockFreeStack<application::pc::TimestampedCommand>, utility::wait::SpinYield>)(benchmark::State& state)
+{
+    wake_latency(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WakeLatencySpinPark, stack::BlockingStack<stack::LockFreeStack<application::pc::TimestampedCommand>, utility::wait::SpinPark>)(benchmark::State& state)
+{
+    wake_latency(state);
+}
+
+BENCHMARK_REGISTER_F(StackFixture, WakeLatencyBusySpin)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WakeLatencySpinYield)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WakeLatencySpinPark)->ThreadRange(1, 8)->UseRealTime();
+
+//------------------------------------------------------------------------
+// Dispatch benchmarks. The direct stacks run the same workload without
+// virtual calls or the pImpl indirection, so the difference from their
+// polymorphic counterparts above is the cost of dispatch
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeLockedDirect, stack::direct::LockedStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(10));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeLockFreeDirect, stack::direct::LockFreeStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume_reclaimed(state, std::chrono::nanoseconds(100));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeEliminationDirect, stack::direct::EliminationStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(100));
+}
+
+BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeLockedDirect)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeLockFreeDirect)->DenseThreadRange(1, 4)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeEliminationDirect)->DenseThreadRange(1, 4)->UseRealTime();
+
+//------------------------------------------------------------------------
+// Backoff benchmarks. The same lock-free stack with each backoff policy,
+// swept well past the point where immediate retries saturate the line
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeBackoffNone, stack::LockFreeStack<application::pc::RandomComputationCommand, utility::reclaim::HazardPointers, utility::backoff::None>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(10));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeBackoffConstant, stack::LockFreeStack<application::pc::RandomComputationCommand, utility::reclaim::HazardPointers, utility::backoff::Constant>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(10));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeBackoffExponential, stack::LockFreeStack<application::pc::RandomComputationCommand, utility::reclaim::HazardPointers, utility::backoff::Exponential>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(10));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, ProduceConsumeBackoffAdaptive, stack::LockFreeStack<application::pc::RandomComputationCommand, utility::reclaim::HazardPointers, utility::backoff::Adaptive>)(benchmark::State& state)
+{
+    produce_consume(state, std::chrono::nanoseconds(10));
+}
+
+BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeBackoffNone)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeBackoffConstant)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeBackoffExponential)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeBackoffAdaptive)->ThreadRange(1, 64)->UseRealTime();
+
+//------------------------------------------------------------------------
+// Workload benchmarks. Each structure under the profiles in
+// bm_workload.h, and then with payloads from 8 bytes to 4KB
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadSteadyLocked, stack::LockedStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadSteadyLockFree, stack::LockFreeStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadSteadyElimination, stack::EliminationStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadBurstyLocked, stack::LockedStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::bursty());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadBurstyLockFree, stack::LockFreeStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::bursty());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadBurstyElimination, stack::EliminationStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::bursty());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadPhasedLocked, stack::LockedStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::phased());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadPhasedLockFree, stack::LockFreeStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::phased());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadPhasedElimination, stack::EliminationStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::phased());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadFanInLocked, stack::LockedStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::fan_in());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadFanInLockFree, stack::LockFreeStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::fan_in());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadFanInElimination, stack::EliminationStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::fan_in());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadFanOutLocked, stack::LockedStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::fan_out());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadFanOutLockFree, stack::LockFreeStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::fan_out());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadFanOutElimination, stack::EliminationStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::fan_out());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadPayload8Locked, stack::LockedStack<application::pc::PayloadCommand<8>>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadPayload8LockFree, stack::LockFreeStack<application::pc::PayloadCommand<8>>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadPayload64Locked, stack::LockedStack<application::pc::PayloadCommand<64>>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadPayload64LockFree, stack::LockFreeStack<application::pc::PayloadCommand<64>>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadPayload512Locked, stack::LockedStack<application::pc::PayloadCommand<512>>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadPayload512LockFree, stack::LockFreeStack<application::pc::PayloadCommand<512>>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadPayload4096Locked, stack::LockedStack<application::pc::PayloadCommand<4096>>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, WorkloadPayload4096LockFree, stack::LockFreeStack<application::pc::PayloadCommand<4096>>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::steady());
+}
+
+BENCHMARK_REGISTER_F(StackFixture, WorkloadSteadyLocked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadSteadyLockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadSteadyElimination)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadBurstyLocked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadBurstyLockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadBurstyElimination)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadPhasedLocked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadPhasedLockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadPhasedElimination)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadFanInLocked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadFanInLockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadFanInElimination)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadFanOutLocked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadFanOutLockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadFanOutElimination)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadPayload8Locked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadPayload8LockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadPayload64Locked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadPayload64LockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadPayload512Locked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadPayload512LockFree)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadPayload4096Locked)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, WorkloadPayload4096LockFree)->ThreadRange(1, 16)->UseRealTime();
+
+//------------------------------------------------------------------------
+// Placement benchmarks. The ProduceConsume workload with each producer
+// and its consumer on two hyperthreads of a core, on two cores of a
+// socket, on two NUMA nodes, and on two sockets. Runs the host can't
+// place are skipped
+//------------------------------------------------------------------------
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, PlacementSmtLocked, stack::LockedStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::SmtSiblings));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, PlacementSmtLockFree, stack::LockFreeStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::SmtSiblings));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, PlacementSmtElimination, stack::EliminationStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::SmtSiblings));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, PlacementSameSocketLocked, stack::LockedStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::SameSocket));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, PlacementSameSocketLockFree, stack::LockFreeStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::SameSocket));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, PlacementSameSocketElimination, stack::EliminationStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::SameSocket));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, PlacementCrossNodeLocked, stack::LockedStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::CrossNode));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, PlacementCrossNodeLockFree, stack::LockFreeStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::CrossNode));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, PlacementCrossNodeElimination, stack::EliminationStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::CrossNode));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, PlacementCrossSocketLocked, stack::LockedStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::CrossSocket));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, PlacementCrossSocketLockFree, stack::LockFreeStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::CrossSocket));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(StackFixture, PlacementCrossSocketElimination, stack::EliminationStack<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    produce_consume(state, workloads::constant_work(std::chrono::nanoseconds(100)).place(workloads::Placement::CrossSocket));
 }
 
-//BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeLocked)->DenseThreadRange(1, 4)->UseRealTime();
-//BENCHMARK_REGISTER_F(StackFixture, ProduceConsumeLockFree)->DenseThreadRange(1, 4)->UseRealTime();
\ No newline at end of file
+BENCHMARK_REGISTER_F(StackFixture, PlacementSmtLocked)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, PlacementSmtLockFree)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, PlacementSmtElimination)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, PlacementSameSocketLocked)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, PlacementSameSocketLockFree)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, PlacementSameSocketElimination)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, PlacementCrossNodeLocked)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, PlacementCrossNodeLockFree)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, PlacementCrossNodeElimination)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, PlacementCrossSocketLocked)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, PlacementCrossSocketLockFree)->DenseThreadRange(2, 16, 2)->UseRealTime();
+BENCHMARK_REGISTER_F(StackFixture, PlacementCrossSocketElimination)->DenseThreadRange(2, 16, 2)->UseRealTime();
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+
+//------------------------------------------------------------------------
+// One insertion or removal on a relaxed structure, stamped with the time
+// stamp counter. Insertions are stamped before they start and removals
+// after they return, so every key is inserted before it's removed in
+// stamp order
+//------------------------------------------------------------------------
+struct RankEvent
+{
+    std::uint64_t stamp;
+    std::uint64_t key;
+    bool remove;
+
+    bool operator<(const RankEvent& other) const
+    {
+        return stamp != other.stamp ? stamp < other.stamp : !remove && other.remove;
+    }
+};
+
+//------------------------------------------------------------------------
+// Gathers every thread's events at the end of a run and replays them in
+// stamp order against an exact structure: a count of the keys present,
+// in a Fenwick tree indexed by key order. The rank error of a removal is
+// how many smaller keys were present when it returned, zero for a strict
+// priority queue, or for a strict FIFO queue keyed by enqueue order. The
+// counters are reported under the given name, and only by the thread
+// that merges last
+//------------------------------------------------------------------------
+class RankErrorReport
+{
+public:
+    explicit RankErrorReport(std::string name)
+        : m_Name(std::move(name)) {}
+
+    void merge(benchmark::State& state, const std::vector<RankEvent>& local)
+    {
+        std::lock_guard<std::mutex> lock{ m_Mut };
+
+        m_Events.insert(m_Events.end(), local.begin(), local.end());
+        if (++m_Merged < state.threads())
+            return;
+
+        report(state);
+
+        m_Events.clear();
+        m_Merged = 0;
+    }
+
+private:
+    void report(benchmark::State& state)
+    {
+        std::stable_sort(m_Events.begin(), m_Events.end());
+
+        // Keys can be sparse, so the tree is indexed by their order
+        std::vector<std::uint64_t> keys;
+        for (auto& event : m_Events)
+        {
+            if (!event.remove)
+                keys.push_back(event.key);
+        }
+
+        std::sort(keys.begin(), keys.end());
+        keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+
+        auto position = [&](std::uint64_t key) -> std::size_t
+        {
+            return static_cast<std::size_t>(std::lower_bound(keys.begin(), keys.end(), key) - keys.begin());
+        };
+
+        std::vector<std::int64_t> present(keys.size() + 1, 0);
+        auto add = [&](std::size_t index, std::int64_t delta)
+        {
+            for (auto i = index + 1; i < present.size(); i += i & (~i + 1))
+                present[i] += delta;
+        };
+
+        // Counts the keys present that are less than the one at \param{index}
+        auto less = [&](std::size_t index) -> std::int64_t
+        {
+            std::int64_t total = 0;
+            for (auto i = index; i > 0; i -= i & (~i + 1))
+                total += present[i];
+            return total;
+        };
+
+        std::vector<std::int64_t> ranks;
+        for (auto& event : m_Events)
+        {
+            auto index = position(event.key);
+            if (event.remove)
+            {
+                ranks.push_back(less(index));
+                add(index, -1);
+            }
+            else
+            {
+                add(index, 1);
+            }
+        }
+
+        if (ranks.empty())
+            return;
+
+        std::sort(ranks.begin(), ranks.end());
+
+        double total = 0;
+        for (auto rank : ranks)
+            total += static_cast<double>(rank);
+
+        state.counters[m_Name + "_mean"] = total / static_cast<double>(ranks.size());
+        state.counters[m_Name + "_p99"] = static_cast<double>(ranks[(ranks.size() - 1) * 99 / 100]);
+        state.counters[m_Name + "_max"] = static_cast<double>(ranks.back());
+    }
+
+    const std::string m_Name;
+
+    std::mutex m_Mut;
+    std::vector<RankEvent> m_Events;
+    int m_Merged = 0;
+};
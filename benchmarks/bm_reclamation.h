@@ -0,0 +1,52 @@
+#pragma once
+
+#include "../src/utility/reclamation.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <algorithm>
+
+//------------------------------------------------------------------------
+// Samples nothing. Used by the structures that free nodes eagerly
+//------------------------------------------------------------------------
+class NoSampler
+{
+public:
+    void sample(benchmark::State&) {}
+    void report(benchmark::State&) {}
+};
+
+//------------------------------------------------------------------------
+// Tracks the peak number of retired nodes that a reclamation policy
+// is holding on to during a benchmark run, and reports it in bytes.
+// Only the first thread samples, so the counter isn't summed over
+// the threads
+//------------------------------------------------------------------------
+template<typename Reclaimer, typename Node>
+class RetiredSampler
+{
+public:
+    RetiredSampler()
+        : m_Base(Reclaimer::pending()), m_Peak(m_Base) {}
+
+    void sample(benchmark::State& state)
+    {
+        if (!state.thread_index())
+            m_Peak = std::max(m_Peak, Reclaimer::pending());
+    }
+
+    void report(benchmark::State& state)
+    {
+        if (!state.thread_index())
+        {
+            state.counters["PeakRetiredBytes"] = benchmark::Counter(
+                static_cast<double>((m_Peak - m_Base) * sizeof(Node)),
+                benchmark::Counter::kDefaults, benchmark::Counter::OneK::kIs1024);
+        }
+    }
+
+private:
+    std::size_t m_Base;
+    std::size_t m_Peak;
+};
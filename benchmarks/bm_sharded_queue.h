@@ -0,0 +1,197 @@
+#pragma once
+
+#include "../src/cds/queue/lockfree_queue.h"
+#include "../src/cds/queue/sharded_queue.h"
+
+#include "../application/tsc.h"
+#include "../benchmarks/bm_instrumentation.h"
+#include "../benchmarks/bm_perf_counters.h"
+#include "../benchmarks/bm_rank_error.h"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+//------------------------------------------------------------------------
+// Sharded queue benchmarks. Many threads feed one queue, as the request
+// handlers of a logging or metrics pipeline would, and FIFO only has to
+// hold per producer. The sharded queue gives each thread its own lane,
+// and is measured against a single lock-free queue, whose one head and
+// tail every thread contends on. The argument is the sharded queue's
+// sweep: 0 starts each dequeue at the thread's own lane, 1 at a random
+// one. The runs report both throughput, and how far out of global FIFO
+// order the values came out
+//------------------------------------------------------------------------
+
+//------------------------------------------------------------------------
+// Makes the queue under test. Sharded queues get a lane per thread, and
+// the sweep named by the argument. A run's threads are the only ones
+// alive that hold lane ids, and a thread takes the lowest free id, so
+// each of them enqueues to a lane of its own
+//------------------------------------------------------------------------
+template<typename Queue>
+struct FanInQueueFactory
+{
+    static std::shared_ptr<Queue> make(benchmark::State&)
+    {
+        return std::make_shared<Queue>();
+    }
+};
+
+template<typename T, typename Lane>
+struct FanInQueueFactory<queue::direct::ShardedQueue<T, Lane>>
+{
+    static std::shared_ptr<queue::direct::ShardedQueue<T, Lane>> make(benchmark::State& state)
+    {
+        return std::make_shared<queue::direct::ShardedQueue<T, Lane>>(
+            static_cast<std::size_t>(state.threads()), static_cast<queue::Sweep>(state.range(0)));
+    }
+};
+
+template<typename Queue>
+class FanInQueueFixture : public benchmark::Fixture
+{
+protected:
+    using Value = typename Queue::value_type;
+
+    // Values moved per enqueue_bulk and try_dequeue_bulk by the batched
+    // benchmarks
+    static constexpr std::size_t kBatchSize = 64;
+
+protected:
+    virtual void SetUp(benchmark::State& state)
+    {
+        if (!state.thread_index())
+        {
+            m_pQueue = FanInQueueFactory<Queue>::make(state);
+        }
+
+        m_Contention.start(state);
+        m_Perf.start(state);
+    }
+
+    virtual void TearDown(benchmark::State& state)
+    {
+        m_Perf.report(state);
+        m_Contention.report(state);
+    }
+
+    //--------------------------------------------------------------------
+    // Each iteration enqueues one value and dequeues one
+    //--------------------------------------------------------------------
+    void throughput(benchmark::State& state)
+    {
+        Value next{};
+        Value out{};
+        for (auto _ : state)
+        {
+            m_pQueue->enqueue(next++);
+            benchmark::DoNotOptimize(m_pQueue->dequeue(out));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    //--------------------------------------------------------------------
+    // Odd threads enqueue kBatchSize values with one enqueue_bulk, and
+    // even threads drain up to as many with one try_dequeue_bulk. A
+    // single thread does both. Items are the values dequeued
+    //--------------------------------------------------------------------
+    void fan_in_bulk(benchmark::State& state)
+    {
+        std::vector<Value> in(kBatchSize);
+        std::vector<Value> out;
+        out.reserve(kBatchSize);
+
+        std::size_t consumed = 0;
+        for (auto _ : state)
+        {
+            if (state.thread_index() % 2 || state.threads() == 1)
+                m_pQueue->enqueue_bulk(in.begin(), in.end());
+
+            if (state.thread_index() % 2 == 0)
+            {
+                out.clear();
+                consumed += m_pQueue->try_dequeue_bulk(std::back_inserter(out), kBatchSize);
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<std::int64_t>(consumed));
+    }
+
+    //--------------------------------------------------------------------
+    // The same as throughput, stamping every enqueue and dequeue so the
+    // reordering can be measured once the run is over. Each value is the
+    // stamp of its enqueue, so its rank error counts the values enqueued
+    // before it that were still in the queue, zero for strict FIFO
+    //--------------------------------------------------------------------
+    void reorder(benchmark::State& state)
+    {
+        std::vector<RankEvent> local;
+
+        Value out{};
+        for (auto _ : state)
+        {
+            auto stamp = application::tsc::now();
+            local.push_back(RankEvent{ stamp, stamp, false });
+            m_pQueue->enqueue(Value(stamp));
+
+            if (m_pQueue->dequeue(out))
+                local.push_back(RankEvent{ application::tsc::now(), out, true });
+        }
+
+        state.SetItemsProcessed(state.iterations());
+        m_Report.merge(state, local);
+    }
+
+protected:
+    ContentionReport m_Contention;
+    PerfCounters m_Perf;
+    RankErrorReport m_Report{ "reorder" };
+
+    std::shared_ptr<Queue> m_pQueue = { nullptr };
+};
+
+template<typename Queue>
+constexpr std::size_t FanInQueueFixture<Queue>::kBatchSize;
+
+BENCHMARK_TEMPLATE_DEFINE_F(FanInQueueFixture, ThroughputLockFree, queue::direct::LockFreeQueue<std::uint64_t>)(benchmark::State& state)
+{
+    throughput(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(FanInQueueFixture, ThroughputSharded, queue::direct::ShardedQueue<std::uint64_t>)(benchmark::State& state)
+{
+    throughput(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(FanInQueueFixture, BulkLockFree, queue::direct::LockFreeQueue<std::uint64_t>)(benchmark::State& state)
+{
+    fan_in_bulk(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(FanInQueueFixture, BulkSharded, queue::direct::ShardedQueue<std::uint64_t>)(benchmark::State& state)
+{
+    fan_in_bulk(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(FanInQueueFixture, ReorderLockFree, queue::direct::LockFreeQueue<std::uint64_t>)(benchmark::State& state)
+{
+    reorder(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(FanInQueueFixture, ReorderSharded, queue::direct::ShardedQueue<std::uint64_t>)(benchmark::State& state)
+{
+    reorder(state);
+}
+
+BENCHMARK_REGISTER_F(FanInQueueFixture, ThroughputLockFree)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(FanInQueueFixture, ThroughputSharded)->ArgName("sweep")->Arg(0)->Arg(1)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(FanInQueueFixture, BulkLockFree)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(FanInQueueFixture, BulkSharded)->ArgName("sweep")->Arg(0)->Arg(1)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_REGISTER_F(FanInQueueFixture, ReorderLockFree)->ThreadRange(1, 64)->Iterations(1 << 14)->UseRealTime();
+BENCHMARK_REGISTER_F(FanInQueueFixture, ReorderSharded)->ArgName("sweep")->Arg(0)->Arg(1)->ThreadRange(1, 64)->Iterations(1 << 14)->UseRealTime();
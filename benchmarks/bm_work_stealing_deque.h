@@ -0,0 +1,192 @@
+#pragma once
+
+#include "../src/cds/deque/work_stealing_deque.h"
+#include "../src/cds/queue/lockfree_queue.h"
+
+#include "../application/command.h"
+#include "../application/tsc.h"
+#include "../benchmarks/bm_instrumentation.h"
+#include "../benchmarks/bm_perf_counters.h"
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <vector>
+
+//------------------------------------------------------------------------
+// Work-stealing benchmarks. Every thread owns a deque, as the workers of
+// a task runtime would, and these measure the two extremes of how they're
+// used: each owner working through its own deque, and one owner feeding
+// thieves. The shared LockFreeQueue the deques replace is run the same way
+// for comparison
+//------------------------------------------------------------------------
+
+template<typename Deque>
+class DequeFixture : public benchmark::Fixture
+{
+protected:
+    using RandomCMD = typename Deque::value_type;
+
+    // Owners keep about this many values in their deques, so that thieves
+    // rarely find them empty
+    static constexpr std::size_t kBacklog = 64;
+
+protected:
+    virtual void SetUp(benchmark::State& state)
+    {
+        if (!state.thread_index())
+        {
+            m_Deques.clear();
+            for (auto i = 0; i < state.threads(); ++i)
+                m_Deques.emplace_back(new Deque{});
+
+            m_pShared = std::make_shared<queue::direct::LockFreeQueue<RandomCMD>>();
+        }
+
+        // Calibrate the work loop before any thread starts timing
+        application::tsc::ticks_per_ns();
+
+        m_Contention.start(state);
+        m_Perf.start(state);
+    }
+
+    virtual void TearDown(benchmark::State& state)
+    {
+        m_Perf.report(state);
+        m_Contention.report(state);
+    }
+
+    //--------------------------------------------------------------------
+    // Each thread pushes onto its own deque and pops the value back off,
+    // so no operation ever meets another thread. This is the fast path a
+    // worker takes for the tasks it spawns itself. The deques are only
+    // looked up once the threads are running, since thread 0 creates them
+    //--------------------------------------------------------------------
+    void owner_only(benchmark::State& state)
+    {
+        auto index = static_cast<std::size_t>(state.thread_index());
+
+        RandomCMD out{};
+        for (auto _ : state)
+        {
+            auto& deque = *m_Deques[index];
+            deque.push(RandomCMD{});
+            benchmark::DoNotOptimize(deque.pop(out));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    //--------------------------------------------------------------------
+    // The same, with every thread enqueueing onto and dequeueing from one
+    // shared queue
+    //--------------------------------------------------------------------
+    void owner_only_shared(benchmark::State& state)
+    {
+        RandomCMD out{};
+        for (auto _ : state)
+        {
+            m_pShared->enqueue(RandomCMD{});
+            benchmark::DoNotOptimize(m_pShared->dequeue(out));
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+
+    //--------------------------------------------------------------------
+    // Thread 0 owns the only deque with work in it. It keeps kBacklog
+    // values in it and works on one value per iteration, and every other
+    // thread steals from it and works on what it steals. A lone thread
+    // just pushes and pops. Each thread counts what it took, so that
+    // counting doesn't add a shared write
+    //--------------------------------------------------------------------
+    void steal_heavy(benchmark::State& state, std::chrono::nanoseconds work)
+    {
+        std::int64_t taken = 0;
+
+        RandomCMD out{};
+        for (auto _ : state)
+        {
+            auto& victim = *m_Deques.front();
+            if (!state.thread_index())
+            {
+                while (victim.size() < kBacklog)
+                    victim.push(RandomCMD{});
+
+                if (victim.pop(out))
+                {
+                    out.execute(work);
+                    ++taken;
+                }
+            }
+            else if (victim.steal(out))
+            {
+                out.execute(work);
+                ++taken;
+            }
+        }
+
+        state.SetItemsProcessed(taken);
+    }
+
+    //--------------------------------------------------------------------
+    // The same, with thread 0 enqueueing onto the shared queue and every
+    // thread dequeueing from it
+    //--------------------------------------------------------------------
+    void steal_heavy_shared(benchmark::State& state, std::chrono::nanoseconds work)
+    {
+        std::int64_t taken = 0;
+
+        RandomCMD out{};
+        for (auto _ : state)
+        {
+            if (!state.thread_index())
+            {
+                for (auto i = 0; i < 2; ++i)
+                    m_pShared->enqueue(RandomCMD{});
+            }
+
+            if (m_pShared->dequeue(out))
+            {
+                out.execute(work);
+                ++taken;
+            }
+        }
+
+        state.SetItemsProcessed(taken);
+    }
+
+protected:
+    ContentionReport m_Contention;
+    PerfCounters m_Perf;
+
+    std::vector<std::unique_ptr<Deque>> m_Deques;
+    std::shared_ptr<queue::direct::LockFreeQueue<RandomCMD>> m_pShared = { nullptr };
+};
+
+BENCHMARK_TEMPLATE_DEFINE_F(DequeFixture, OwnerOnlyDeque, deque::direct::WorkStealingDeque<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    owner_only(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(DequeFixture, OwnerOnlySharedQueue, deque::direct::WorkStealingDeque<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    owner_only_shared(state);
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(DequeFixture, StealHeavyDeque, deque::direct::WorkStealingDeque<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    steal_heavy(state, std::chrono::nanoseconds(100));
+}
+
+BENCHMARK_TEMPLATE_DEFINE_F(DequeFixture, StealHeavySharedQueue, deque::direct::WorkStealingDeque<application::pc::RandomComputationCommand>)(benchmark::State& state)
+{
+    steal_heavy_shared(state, std::chrono::nanoseconds(100));
+}
+
+BENCHMARK_REGISTER_F(DequeFixture, OwnerOnlyDeque)->DenseThreadRange(1, 10)->UseRealTime();
+BENCHMARK_REGISTER_F(DequeFixture, OwnerOnlySharedQueue)->DenseThreadRange(1, 10)->UseRealTime();
+BENCHMARK_REGISTER_F(DequeFixture, StealHeavyDeque)->DenseThreadRange(1, 10)->UseRealTime();
+BENCHMARK_REGISTER_F(DequeFixture, StealHeavySharedQueue)->DenseThreadRange(1, 10)->UseRealTime();
@@ -0,0 +1,113 @@
+#pragma once
+
+#include "../application/workload.h"
+#include "../application/topology.h"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <string>
+
+//------------------------------------------------------------------------
+// The workload profiles the fixtures are driven with. The payload size
+// of a workload is picked by instantiating the structure with a
+// application::pc::PayloadCommand of that size
+//------------------------------------------------------------------------
+namespace workloads {
+
+using application::workload::Arrival;
+using application::workload::Distribution;
+using application::workload::Profile;
+using application::topology::Placement;
+
+//------------------------------------------------------------------------
+// Labels a run with the placement its threads were pinned under, and
+// skips it if the host can't provide that placement or the thread
+// couldn't be pinned. A skipped run still enters its benchmark loop,
+// which ends at once, so the threads stay in step
+//
+// \param cpu      - The CPU the profile placed the calling thread on
+// \param pin      - The calling thread's pin to that CPU
+//------------------------------------------------------------------------
+inline void label_placement(benchmark::State& state, const Profile& profile, int cpu,
+                            const application::topology::Pin& pin)
+{
+    auto where = profile.where();
+    if (where == Placement::Unpinned)
+        return;
+
+    state.SetLabel(application::topology::placement_name(where));
+
+    if (cpu == application::topology::kUnavailable)
+        state.SkipWithError("the placement needs more cores, nodes or sockets than this host has");
+    else if (cpu >= 0 && !pin.pinned())
+        state.SkipWithError(("couldn't pin to cpu " + std::to_string(cpu)).c_str());
+}
+
+//------------------------------------------------------------------------
+// One producer per consumer, no think time, and a constant amount of
+// work per value. This is the workload the benchmarks have always run
+//------------------------------------------------------------------------
+inline Profile constant_work(std::chrono::nanoseconds work)
+{
+    return Profile{}.work_for(Distribution::constant(work));
+}
+
+//------------------------------------------------------------------------
+// Poisson arrivals and exponentially distributed work, with the
+// consumers kept slightly ahead of the producers
+//------------------------------------------------------------------------
+inline Profile steady()
+{
+    return Profile{}
+        .think_for(Distribution::exponential(std::chrono::nanoseconds(200)))
+        .work_for(Distribution::exponential(std::chrono::nanoseconds(100)));
+}
+
+//------------------------------------------------------------------------
+// Producers release bursts of 64 values back to back, then idle for
+// 20us, so the structure swings between empty and deep
+//------------------------------------------------------------------------
+inline Profile bursty()
+{
+    return Profile{}
+        .arrive(Arrival::bursty(64, std::chrono::microseconds(20)))
+        .work_for(Distribution::exponential(std::chrono::nanoseconds(100)));
+}
+
+//------------------------------------------------------------------------
+// Alternating phases of 1024 values, the second eight times slower to
+// arrive, like a peak followed by a trough
+//------------------------------------------------------------------------
+inline Profile phased()
+{
+    return Profile{}
+        .arrive(Arrival::phased(1024, 8))
+        .think_for(Distribution::uniform(std::chrono::nanoseconds(50)))
+        .work_for(Distribution::exponential(std::chrono::nanoseconds(100)));
+}
+
+//------------------------------------------------------------------------
+// Three producers per consumer, each thinking a while between values,
+// and cheap work: many request threads feeding one worker
+//------------------------------------------------------------------------
+inline Profile fan_in()
+{
+    return Profile{}
+        .ratio(3, 1)
+        .think_for(Distribution::exponential(std::chrono::nanoseconds(300)))
+        .work_for(Distribution::constant(std::chrono::nanoseconds(50)));
+}
+
+//------------------------------------------------------------------------
+// One producer per three consumers, with expensive, variable work: a
+// dispatcher feeding a worker pool
+//------------------------------------------------------------------------
+inline Profile fan_out()
+{
+    return Profile{}
+        .ratio(1, 3)
+        .work_for(Distribution::uniform(std::chrono::nanoseconds(1000)));
+}
+
+}  // namespace workloads
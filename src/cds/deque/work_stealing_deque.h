@@ -0,0 +1,67 @@
+#pragma once
+
+#include <memory>
+#include <cstddef>
+
+namespace deque {
+
+namespace direct {
+template<typename T>
+class WorkStealingDeque;
+}
+
+//==========================================================
+// Represents the Chase-Lev work-stealing deque, with the
+// memory orderings of Le et al.'s C11 version. One owner
+// thread pushes and pops at the bottom, like a stack, and
+// any other thread can steal from the top. The owner's
+// operations don't use an atomic RMW unless they race a
+// thief for the last value, and thieves contend only with
+// each other, on a CAS of the top index.
+//
+// Values live in a circular array that the owner doubles
+// when it fills up. Thieves may still be reading an old
+// array, so old arrays are kept until the deque is
+// destroyed; they add up to less than the current one.
+//
+// Cells are read by thieves while the owner may be writing
+// them, so they're std::atomic<T>: T must be trivially
+// copyable, and should be no bigger than a pointer for the
+// cells to be lock-free. Deques of tasks hold pointers
+//==========================================================
+template<typename T>
+class WorkStealingDeque {
+public:
+    using value_type = T;
+
+    static constexpr std::size_t kDefaultCapacity = 1 << 10;
+
+    explicit WorkStealingDeque(std::size_t capacity = kDefaultCapacity);
+    ~WorkStealingDeque();
+
+    // Move operations
+    WorkStealingDeque(WorkStealingDeque&& other);
+    WorkStealingDeque& operator=(WorkStealingDeque&& other);
+
+    // Prevent copying
+    WorkStealingDeque(const WorkStealingDeque& other) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque& other) = delete;
+
+    // Owner operations
+    void push(T value);
+    bool pop(T& out);
+
+    // Thief operations
+    bool steal(T& out);
+
+    std::size_t size() const;
+    bool empty() const;
+    std::size_t capacity() const;
+
+private:
+    using Impl = deque::direct::WorkStealingDeque<T>;
+    std::unique_ptr<Impl> m_pImpl;
+};
+}  // namespace deque
+
+#include "../deque/work_stealing_deque_impl.h"
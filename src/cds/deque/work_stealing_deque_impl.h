@@ -0,0 +1,369 @@
+#pragma once
+
+#include "../deque/work_stealing_deque.h"
+#include "../../utility/memory.h"
+#include "../../utility/cache_line.h"
+#include "../../utility/instrumentation.h"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+//==========================================================
+// Represents the Chase-Lev work-stealing deque, with every
+// operation dispatched statically
+//==========================================================
+template<typename T>
+class deque::direct::WorkStealingDeque {
+public:
+    using value_type = T;
+
+    static constexpr std::size_t kDefaultCapacity = deque::WorkStealingDeque<T>::kDefaultCapacity;
+
+    explicit WorkStealingDeque(std::size_t capacity = kDefaultCapacity);
+    ~WorkStealingDeque() = default;
+
+    // Prevent copying
+    WorkStealingDeque(const WorkStealingDeque& other) = delete;
+    WorkStealingDeque& operator=(const WorkStealingDeque& other) = delete;
+
+    void push(T value);
+    bool pop(T& out);
+    bool steal(T& out);
+
+    std::size_t size() const;
+    bool empty() const;
+    std::size_t capacity() const;
+
+private:
+    //======================================================
+    // A power of two sized circular array. Index i lives in
+    // cell i & mask, so the indices never wrap themselves
+    //======================================================
+    class Array {
+    public:
+        explicit Array(std::size_t capacity)
+            : m_Mask(capacity - 1),
+              m_pCells(new std::atomic<T>[capacity]) {}
+
+        std::size_t capacity() const { return m_Mask + 1; }
+
+        T get(std::int64_t index) const {
+            return m_pCells[static_cast<std::size_t>(index) & m_Mask].load(std::memory_order_relaxed);
+        }
+
+        void put(std::int64_t index, T value) {
+            m_pCells[static_cast<std::size_t>(index) & m_Mask].store(value, std::memory_order_relaxed);
+        }
+
+    private:
+        const std::size_t m_Mask;
+        std::unique_ptr<std::atomic<T>[]> m_pCells;
+    };
+
+    Array* grow(Array* pArray, std::int64_t top, std::int64_t bottom);
+
+    // The owner's state. Thieves only read the bottom index
+    std::atomic<std::int64_t> m_Bottom{ 0 };
+    std::atomic<Array*> m_pArray{ nullptr };
+
+    // Every array the deque has had; only the owner touches it
+    std::vector<std::unique_ptr<Array>> m_Arrays;
+
+    // The thieves' state, on its own line so that stealing
+    // doesn't evict the owner's
+    char m_Pad0[utility::kCacheLineSize];
+    std::atomic<std::int64_t> m_Top{ 0 };
+    char m_Pad1[utility::kCacheLineSize];
+};
+
+//==========================================================
+// Direct Work-Stealing Deque definitions
+//==========================================================
+
+template<typename T>
+constexpr std::size_t deque::direct::WorkStealingDeque<T>::kDefaultCapacity;
+
+//==========================================================
+// Allocates the first array
+//
+// \param capacity  - The number of values the deque holds
+//                    before it first grows, rounded up to a
+//                    power of two
+//==========================================================
+template<typename T>
+deque::direct::WorkStealingDeque<T>::WorkStealingDeque(std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity)
+        size <<= 1;
+
+    m_Arrays.emplace_back(new Array(size));
+    m_pArray.store(m_Arrays.back().get(), std::memory_order_relaxed);
+}
+
+//==========================================================
+// Copies the live values of \param{pArray} into an array of
+// twice the size, and publishes it. Only the owner grows the
+// deque, and the old array is kept for thieves that are
+// still reading it
+//
+// \param pArray  - The full array
+// \param top     - The top index the owner last read
+// \param bottom  - The owner's bottom index
+//
+// \return        - The new array
+//==========================================================
+template<typename T>
+typename deque::direct::WorkStealingDeque<T>::Array*
+deque::direct::WorkStealingDeque<T>::grow(Array* pArray, std::int64_t top, std::int64_t bottom) {
+    m_Arrays.emplace_back(new Array(pArray->capacity() * 2));
+    auto pGrown = m_Arrays.back().get();
+
+    for (auto i = top; i < bottom; ++i)
+        pGrown->put(i, pArray->get(i));
+
+    m_pArray.store(pGrown, std::memory_order_release);
+    return pGrown;
+}
+
+//==========================================================
+// Pushes the value onto the bottom of the deque, growing it
+// if it's full. It must only be called by the owner
+//
+// \param value   - The value to push
+//==========================================================
+template<typename T>
+void deque::direct::WorkStealingDeque<T>::push(T value) {
+    auto bottom = m_Bottom.load(std::memory_order_relaxed);
+    auto top = m_Top.load(std::memory_order_acquire);
+    auto pArray = m_pArray.load(std::memory_order_relaxed);
+
+    if (bottom - top > static_cast<std::int64_t>(pArray->capacity()) - 1)
+        pArray = grow(pArray, top, bottom);
+
+    pArray->put(bottom, value);
+
+    // Publish the value along with the new bottom. This is the
+    // release fence and relaxed store of Le et al., as one
+    // release store
+    m_Bottom.store(bottom + 1, std::memory_order_release);
+}
+
+//==========================================================
+// Pops the bottom value, which is the one pushed last. It
+// must only be called by the owner. The owner claims the
+// slot by lowering the bottom index, and only races thieves,
+// with a CAS on the top index, for the very last value
+//
+// \param out   - Assigned the bottom value
+//
+// \return      - False if the deque was empty, or a thief
+//                stole the last value first
+//==========================================================
+template<typename T>
+bool deque::direct::WorkStealingDeque<T>::pop(T& out) {
+    auto bottom = m_Bottom.load(std::memory_order_relaxed) - 1;
+    auto pArray = m_pArray.load(std::memory_order_relaxed);
+    m_Bottom.store(bottom, std::memory_order_relaxed);
+
+    // Order the claim before reading the top, so that a thief
+    // and the owner can't both take the same value
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto top = m_Top.load(std::memory_order_relaxed);
+
+    if (top > bottom) {
+        // It was empty; put the bottom back
+        m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        utility::instrumentation::count(utility::instrumentation::Counter::EmptyPops);
+        return false;
+    }
+
+    auto value = pArray->get(bottom);
+    if (top == bottom) {
+        // This is the last value, so race the thieves for it
+        auto won = utility::instrumentation::cas(m_Top.compare_exchange_strong(
+            top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed));
+
+        m_Bottom.store(bottom + 1, std::memory_order_relaxed);
+        if (!won)
+            return false;
+    }
+
+    out = value;
+    return true;
+}
+
+//==========================================================
+// Steals the top value, which is the oldest one. Any thread
+// but the owner may call it
+//
+// \param out   - Assigned the top value
+//
+// \return      - False if the deque was empty, or another
+//                thread took the top value first. A thief
+//                that loses can try again straight away
+//==========================================================
+template<typename T>
+bool deque::direct::WorkStealingDeque<T>::steal(T& out) {
+    auto top = m_Top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto bottom = m_Bottom.load(std::memory_order_acquire);
+
+    if (top >= bottom)
+        return false;
+
+    // The value may be overwritten once the top moves on, so
+    // it's read before the CAS, and only kept if the CAS wins
+    auto pArray = m_pArray.load(std::memory_order_acquire);
+    auto value = pArray->get(top);
+
+    if (!utility::instrumentation::cas(m_Top.compare_exchange_strong(
+            top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)))
+        return false;
+
+    out = value;
+    return true;
+}
+
+//==========================================================
+// Returns the number of values in the deque. Other threads
+// may change it at any time, so it's only a hint
+//==========================================================
+template<typename T>
+std::size_t deque::direct::WorkStealingDeque<T>::size() const {
+    auto bottom = m_Bottom.load(std::memory_order_relaxed);
+    auto top = m_Top.load(std::memory_order_relaxed);
+    return bottom > top ? static_cast<std::size_t>(bottom - top) : 0;
+}
+
+//==========================================================
+// Returns whether the deque looks empty, see size()
+//==========================================================
+template<typename T>
+bool deque::direct::WorkStealingDeque<T>::empty() const {
+    return size() == 0;
+}
+
+//==========================================================
+// Returns the number of values the deque holds before it
+// next grows. It must only be called by the owner
+//==========================================================
+template<typename T>
+std::size_t deque::direct::WorkStealingDeque<T>::capacity() const {
+    return m_pArray.load(std::memory_order_relaxed)->capacity();
+}
+
+//==========================================================
+// Work-Stealing Deque class definitions
+//==========================================================
+
+template<typename T>
+constexpr std::size_t deque::WorkStealingDeque<T>::kDefaultCapacity;
+
+//==========================================================
+// Constructs a deque that holds \param{capacity} values
+// before it first grows
+//
+// \param capacity  - The initial capacity, which is rounded
+//                    up to a power of two
+//==========================================================
+template<typename T>
+deque::WorkStealingDeque<T>::WorkStealingDeque(std::size_t capacity)
+    : m_pImpl(utility::make_unique<Impl>(capacity)) {}
+
+//==========================================================
+// Destructs the WorkStealingDeque, freeing all allocated
+// memory
+//==========================================================
+template<typename T>
+deque::WorkStealingDeque<T>::~WorkStealingDeque() {
+    // This automatically calls the dstor of Impl
+}
+
+//==========================================================
+// Defines the move constructor
+//
+// \param other     The other deque to move into this one
+//==========================================================
+template<typename T>
+deque::WorkStealingDeque<T>::WorkStealingDeque(WorkStealingDeque && other)
+    : m_pImpl{ std::move(other.m_pImpl) }
+{}
+
+//==========================================================
+// Defines the move assignment operator
+//
+// \param other     The other deque to move into this one
+//==========================================================
+template<typename T>
+deque::WorkStealingDeque<T>& deque::WorkStealingDeque<T>::operator=(WorkStealingDeque && other) {
+    if (this != &other)
+        m_pImpl = std::move(other.m_pImpl);
+
+    return *this;
+}
+
+//==========================================================
+// Pushes the value onto the bottom of the deque. It must
+// only be called by the owner
+//
+// \param value   - The value to push
+//==========================================================
+template<typename T>
+void deque::WorkStealingDeque<T>::push(T value) {
+    m_pImpl->push(value);
+}
+
+//==========================================================
+// Pops the value pushed last. It must only be called by the
+// owner
+//
+// \param out   - Assigned the bottom value
+//
+// \return      - False if the deque was empty
+//==========================================================
+template<typename T>
+bool deque::WorkStealingDeque<T>::pop(T& out) {
+    return m_pImpl->pop(out);
+}
+
+//==========================================================
+// Steals the oldest value. Any thread but the owner may
+// call it
+//
+// \param out   - Assigned the top value
+//
+// \return      - False if the deque was empty, or another
+//                thread took the value first
+//==========================================================
+template<typename T>
+bool deque::WorkStealingDeque<T>::steal(T& out) {
+    return m_pImpl->steal(out);
+}
+
+//==========================================================
+// Returns the number of values in the deque, as a hint
+//==========================================================
+template<typename T>
+std::size_t deque::WorkStealingDeque<T>::size() const {
+    return m_pImpl->size();
+}
+
+//==========================================================
+// Returns whether the deque looks empty
+//==========================================================
+template<typename T>
+bool deque::WorkStealingDeque<T>::empty() const {
+    return m_pImpl->empty();
+}
+
+//==========================================================
+// Returns the number of values the deque holds before it
+// next grows
+//==========================================================
+template<typename T>
+std::size_t deque::WorkStealingDeque<T>::capacity() const {
+    return m_pImpl->capacity();
+}
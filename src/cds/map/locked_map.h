@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../map/map.h"
+
+#include <memory>
+#include <cstddef>
+#include <functional>
+
+namespace map {
+
+namespace direct {
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class LockedMap;
+}
+
+//==========================================================
+// Represents a std::unordered_map behind a single mutex,
+// which is the baseline the lock-free maps are measured
+// against. This is the polymorphic adapter over
+// map::direct::LockedMap
+//==========================================================
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+class LockedMap : public map::MapBase<K, V> {
+public:
+    LockedMap();
+    ~LockedMap();
+
+    // Move operations
+    LockedMap(LockedMap&& other);
+    LockedMap& operator=(LockedMap&& other);
+
+    // Prevent copying
+    LockedMap(const LockedMap& other) = delete;
+    LockedMap& operator=(const LockedMap& other) = delete;
+
+    // inherited from map::MapBase
+    using map::MapBase<K, V>::insert;
+    using map::MapBase<K, V>::upsert;
+    virtual bool insert(const K& key, V&& value) override;
+    virtual bool upsert(const K& key, V&& value) override;
+    virtual bool find(const K& key, V& out) const override;
+    virtual bool erase(const K& key) override;
+    virtual std::size_t size() const override;
+
+private:
+    using Impl = map::direct::LockedMap<K, V, Hash, KeyEqual>;
+    std::unique_ptr<Impl> m_pImpl;
+};
+}  // namespace map
+
+#include "../map/locked_map_impl.h"
@@ -0,0 +1,160 @@
+#pragma once
+
+#include "../map/locked_map.h"
+#include "../../utility/memory.h"
+#include "../../utility/instrumentation.h"
+
+#include <mutex>
+#include <memory>
+#include <cstddef>
+#include <utility>
+#include <unordered_map>
+
+//==========================================================
+// Represents the locked map, with every operation
+// dispatched statically
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual>
+class map::direct::LockedMap {
+public:
+    using key_type = K;
+    using mapped_type = V;
+
+    LockedMap() = default;
+    ~LockedMap() = default;
+
+    // Prevent copying
+    LockedMap(const LockedMap& other) = delete;
+    LockedMap& operator=(const LockedMap& other) = delete;
+
+    bool insert(const K& key, V&& value);
+    bool insert(const K& key, const V& value) { return insert(key, V(value)); }
+    bool upsert(const K& key, V&& value);
+    bool upsert(const K& key, const V& value) { return upsert(key, V(value)); }
+    bool find(const K& key, V& out) const;
+    bool erase(const K& key);
+
+    std::size_t size() const;
+    bool empty() const;
+
+private:
+    std::unordered_map<K, V, Hash, KeyEqual> m_Map;
+    mutable std::mutex m_Mut;
+};
+
+//==========================================================
+// Direct Locked Map definitions
+//==========================================================
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+bool map::direct::LockedMap<K, V, Hash, KeyEqual>::insert(const K& key, V&& value) {
+    utility::instrumentation::LockGuard<std::mutex> lock{ m_Mut };
+    return m_Map.emplace(key, std::move(value)).second;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+bool map::direct::LockedMap<K, V, Hash, KeyEqual>::upsert(const K& key, V&& value) {
+    utility::instrumentation::LockGuard<std::mutex> lock{ m_Mut };
+
+    auto pIter = m_Map.find(key);
+    if (pIter != m_Map.end()) {
+        pIter->second = std::move(value);
+        return false;
+    }
+
+    m_Map.emplace(key, std::move(value));
+    return true;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+bool map::direct::LockedMap<K, V, Hash, KeyEqual>::find(const K& key, V& out) const {
+    utility::instrumentation::LockGuard<std::mutex> lock{ m_Mut };
+
+    auto pIter = m_Map.find(key);
+    if (pIter == m_Map.end())
+        return false;
+
+    out = pIter->second;
+    return true;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+bool map::direct::LockedMap<K, V, Hash, KeyEqual>::erase(const K& key) {
+    utility::instrumentation::LockGuard<std::mutex> lock{ m_Mut };
+    return m_Map.erase(key) != 0;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+std::size_t map::direct::LockedMap<K, V, Hash, KeyEqual>::size() const {
+    utility::instrumentation::LockGuard<std::mutex> lock{ m_Mut };
+    return m_Map.size();
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+bool map::direct::LockedMap<K, V, Hash, KeyEqual>::empty() const {
+    return size() == 0;
+}
+
+//==========================================================
+// Locked Map class definitions
+//==========================================================
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+map::LockedMap<K, V, Hash, KeyEqual>::LockedMap()
+    : m_pImpl(utility::make_unique<Impl>()) {}
+
+//==========================================================
+// Destructs the LockedMap, freeing all allocated memory
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual>
+map::LockedMap<K, V, Hash, KeyEqual>::~LockedMap() {
+    // This automatically calls the dstor of Impl
+}
+
+//==========================================================
+// Defines the move constructor
+//
+// \param other     The other map to move into this one
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual>
+map::LockedMap<K, V, Hash, KeyEqual>::LockedMap(LockedMap && other)
+    : m_pImpl{ std::move(other.m_pImpl) }
+{}
+
+//==========================================================
+// Defines the move assignment operator
+//
+// \param other     The other map to move into this one
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual>
+map::LockedMap<K, V, Hash, KeyEqual>& map::LockedMap<K, V, Hash, KeyEqual>::operator=(LockedMap && other) {
+    if (this != &other)
+        m_pImpl = std::move(other.m_pImpl);
+
+    return *this;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+bool map::LockedMap<K, V, Hash, KeyEqual>::insert(const K& key, V&& value) {
+    return m_pImpl->insert(key, std::move(value));
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+bool map::LockedMap<K, V, Hash, KeyEqual>::upsert(const K& key, V&& value) {
+    return m_pImpl->upsert(key, std::move(value));
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+bool map::LockedMap<K, V, Hash, KeyEqual>::find(const K& key, V& out) const {
+    return m_pImpl->find(key, out);
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+bool map::LockedMap<K, V, Hash, KeyEqual>::erase(const K& key) {
+    return m_pImpl->erase(key);
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual>
+std::size_t map::LockedMap<K, V, Hash, KeyEqual>::size() const {
+    return m_pImpl->size();
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+namespace map {
+
+//==========================================================
+// Represents an abstract base class for all map
+// implementations
+//==========================================================
+template<typename K, typename V>
+class MapBase {
+public:
+    using key_type = K;
+    using mapped_type = V;
+
+    virtual ~MapBase() { };
+
+    //==========================================================
+    // Inserts the value under \param{key} if the key is absent.
+    // Returns false, leaving the map as it was, if it's present
+    //==========================================================
+    virtual bool insert(const K& key, V&& value) = 0;
+
+    //==========================================================
+    // Inserts the value under \param{key}, or replaces the
+    // value already there. Returns true if the key was absent
+    //==========================================================
+    virtual bool upsert(const K& key, V&& value) = 0;
+
+    //==========================================================
+    // Copies the value under \param{key} into \param{out}.
+    // Returns false if the key is absent
+    //==========================================================
+    virtual bool find(const K& key, V& out) const = 0;
+
+    //==========================================================
+    // Removes \param{key}. Returns false if it was absent
+    //==========================================================
+    virtual bool erase(const K& key) = 0;
+
+    virtual std::size_t size() const = 0;
+
+    bool insert(const K& key, const V& value) {
+        return insert(key, V(value));
+    }
+
+    bool upsert(const K& key, const V& value) {
+        return upsert(key, V(value));
+    }
+
+    bool empty() const {
+        return size() == 0;
+    }
+};
+
+}  // namespace map
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "../map/map.h"
+#include "../../utility/reclamation.h"
+
+#include <memory>
+#include <cstddef>
+#include <functional>
+
+namespace map {
+
+namespace direct {
+template<typename K, typename V, typename Compare = std::less<K>,
+         typename Reclaimer = utility::reclaim::Epoch>
+class SkipListMap;
+}
+
+//==========================================================
+// Represents the lock-free skiplist of Herlihy, Lev, Luchangco
+// and Shavit, as an ordered map. Each node is deleted by
+// marking its links top down, the bottom one last, and
+// searches unlink the marked nodes they pass. Insertion and
+// removal are lock-free, and lookups are wait-free: they
+// step over marked nodes rather than unlinking them, and
+// never start over.
+//
+// lower_bound returns an iterator over the entries in key
+// order, for range scans. Iterators see each entry as it was
+// when they reached it, and keep the thread pinned while they
+// point into the map, so Reclaimer must be a policy whose
+// guards nest and cover whole traversals: Epoch or Leak.
+// This is the polymorphic adapter over
+// map::direct::SkipListMap
+//==========================================================
+template<typename K, typename V, typename Compare = std::less<K>,
+         typename Reclaimer = utility::reclaim::Epoch>
+class SkipListMap : public map::MapBase<K, V> {
+public:
+    using reclaimer_type = Reclaimer;
+    using iterator = typename map::direct::SkipListMap<K, V, Compare, Reclaimer>::Iterator;
+
+    SkipListMap();
+    ~SkipListMap();
+
+    // Move operations
+    SkipListMap(SkipListMap&& other);
+    SkipListMap& operator=(SkipListMap&& other);
+
+    // Prevent copying
+    SkipListMap(const SkipListMap& other) = delete;
+    SkipListMap& operator=(const SkipListMap& other) = delete;
+
+    // inherited from map::MapBase
+    using map::MapBase<K, V>::insert;
+    using map::MapBase<K, V>::upsert;
+    virtual bool insert(const K& key, V&& value) override;
+    virtual bool upsert(const K& key, V&& value) override;
+    virtual bool find(const K& key, V& out) const override;
+    virtual bool erase(const K& key) override;
+    virtual std::size_t size() const override;
+
+    iterator lower_bound(const K& key) const;
+    iterator begin() const;
+    iterator end() const;
+
+private:
+    using Impl = map::direct::SkipListMap<K, V, Compare, Reclaimer>;
+    std::unique_ptr<Impl> m_pImpl;
+};
+}  // namespace map
+
+#include "../map/skiplist_map_impl.h"
@@ -0,0 +1,710 @@
+#pragma once
+
+#include "../map/skiplist_map.h"
+#include "../map/skiplist_node.h"
+#include "../../utility/memory.h"
+#include "../../utility/backoff.h"
+#include "../../utility/node_pool.h"
+#include "../../utility/instrumentation.h"
+#include "../../utility/reclamation.h"
+
+#include <atomic>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+
+//==========================================================
+// Represents the lock-free skiplist map, with every
+// operation dispatched statically
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+class map::direct::SkipListMap {
+    static_assert(std::is_same<Reclaimer, utility::reclaim::Epoch>::value ||
+                  std::is_same<Reclaimer, utility::reclaim::Leak>::value,
+        "SkipListMap needs a reclaimer whose guards nest and protect whole traversals");
+
+    using Node = map::sl::Node<K, V>;
+    using NodePtr = map::sl::NodePtr<K, V>;
+    using NodePool = utility::NodePool<Node>;
+    using Guard = typename Reclaimer::Guard;
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using reclaimer_type = Reclaimer;
+
+    //======================================================
+    // A forward iterator over the entries in key order. It
+    // holds a guard, so the node it's on stays valid however
+    // long it's kept; it must stay on the thread that made it.
+    // Guards nest, so each copy holds one of its own in place
+    // rather than sharing one from the heap
+    //======================================================
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<const K, V>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const value_type*;
+        using reference = const value_type&;
+
+        Iterator() = default;
+
+        reference operator*() const { return m_pNode->entry(); }
+        pointer operator->() const { return &m_pNode->entry(); }
+
+        //==================================================
+        // Steps to the next entry. A node replaced by upsert
+        // links to its replacement, which holds the same key,
+        // so entries that aren't past this one are skipped
+        //==================================================
+        Iterator& operator++() {
+            auto& key = m_pNode->key();
+
+            auto pNext = SkipListMap::live(m_pNode->next(0).load(std::memory_order_acquire).get());
+            while (pNext != nullptr && !m_pMap->m_Less(key, pNext->key()))
+                pNext = SkipListMap::live(pNext->next(0).load(std::memory_order_acquire).get());
+
+            m_pNode = pNext;
+            if (m_pNode == nullptr)
+                m_Guard.reset();
+
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        bool operator==(const Iterator& other) const { return m_pNode == other.m_pNode; }
+        bool operator!=(const Iterator& other) const { return m_pNode != other.m_pNode; }
+
+    private:
+        friend class SkipListMap;
+
+        //==================================================
+        // Holds a guard while the iterator points into the
+        // map. A copy takes a guard of its own
+        //==================================================
+        class HeldGuard {
+        public:
+            HeldGuard() = default;
+            explicit HeldGuard(bool engage) { if (engage) this->engage(); }
+            HeldGuard(const HeldGuard& other) { if (other.m_Engaged) engage(); }
+            ~HeldGuard() { reset(); }
+
+            HeldGuard& operator=(const HeldGuard& other) {
+                if (other.m_Engaged && !m_Engaged)
+                    engage();
+                else if (!other.m_Engaged)
+                    reset();
+
+                return *this;
+            }
+
+            void reset() {
+                if (m_Engaged) {
+                    reinterpret_cast<Guard*>(&m_Storage)->~Guard();
+                    m_Engaged = false;
+                }
+            }
+
+        private:
+            void engage() {
+                new (&m_Storage) Guard();
+                m_Engaged = true;
+            }
+
+            typename std::aligned_storage<sizeof(Guard), alignof(Guard)>::type m_Storage;
+            bool m_Engaged = false;
+        };
+
+        // The caller must hold a guard across the call
+        Iterator(const SkipListMap* pMap, Node* pNode)
+            : m_pMap(pMap), m_pNode(pNode), m_Guard(pNode != nullptr) {}
+
+        const SkipListMap* m_pMap = nullptr;
+        Node* m_pNode = nullptr;
+        HeldGuard m_Guard;
+    };
+
+    SkipListMap();
+    ~SkipListMap();
+
+    // Prevent copying
+    SkipListMap(const SkipListMap& other) = delete;
+    SkipListMap& operator=(const SkipListMap& other) = delete;
+
+    bool insert(const K& key, V&& value);
+    bool insert(const K& key, const V& value) { return insert(key, V(value)); }
+    bool upsert(const K& key, V&& value);
+    bool upsert(const K& key, const V& value) { return upsert(key, V(value)); }
+    bool find(const K& key, V& out) const;
+    bool erase(const K& key);
+
+    Iterator lower_bound(const K& key) const;
+    Iterator begin() const;
+    Iterator end() const;
+
+    std::size_t size() const;
+    bool empty() const;
+
+private:
+    static std::size_t random_height();
+    static Node* live(Node* pNode);
+
+    Node* make_node(const K& key, V&& value) const;
+    Node* seek(const K& key) const;
+
+    bool search(const K& key, Node** preds, Node** succs);
+    void link_tower(Node* pNode, Node** preds, Node** succs);
+    void mark_tower(Node* pNode);
+    void release(Node* pNode);
+    void raise_height(std::size_t height);
+
+    bool equal(const K& lhs, const K& rhs) const { return !m_Less(lhs, rhs) && !m_Less(rhs, lhs); }
+
+    Compare m_Less;
+    Node* m_pHead;
+
+    // The tallest tower ever linked in. Searches start there
+    // rather than at kMaxHeight
+    std::atomic<std::size_t> m_Height{ 1 };
+    std::atomic<std::size_t> m_Count{ 0 };
+};
+
+//==========================================================
+// Direct Skiplist Map definitions
+//==========================================================
+
+//==========================================================
+// The default constructor, which makes the head: a tower of
+// the greatest height, with no entry
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+map::direct::SkipListMap<K, V, Compare, Reclaimer>::SkipListMap()
+    : m_pHead(NodePool::create()) {
+    m_pHead->build(map::sl::kMaxHeight);
+}
+
+//==========================================================
+// The destructor, which frees every node. Erased nodes have
+// been retired once unlinked from every level, so the bottom
+// level holds exactly the nodes that remain
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+map::direct::SkipListMap<K, V, Compare, Reclaimer>::~SkipListMap() {
+    auto pIter = m_pHead;
+    while (pIter != nullptr) {
+        auto pNode = pIter;
+        pIter = pIter->next(0).load(std::memory_order_acquire).get();
+
+        NodePool::destroy(pNode);
+    }
+}
+
+//==========================================================
+// Draws a tower height, where each level is half as likely
+// as the one below it
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+std::size_t map::direct::SkipListMap<K, V, Compare, Reclaimer>::random_height() {
+    auto bits = utility::backoff::next_random();
+
+    std::size_t height = 1;
+    for (; (bits & 1) != 0 && height < map::sl::kMaxHeight; bits >>= 1)
+        ++height;
+
+    return height;
+}
+
+//==========================================================
+// Returns the first node from \param{pNode} on that isn't
+// deleted, or null
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+typename map::direct::SkipListMap<K, V, Compare, Reclaimer>::Node*
+map::direct::SkipListMap<K, V, Compare, Reclaimer>::live(Node* pNode) {
+    while (pNode != nullptr) {
+        auto next = pNode->next(0).load(std::memory_order_acquire);
+        if (!map::sl::is_marked(next))
+            break;
+
+        pNode = next.get();
+    }
+
+    return pNode;
+}
+
+//==========================================================
+// Allocates a node holding the entry, with a random height
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+typename map::direct::SkipListMap<K, V, Compare, Reclaimer>::Node*
+map::direct::SkipListMap<K, V, Compare, Reclaimer>::make_node(const K& key, V&& value) const {
+    auto pNode = NodePool::create();
+    try {
+        pNode->build(random_height());
+        pNode->emplace(key, std::move(value));
+    }
+    catch (...) {
+        NodePool::destroy(pNode);
+        throw;
+    }
+
+    return pNode;
+}
+
+//==========================================================
+// Raises the search height to at least \param{height}. It's
+// raised before a tower is linked in, and never lowered
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+void map::direct::SkipListMap<K, V, Compare, Reclaimer>::raise_height(std::size_t height) {
+    auto current = m_Height.load(std::memory_order_relaxed);
+    while (current < height && !m_Height.compare_exchange_weak(current, height, std::memory_order_release));
+}
+
+//==========================================================
+// Returns the first node whose key isn't less than \param{key}
+// and that isn't deleted, or null. This is the wait-free
+// search: it steps over deleted nodes without unlinking them,
+// so it never has to start over
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+typename map::direct::SkipListMap<K, V, Compare, Reclaimer>::Node*
+map::direct::SkipListMap<K, V, Compare, Reclaimer>::seek(const K& key) const {
+    auto pPred = m_pHead;
+    Node* pCurr = nullptr;
+
+    for (auto level = m_Height.load(std::memory_order_acquire); level-- > 0; ) {
+        pCurr = pPred->next(level).load(std::memory_order_acquire).get();
+        while (pCurr != nullptr) {
+            auto succ = pCurr->next(level).load(std::memory_order_acquire);
+            if (map::sl::is_marked(succ)) {
+                pCurr = succ.get();
+                continue;
+            }
+
+            if (!m_Less(pCurr->key(), key))
+                break;
+
+            pPred = pCurr;
+            pCurr = succ.get();
+        }
+    }
+
+    return pCurr;
+}
+
+//==========================================================
+// Finds the predecessor and successor of \param{key} at every
+// level, unlinking the deleted nodes on the way. It starts
+// over when an unlink fails, since the predecessor was
+// deleted or changed under it
+//
+// \param key     - The key to search for
+// \param preds   - Assigned the last node before the key at
+//                  each level, possibly the head
+// \param succs   - Assigned the first node not before the key
+//                  at each level, or null
+//
+// \return        - Whether succs[0] holds the key
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+bool map::direct::SkipListMap<K, V, Compare, Reclaimer>::search(const K& key, Node** preds, Node** succs) {
+    utility::instrumentation::RetryLoop retries;
+
+    while (true) {
+        auto height = m_Height.load(std::memory_order_acquire);
+        for (auto level = height; level < map::sl::kMaxHeight; ++level) {
+            preds[level] = m_pHead;
+            succs[level] = nullptr;
+        }
+
+        auto pPred = m_pHead;
+        auto restart = false;
+
+        for (auto level = height; level-- > 0 && !restart; ) {
+            auto pCurr = pPred->next(level).load(std::memory_order_acquire).get();
+            while (pCurr != nullptr) {
+                auto succ = pCurr->next(level).load(std::memory_order_acquire);
+                if (map::sl::is_marked(succ)) {
+                    auto expected = NodePtr{ pCurr, 0 };
+                    if (!utility::instrumentation::cas(pPred->next(level).compare_exchange_strong(expected, NodePtr{ succ.get(), 0 }))) {
+                        restart = true;
+                        break;
+                    }
+
+                    pCurr = succ.get();
+                    continue;
+                }
+
+                if (!m_Less(pCurr->key(), key))
+                    break;
+
+                pPred = pCurr;
+                pCurr = succ.get();
+            }
+
+            preds[level] = pPred;
+            succs[level] = pCurr;
+        }
+
+        if (!restart)
+            return succs[0] != nullptr && !m_Less(key, succs[0]->key());
+
+        retries.failed();
+    }
+}
+
+//==========================================================
+// Links the upper levels of a node that's just been linked
+// in at the bottom, from the positions \param{preds} and
+// \param{succs} that the bottom was linked at. Each level's
+// link is pointed at the successor before the node is linked
+// in; if the link turns out to be marked, the node is being
+// erased, and linking stops. A level linked in after the
+// eraser cleaned up would be left behind, so the inserter
+// searches once more if the node was erased, then releases it
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+void map::direct::SkipListMap<K, V, Compare, Reclaimer>::link_tower(Node* pNode, Node** preds, Node** succs) {
+    auto& key = pNode->key();
+    auto erased = false;
+
+    for (std::size_t level = 1; level < pNode->height && !erased; ++level) {
+        while (true) {
+            auto link = pNode->next(level).load(std::memory_order_acquire);
+            if (map::sl::is_marked(link)) {
+                erased = true;
+                break;
+            }
+
+            auto pSucc = succs[level];
+            if (link.get() != pSucc && !pNode->next(level).compare_exchange_strong(link, NodePtr{ pSucc, 0 }))
+                continue;
+
+            auto expected = NodePtr{ pSucc, 0 };
+            if (utility::instrumentation::cas(preds[level]->next(level).compare_exchange_strong(expected, NodePtr{ pNode, 0 })))
+                break;
+
+            search(key, preds, succs);
+        }
+    }
+
+    if (map::sl::is_marked(pNode->next(0).load(std::memory_order_acquire)))
+        search(key, preds, succs);
+
+    release(pNode);
+}
+
+//==========================================================
+// Marks every level of the node's tower above the bottom,
+// from the top down. Marking the bottom is what deletes it,
+// and is left to the caller
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+void map::direct::SkipListMap<K, V, Compare, Reclaimer>::mark_tower(Node* pNode) {
+    for (auto level = static_cast<std::size_t>(pNode->height); level-- > 1; ) {
+        auto link = pNode->next(level).load(std::memory_order_acquire);
+        while (!map::sl::is_marked(link) &&
+               !pNode->next(level).compare_exchange_weak(link, NodePtr{ link.get(), 1 }));
+    }
+}
+
+//==========================================================
+// Drops the caller's claim on the node, and retires it if it
+// was the last one
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+void map::direct::SkipListMap<K, V, Compare, Reclaimer>::release(Node* pNode) {
+    if (pNode->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        Reclaimer::retire(pNode);
+}
+
+//==========================================================
+// Inserts the value under \param{key}, unless the key is
+// already present. The node is linked in at the bottom
+// level first, which is where it takes effect, and then
+// level by level up its tower
+//
+// \param key     - The key to insert
+// \param value   - The value to move in
+//
+// \return        - False if the key was present
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+bool map::direct::SkipListMap<K, V, Compare, Reclaimer>::insert(const K& key, V&& value) {
+    Guard guard;
+    Node* preds[map::sl::kMaxHeight];
+    Node* succs[map::sl::kMaxHeight];
+
+    Node* pNode = nullptr;
+    while (true) {
+        if (search(key, preds, succs)) {
+            if (pNode != nullptr)
+                NodePool::destroy(pNode);
+
+            return false;
+        }
+
+        if (pNode == nullptr) {
+            pNode = make_node(key, std::move(value));
+            raise_height(pNode->height);
+
+            // The search may have started below the new height
+            continue;
+        }
+
+        for (std::size_t level = 0; level < pNode->height; ++level)
+            pNode->next(level).store(NodePtr{ succs[level], 0 }, std::memory_order_relaxed);
+
+        auto expected = NodePtr{ succs[0], 0 };
+        if (utility::instrumentation::cas(preds[0]->next(0).compare_exchange_strong(expected, NodePtr{ pNode, 0 })))
+            break;
+    }
+
+    m_Count.fetch_add(1, std::memory_order_relaxed);
+    link_tower(pNode, preds, succs);
+    return true;
+}
+
+//==========================================================
+// Inserts the value under \param{key}, or replaces the node
+// that holds the key. The old node's bottom link is marked
+// with the new node as its successor, so one CAS deletes the
+// old entry and links in the new one, and no lookup ever
+// finds the key missing
+//
+// \param key     - The key to insert or assign
+// \param value   - The value to move in
+//
+// \return        - True if the key was absent
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+bool map::direct::SkipListMap<K, V, Compare, Reclaimer>::upsert(const K& key, V&& value) {
+    Guard guard;
+    Node* preds[map::sl::kMaxHeight];
+    Node* succs[map::sl::kMaxHeight];
+
+    auto pNode = make_node(key, std::move(value));
+    raise_height(pNode->height);
+
+    while (true) {
+        if (!search(key, preds, succs)) {
+            for (std::size_t level = 0; level < pNode->height; ++level)
+                pNode->next(level).store(NodePtr{ succs[level], 0 }, std::memory_order_relaxed);
+
+            auto expected = NodePtr{ succs[0], 0 };
+            if (!utility::instrumentation::cas(preds[0]->next(0).compare_exchange_strong(expected, NodePtr{ pNode, 0 })))
+                continue;
+
+            m_Count.fetch_add(1, std::memory_order_relaxed);
+            link_tower(pNode, preds, succs);
+            return true;
+        }
+
+        auto pOld = succs[0];
+        mark_tower(pOld);
+
+        auto link = pOld->next(0).load(std::memory_order_acquire);
+        if (map::sl::is_marked(link))
+            continue;
+
+        pNode->next(0).store(NodePtr{ link.get(), 0 }, std::memory_order_relaxed);
+        if (!utility::instrumentation::cas(pOld->next(0).compare_exchange_strong(link, NodePtr{ pNode, 1 })))
+            continue;
+
+        // Unlink the old node from every level, which also finds
+        // where the new tower goes
+        search(key, preds, succs);
+        release(pOld);
+
+        link_tower(pNode, preds, succs);
+        return false;
+    }
+}
+
+//==========================================================
+// Copies the value under \param{key} into \param{out}. This
+// is wait-free
+//
+// \return      - False if the key is absent
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+bool map::direct::SkipListMap<K, V, Compare, Reclaimer>::find(const K& key, V& out) const {
+    Guard guard;
+
+    auto pNode = seek(key);
+    if (pNode == nullptr || m_Less(key, pNode->key()))
+        return false;
+
+    out = pNode->value();
+    return true;
+}
+
+//==========================================================
+// Removes \param{key}. Marking the bottom link deletes the
+// node; if another thread marked it first, the search runs
+// again, since a replacement may have put the key back
+//
+// \return      - False if the key was absent
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+bool map::direct::SkipListMap<K, V, Compare, Reclaimer>::erase(const K& key) {
+    Guard guard;
+    Node* preds[map::sl::kMaxHeight];
+    Node* succs[map::sl::kMaxHeight];
+
+    while (true) {
+        if (!search(key, preds, succs))
+            return false;
+
+        auto pVictim = succs[0];
+        mark_tower(pVictim);
+
+        auto link = pVictim->next(0).load(std::memory_order_acquire);
+        while (!map::sl::is_marked(link)) {
+            if (utility::instrumentation::cas(pVictim->next(0).compare_exchange_strong(link, NodePtr{ link.get(), 1 }))) {
+                // Unlink it from every level
+                search(key, preds, succs);
+                release(pVictim);
+
+                m_Count.fetch_sub(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+}
+
+//==========================================================
+// Returns an iterator to the first entry whose key isn't
+// less than \param{key}, or end()
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+typename map::direct::SkipListMap<K, V, Compare, Reclaimer>::Iterator
+map::direct::SkipListMap<K, V, Compare, Reclaimer>::lower_bound(const K& key) const {
+    Guard guard;
+    return Iterator{ this, seek(key) };
+}
+
+//==========================================================
+// Returns an iterator to the entry with the least key
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+typename map::direct::SkipListMap<K, V, Compare, Reclaimer>::Iterator
+map::direct::SkipListMap<K, V, Compare, Reclaimer>::begin() const {
+    Guard guard;
+    return Iterator{ this, live(m_pHead->next(0).load(std::memory_order_acquire).get()) };
+}
+
+template<typename K, typename V, typename Compare, typename Reclaimer>
+typename map::direct::SkipListMap<K, V, Compare, Reclaimer>::Iterator
+map::direct::SkipListMap<K, V, Compare, Reclaimer>::end() const {
+    return Iterator{};
+}
+
+//==========================================================
+// Returns the number of entries, as a hint
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+std::size_t map::direct::SkipListMap<K, V, Compare, Reclaimer>::size() const {
+    return m_Count.load(std::memory_order_relaxed);
+}
+
+template<typename K, typename V, typename Compare, typename Reclaimer>
+bool map::direct::SkipListMap<K, V, Compare, Reclaimer>::empty() const {
+    return size() == 0;
+}
+
+//==========================================================
+// Skiplist Map class definitions
+//==========================================================
+
+//==========================================================
+// The default constructor for the SkipListMap class
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+map::SkipListMap<K, V, Compare, Reclaimer>::SkipListMap()
+    : m_pImpl(utility::make_unique<Impl>()) {}
+
+//==========================================================
+// Destructs the SkipListMap, freeing all allocated memory
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+map::SkipListMap<K, V, Compare, Reclaimer>::~SkipListMap() {
+    // This automatically calls the dstor of Impl
+}
+
+//==========================================================
+// Defines the move constructor
+//
+// \param other     The other map to move into this one
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+map::SkipListMap<K, V, Compare, Reclaimer>::SkipListMap(SkipListMap && other)
+    : m_pImpl{ std::move(other.m_pImpl) }
+{}
+
+//==========================================================
+// Defines the move assignment operator
+//
+// \param other     The other map to move into this one
+//==========================================================
+template<typename K, typename V, typename Compare, typename Reclaimer>
+map::SkipListMap<K, V, Compare, Reclaimer>& map::SkipListMap<K, V, Compare, Reclaimer>::operator=(SkipListMap && other) {
+    if (this != &other)
+        m_pImpl = std::move(other.m_pImpl);
+
+    return *this;
+}
+
+template<typename K, typename V, typename Compare, typename Reclaimer>
+bool map::SkipListMap<K, V, Compare, Reclaimer>::insert(const K& key, V&& value) {
+    return m_pImpl->insert(key, std::move(value));
+}
+
+template<typename K, typename V, typename Compare, typename Reclaimer>
+bool map::SkipListMap<K, V, Compare, Reclaimer>::upsert(const K& key, V&& value) {
+    return m_pImpl->upsert(key, std::move(value));
+}
+
+template<typename K, typename V, typename Compare, typename Reclaimer>
+bool map::SkipListMap<K, V, Compare, Reclaimer>::find(const K& key, V& out) const {
+    return m_pImpl->find(key, out);
+}
+
+template<typename K, typename V, typename Compare, typename Reclaimer>
+bool map::SkipListMap<K, V, Compare, Reclaimer>::erase(const K& key) {
+    return m_pImpl->erase(key);
+}
+
+template<typename K, typename V, typename Compare, typename Reclaimer>
+std::size_t map::SkipListMap<K, V, Compare, Reclaimer>::size() const {
+    return m_pImpl->size();
+}
+
+template<typename K, typename V, typename Compare, typename Reclaimer>
+typename map::SkipListMap<K, V, Compare, Reclaimer>::iterator
+map::SkipListMap<K, V, Compare, Reclaimer>::lower_bound(const K& key) const {
+    return m_pImpl->lower_bound(key);
+}
+
+template<typename K, typename V, typename Compare, typename Reclaimer>
+typename map::SkipListMap<K, V, Compare, Reclaimer>::iterator
+map::SkipListMap<K, V, Compare, Reclaimer>::begin() const {
+    return m_pImpl->begin();
+}
+
+template<typename K, typename V, typename Compare, typename Reclaimer>
+typename map::SkipListMap<K, V, Compare, Reclaimer>::iterator
+map::SkipListMap<K, V, Compare, Reclaimer>::end() const {
+    return m_pImpl->end();
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include "../../utility/tagged_ptr.h"
+
+#include <new>
+#include <atomic>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace map { namespace sl {
+template<typename K, typename V>
+struct Node;
+
+// A node reference and the mark that deletes the node holding
+// it at that level, as in the split-ordered list
+template<typename K, typename V>
+using NodePtr = utility::TaggedPtr<Node<K, V>>;
+
+template<typename K, typename V>
+bool is_marked(const NodePtr<K, V>& ptr) { return ptr.count() != 0; }
+
+// The tallest tower a node can have. Heights are drawn with
+// p = 1/2, so this covers billions of entries
+constexpr std::size_t kMaxHeight = 32;
+
+// The number of levels stored in the node itself. Half of
+// all nodes have one level and all but 1/16 have at most
+// four, so nearly every traversal step stays in the node's
+// own cache lines; taller towers keep their upper levels in
+// a separate array
+constexpr std::size_t kInlineLevels = 4;
+
+//==========================================================
+// A skiplist node: its tower of links, and an entry that's
+// constructed once and never modified. The head is a node
+// of the greatest height with no entry
+//
+// A node is retired by whichever of its inserter and its
+// eraser finishes with it last, which refs counts down. The
+// inserter may still be linking the upper levels of a node
+// that's been erased, so only once both are done is the
+// node certain to be unlinked from every level
+//==========================================================
+template<typename K, typename V>
+struct Node
+{
+    std::atomic<NodePtr<K, V>> links[kInlineLevels];
+    typename std::aligned_storage<sizeof(std::pair<const K, V>), alignof(std::pair<const K, V>)>::type storage;
+    std::atomic<NodePtr<K, V>>* pOverflow;
+    std::uint32_t height;
+    std::atomic<std::uint32_t> refs;
+    bool hasEntry;
+
+    ~Node() {
+        if (hasEntry)
+            entry().~pair();
+
+        delete[] pOverflow;
+    }
+
+    //======================================================
+    // Sets up a tower of \param{levels} empty links. The
+    // node must have come fresh from the pool
+    //======================================================
+    void build(std::size_t levels) {
+        height = static_cast<std::uint32_t>(levels);
+        refs.store(2, std::memory_order_relaxed);
+        pOverflow = levels > kInlineLevels ? new std::atomic<NodePtr<K, V>>[levels - kInlineLevels] : nullptr;
+
+        for (std::size_t level = 0; level < levels; ++level)
+            next(level).store(NodePtr<K, V>{ nullptr, 0 }, std::memory_order_relaxed);
+    }
+
+    template<typename ...Args>
+    void emplace(Args&& ...args) {
+        new (&storage) std::pair<const K, V>(std::forward<Args>(args)...);
+        hasEntry = true;
+    }
+
+    std::atomic<NodePtr<K, V>>& next(std::size_t level) {
+        return level < kInlineLevels ? links[level] : pOverflow[level - kInlineLevels];
+    }
+
+    std::pair<const K, V>& entry() { return *reinterpret_cast<std::pair<const K, V>*>(&storage); }
+    const K& key() { return entry().first; }
+    V& value() { return entry().second; }
+};
+
+}  // namespace sl
+}  // namespace map
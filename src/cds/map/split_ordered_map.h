@@ -0,0 +1,65 @@
+#pragma once
+
+#include "../map/map.h"
+#include "../../utility/reclamation.h"
+
+#include <memory>
+#include <cstddef>
+#include <functional>
+
+namespace map {
+
+namespace direct {
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+         typename Reclaimer = utility::reclaim::HazardPointers>
+class SplitOrderedMap;
+}
+
+//==========================================================
+// Represents the lock-free hash map of Shalev and Shavit.
+// Every entry lives in one Harris-Michael lock-free list,
+// sorted by the bit reversed hash of its key, and the
+// buckets are shortcuts into that list. Doubling the number
+// of buckets never moves an entry: each new bucket splits an
+// old one in two, and is linked in lazily by the first
+// operation that uses it. Removed nodes are freed through
+// the Reclaimer policy, see utility/reclamation.h. This is
+// the polymorphic adapter over map::direct::SplitOrderedMap
+//==========================================================
+template<typename K, typename V, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>,
+         typename Reclaimer = utility::reclaim::HazardPointers>
+class SplitOrderedMap : public map::MapBase<K, V> {
+public:
+    using reclaimer_type = Reclaimer;
+
+    static constexpr std::size_t kDefaultBuckets = 16;
+
+    explicit SplitOrderedMap(std::size_t buckets = kDefaultBuckets);
+    ~SplitOrderedMap();
+
+    // Move operations
+    SplitOrderedMap(SplitOrderedMap&& other);
+    SplitOrderedMap& operator=(SplitOrderedMap&& other);
+
+    // Prevent copying
+    SplitOrderedMap(const SplitOrderedMap& other) = delete;
+    SplitOrderedMap& operator=(const SplitOrderedMap& other) = delete;
+
+    // inherited from map::MapBase
+    using map::MapBase<K, V>::insert;
+    using map::MapBase<K, V>::upsert;
+    virtual bool insert(const K& key, V&& value) override;
+    virtual bool upsert(const K& key, V&& value) override;
+    virtual bool find(const K& key, V& out) const override;
+    virtual bool erase(const K& key) override;
+    virtual std::size_t size() const override;
+
+    std::size_t bucket_count() const;
+
+private:
+    using Impl = map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>;
+    std::unique_ptr<Impl> m_pImpl;
+};
+}  // namespace map
+
+#include "../map/split_ordered_map_impl.h"
@@ -0,0 +1,643 @@
+#pragma once
+
+#include "../map/split_ordered_map.h"
+#include "../map/split_ordered_node.h"
+#include "../../utility/memory.h"
+#include "../../utility/node_pool.h"
+#include "../../utility/instrumentation.h"
+#include "../../utility/reclamation.h"
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+//==========================================================
+// Represents the split-ordered hash map, with every
+// operation dispatched statically
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+class map::direct::SplitOrderedMap {
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using reclaimer_type = Reclaimer;
+
+    static constexpr std::size_t kDefaultBuckets = map::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::kDefaultBuckets;
+
+    // The average number of entries per bucket above which the
+    // number of buckets doubles
+    static constexpr std::size_t kMaxLoad = 2;
+
+    explicit SplitOrderedMap(std::size_t buckets = kDefaultBuckets);
+    ~SplitOrderedMap();
+
+    // Prevent copying
+    SplitOrderedMap(const SplitOrderedMap& other) = delete;
+    SplitOrderedMap& operator=(const SplitOrderedMap& other) = delete;
+
+    bool insert(const K& key, V&& value);
+    bool insert(const K& key, const V& value) { return insert(key, V(value)); }
+    bool upsert(const K& key, V&& value);
+    bool upsert(const K& key, const V& value) { return upsert(key, V(value)); }
+    bool find(const K& key, V& out) const;
+    bool erase(const K& key);
+
+    std::size_t size() const;
+    bool empty() const;
+    std::size_t bucket_count() const;
+
+private:
+    using Node = map::so::Node<K, V>;
+    using NodePtr = map::so::NodePtr<K, V>;
+    using NodePool = utility::NodePool<Node>;
+    using Bucket = std::atomic<Node*>;
+    using Guard = typename Reclaimer::Guard;
+
+    // Segment 0 holds bucket 0, and segment s holds buckets
+    // [2^(s-1), 2^s), so the buckets never move as they double
+    static constexpr std::size_t kSegmentCount = 64;
+
+    //======================================================
+    // Where a search stopped: the link that points at the
+    // current node, the current node, and its successor.
+    // The search leaves all three protected by the guard
+    //======================================================
+    struct Window {
+        std::atomic<NodePtr>* pPrev;
+        NodePtr curr;
+        NodePtr next;
+    };
+
+    static std::uint64_t reverse(std::uint64_t bits);
+    static std::size_t segment_of(std::size_t bucket);
+
+    std::uint64_t hash(const K& key) const;
+    Node* make_node(std::uint64_t soKey, const K& key, V&& value) const;
+
+    Bucket& bucket_slot(std::size_t bucket) const;
+    Node* bucket_head(std::size_t bucket) const;
+    Node* initialize_bucket(std::size_t bucket) const;
+
+    bool search(Node* pHead, std::uint64_t soKey, const K* pKey, Guard& guard, Window& window) const;
+    void unlink(Node* pHead, const K& key, std::uint64_t soKey, Guard& guard, Window& window);
+    void grow(std::size_t count);
+
+    Hash m_Hash;
+    KeyEqual m_Equal;
+
+    mutable std::atomic<Bucket*> m_Segments[kSegmentCount];
+    std::atomic<std::size_t> m_BucketCount;
+    std::atomic<std::size_t> m_Count{ 0 };
+};
+
+//==========================================================
+// Direct Split-Ordered Map definitions
+//==========================================================
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+constexpr std::size_t map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::kDefaultBuckets;
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+constexpr std::size_t map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::kMaxLoad;
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+constexpr std::size_t map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::kSegmentCount;
+
+//==========================================================
+// The constructor, which links in the dummy node of bucket 0.
+// Every other bucket is initialized on first use
+//
+// \param buckets   - The initial number of buckets, rounded
+//                    up to a power of two
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::SplitOrderedMap(std::size_t buckets) {
+    std::size_t count = 1;
+    while (count < buckets)
+        count *= 2;
+
+    m_BucketCount.store(count, std::memory_order_relaxed);
+
+    for (auto& segment : m_Segments)
+        segment.store(nullptr, std::memory_order_relaxed);
+
+    // Bucket 0's dummy has the least split-order key, so it
+    // heads the whole list
+    bucket_slot(0).store(NodePool::create(), std::memory_order_release);
+}
+
+//==========================================================
+// The destructor, which frees every node and bucket
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::~SplitOrderedMap() {
+    // Removed nodes have already been unlinked, so everything
+    // reachable from bucket 0 still belongs to the map
+    auto pIter = bucket_slot(0).load(std::memory_order_acquire);
+    while (pIter != nullptr) {
+        auto pNode = pIter;
+        pIter = pIter->next.load(std::memory_order_acquire).get();
+
+        NodePool::destroy(pNode);
+    }
+
+    for (auto& segment : m_Segments)
+        delete[] segment.load(std::memory_order_acquire);
+}
+
+//==========================================================
+// Reverses the order of the bits in \param{bits}
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+std::uint64_t map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::reverse(std::uint64_t bits) {
+    bits = ((bits >> 1) & 0x5555555555555555ull) | ((bits & 0x5555555555555555ull) << 1);
+    bits = ((bits >> 2) & 0x3333333333333333ull) | ((bits & 0x3333333333333333ull) << 2);
+    bits = ((bits >> 4) & 0x0F0F0F0F0F0F0F0Full) | ((bits & 0x0F0F0F0F0F0F0F0Full) << 4);
+    bits = ((bits >> 8) & 0x00FF00FF00FF00FFull) | ((bits & 0x00FF00FF00FF00FFull) << 8);
+    bits = ((bits >> 16) & 0x0000FFFF0000FFFFull) | ((bits & 0x0000FFFF0000FFFFull) << 16);
+    return (bits >> 32) | (bits << 32);
+}
+
+//==========================================================
+// Returns the segment that holds \param{bucket}, which is
+// the number of significant bits in its index
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+std::size_t map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::segment_of(std::size_t bucket) {
+#if defined(__GNUC__)
+    return bucket == 0 ? 0 : 64 - static_cast<std::size_t>(__builtin_clzll(bucket));
+#else
+    std::size_t segment = 0;
+    for (; bucket != 0; bucket >>= 1)
+        ++segment;
+
+    return segment;
+#endif
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+std::uint64_t map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::hash(const K& key) const {
+    return static_cast<std::uint64_t>(m_Hash(key));
+}
+
+//==========================================================
+// Allocates a node holding the entry. The split-order key is
+// set last, so that a node whose entry failed to construct
+// is still destroyed as a dummy
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+typename map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::Node*
+map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::make_node(std::uint64_t soKey, const K& key, V&& value) const {
+    auto pNode = NodePool::create();
+    try {
+        pNode->emplace(key, std::move(value));
+    }
+    catch (...) {
+        NodePool::destroy(pNode);
+        throw;
+    }
+
+    pNode->soKey = soKey;
+    return pNode;
+}
+
+//==========================================================
+// Returns the slot of \param{bucket}, allocating its segment
+// if no thread has yet. Racing allocations are resolved by a
+// CAS, and the losers free theirs
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+typename map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::Bucket&
+map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::bucket_slot(std::size_t bucket) const {
+    auto segment = segment_of(bucket);
+    auto first = segment == 0 ? std::size_t{ 0 } : std::size_t{ 1 } << (segment - 1);
+
+    auto pSegment = m_Segments[segment].load(std::memory_order_acquire);
+    if (pSegment == nullptr) {
+        auto length = segment == 0 ? std::size_t{ 1 } : first;
+        auto pFresh = new Bucket[length];
+        for (std::size_t i = 0; i < length; ++i)
+            pFresh[i].store(nullptr, std::memory_order_relaxed);
+
+        if (m_Segments[segment].compare_exchange_strong(pSegment, pFresh, std::memory_order_acq_rel))
+            pSegment = pFresh;
+        else
+            delete[] pFresh;
+    }
+
+    return pSegment[bucket - first];
+}
+
+//==========================================================
+// Returns the dummy node that heads \param{bucket}
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+typename map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::Node*
+map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::bucket_head(std::size_t bucket) const {
+    auto pHead = bucket_slot(bucket).load(std::memory_order_acquire);
+    if (pHead == nullptr)
+        pHead = initialize_bucket(bucket);
+
+    return pHead;
+}
+
+//==========================================================
+// Links in the dummy node of \param{bucket}, starting from
+// its parent bucket, the one it splits. The parent is the
+// bucket index without its top bit, and it's initialized
+// first if need be. If another thread links the dummy in
+// first, its dummy is the one that's used
+//
+// \return      - The bucket's dummy node
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+typename map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::Node*
+map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::initialize_bucket(std::size_t bucket) const {
+    auto parent = bucket - (std::size_t{ 1 } << (segment_of(bucket) - 1));
+    auto pParent = bucket_head(parent);
+
+    auto pDummy = NodePool::create();
+    pDummy->soKey = reverse(bucket);
+
+    {
+        // Dummy nodes are never removed, so the dummy stays valid
+        // after the guard is released
+        Guard guard;
+        Window window;
+        while (true) {
+            if (search(pParent, pDummy->soKey, nullptr, guard, window)) {
+                NodePool::destroy(pDummy);
+                pDummy = window.curr.get();
+                break;
+            }
+
+            pDummy->next.store(NodePtr{ window.curr.get(), 0 }, std::memory_order_relaxed);
+
+            auto expected = NodePtr{ window.curr.get(), 0 };
+            if (utility::instrumentation::cas(window.pPrev->compare_exchange_strong(expected, NodePtr{ pDummy, 0 })))
+                break;
+        }
+    }
+
+    bucket_slot(bucket).store(pDummy, std::memory_order_release);
+    return pDummy;
+}
+
+//==========================================================
+// Searches the list from \param{pHead} for the node with the
+// split-order key, and if \param{pKey} is set, the key. The
+// search unlinks any marked node it passes, and starts over
+// whenever the node it's on is unlinked under it
+//
+// \param pHead     - The dummy node to start from
+// \param soKey     - The split-order key to search for
+// \param pKey      - The key to search for, or null for the
+//                    dummy node with the split-order key
+// \param guard     - The guard that protects the window
+// \param window    - Assigned where the search stopped
+//
+// \return          - Whether the node was found, as
+//                    window.curr
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+bool map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::search(Node* pHead, std::uint64_t soKey, const K* pKey,
+                                                                         Guard& guard, Window& window) const {
+    utility::instrumentation::RetryLoop retries;
+
+    while (true) {
+        // The hazard slots rotate as the search moves along,
+        // so none of the three nodes is ever left unprotected
+        std::size_t prevSlot = 2;
+        std::size_t currSlot = 0;
+        std::size_t nextSlot = 1;
+
+        auto pPrev = &pHead->next;
+        auto curr = guard.protect(currSlot, *pPrev);
+
+        while (true) {
+            if (curr.get() == nullptr) {
+                window = Window{ pPrev, curr, NodePtr{ nullptr, 0 } };
+                return false;
+            }
+
+            auto next = guard.protect(nextSlot, curr.get()->next);
+
+            // If the current node is no longer linked in unmarked, the
+            // successor may already have been freed
+            if (pPrev->load(std::memory_order_acquire) != NodePtr{ curr.get(), 0 })
+                break;
+
+            if (map::so::is_marked(next)) {
+                // The current node is deleted, so unlink it. Only the
+                // thread whose CAS succeeds retires it
+                auto expected = NodePtr{ curr.get(), 0 };
+                if (!utility::instrumentation::cas(pPrev->compare_exchange_strong(expected, NodePtr{ next.get(), 0 })))
+                    break;
+
+                Reclaimer::retire(curr.get());
+
+                curr = NodePtr{ next.get(), 0 };
+                std::swap(currSlot, nextSlot);
+                continue;
+            }
+
+            auto pNode = curr.get();
+            if (pNode->soKey > soKey) {
+                window = Window{ pPrev, curr, next };
+                return false;
+            }
+
+            if (pNode->soKey == soKey && (pKey == nullptr || m_Equal(pNode->key(), *pKey))) {
+                window = Window{ pPrev, curr, next };
+                return true;
+            }
+
+            pPrev = &pNode->next;
+            curr = next;
+
+            auto freed = prevSlot;
+            prevSlot = currSlot;
+            currSlot = nextSlot;
+            nextSlot = freed;
+        }
+
+        retries.failed();
+    }
+}
+
+//==========================================================
+// Unlinks window.curr, which the caller has just marked. If
+// another thread changed the link first, a search unlinks it
+// instead, so that a marked node is never left behind for
+// long
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+void map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::unlink(Node* pHead, const K& key, std::uint64_t soKey,
+                                                                         Guard& guard, Window& window) {
+    auto pNode = window.curr.get();
+    auto pSuccessor = pNode->next.load(std::memory_order_acquire).get();
+
+    auto expected = NodePtr{ pNode, 0 };
+    if (utility::instrumentation::cas(window.pPrev->compare_exchange_strong(expected, NodePtr{ pSuccessor, 0 })))
+        Reclaimer::retire(pNode);
+    else
+        search(pHead, soKey, &key, guard, window);
+}
+
+//==========================================================
+// Doubles the number of buckets if the map has outgrown
+// them. The new buckets are initialized as they're used
+//
+// \param count   - The number of entries after an insertion
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+void map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::grow(std::size_t count) {
+    auto buckets = m_BucketCount.load(std::memory_order_relaxed);
+    if (count > buckets * kMaxLoad && buckets < (std::size_t{ 1 } << (kSegmentCount - 2)))
+        m_BucketCount.compare_exchange_strong(buckets, buckets * 2, std::memory_order_relaxed);
+}
+
+//==========================================================
+// Inserts the value under \param{key}, unless the key is
+// already present. The node is only allocated once the key
+// is known to be absent
+//
+// \param key     - The key to insert
+// \param value   - The value to move in
+//
+// \return        - False if the key was present
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+bool map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::insert(const K& key, V&& value) {
+    auto keyHash = hash(key);
+    auto soKey = reverse(keyHash | (std::uint64_t{ 1 } << 63));
+
+    // Initialize the bucket before taking the guard, since the
+    // initialization takes one of its own
+    auto pHead = bucket_head(keyHash & (m_BucketCount.load(std::memory_order_acquire) - 1));
+
+    Node* pNode = nullptr;
+    {
+        Guard guard;
+        Window window;
+        while (true) {
+            if (search(pHead, soKey, &key, guard, window)) {
+                if (pNode != nullptr)
+                    NodePool::destroy(pNode);
+
+                return false;
+            }
+
+            if (pNode == nullptr)
+                pNode = make_node(soKey, key, std::move(value));
+
+            pNode->next.store(NodePtr{ window.curr.get(), 0 }, std::memory_order_relaxed);
+
+            auto expected = NodePtr{ window.curr.get(), 0 };
+            if (utility::instrumentation::cas(window.pPrev->compare_exchange_strong(expected, NodePtr{ pNode, 0 })))
+                break;
+        }
+    }
+
+    grow(m_Count.fetch_add(1, std::memory_order_relaxed) + 1);
+    return true;
+}
+
+//==========================================================
+// Inserts the value under \param{key}, or replaces the node
+// that holds the key. The replacement marks the old node
+// with the new one as its successor, so the old entry's
+// removal and the new one's insertion are a single CAS, and
+// no reader ever finds the key missing
+//
+// \param key     - The key to insert or assign
+// \param value   - The value to move in
+//
+// \return        - True if the key was absent
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+bool map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::upsert(const K& key, V&& value) {
+    auto keyHash = hash(key);
+    auto soKey = reverse(keyHash | (std::uint64_t{ 1 } << 63));
+    auto pHead = bucket_head(keyHash & (m_BucketCount.load(std::memory_order_acquire) - 1));
+    auto pNode = make_node(soKey, key, std::move(value));
+
+    {
+        Guard guard;
+        Window window;
+        while (true) {
+            if (!search(pHead, soKey, &key, guard, window)) {
+                pNode->next.store(NodePtr{ window.curr.get(), 0 }, std::memory_order_relaxed);
+
+                auto expected = NodePtr{ window.curr.get(), 0 };
+                if (utility::instrumentation::cas(window.pPrev->compare_exchange_strong(expected, NodePtr{ pNode, 0 })))
+                    break;
+
+                continue;
+            }
+
+            pNode->next.store(NodePtr{ window.next.get(), 0 }, std::memory_order_relaxed);
+
+            auto expected = NodePtr{ window.next.get(), 0 };
+            if (utility::instrumentation::cas(window.curr.get()->next.compare_exchange_strong(expected, NodePtr{ pNode, 1 }))) {
+                unlink(pHead, key, soKey, guard, window);
+                return false;
+            }
+        }
+    }
+
+    grow(m_Count.fetch_add(1, std::memory_order_relaxed) + 1);
+    return true;
+}
+
+//==========================================================
+// Copies the value under \param{key} into \param{out}
+//
+// \return      - False if the key is absent
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+bool map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::find(const K& key, V& out) const {
+    auto keyHash = hash(key);
+    auto soKey = reverse(keyHash | (std::uint64_t{ 1 } << 63));
+    auto pHead = bucket_head(keyHash & (m_BucketCount.load(std::memory_order_acquire) - 1));
+
+    Guard guard;
+    Window window;
+    if (!search(pHead, soKey, &key, guard, window))
+        return false;
+
+    // The guard keeps the node alive while we copy its value
+    out = window.curr.get()->value();
+    return true;
+}
+
+//==========================================================
+// Removes \param{key}. Marking the node's link to its
+// successor deletes it; unlinking it is then just cleanup
+//
+// \return      - False if the key was absent
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+bool map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::erase(const K& key) {
+    auto keyHash = hash(key);
+    auto soKey = reverse(keyHash | (std::uint64_t{ 1 } << 63));
+    auto pHead = bucket_head(keyHash & (m_BucketCount.load(std::memory_order_acquire) - 1));
+
+    {
+        Guard guard;
+        Window window;
+        while (true) {
+            if (!search(pHead, soKey, &key, guard, window))
+                return false;
+
+            auto expected = NodePtr{ window.next.get(), 0 };
+            if (utility::instrumentation::cas(window.curr.get()->next.compare_exchange_strong(expected, NodePtr{ window.next.get(), 1 }))) {
+                unlink(pHead, key, soKey, guard, window);
+                break;
+            }
+        }
+    }
+
+    m_Count.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+}
+
+//==========================================================
+// Returns the number of entries. Concurrent insertions and
+// removals update it after they take effect, so it's a hint
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+std::size_t map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::size() const {
+    return m_Count.load(std::memory_order_relaxed);
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+bool map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::empty() const {
+    return size() == 0;
+}
+
+//==========================================================
+// Returns the number of buckets, which only ever doubles
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+std::size_t map::direct::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::bucket_count() const {
+    return m_BucketCount.load(std::memory_order_relaxed);
+}
+
+//==========================================================
+// Split-Ordered Map class definitions
+//==========================================================
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+constexpr std::size_t map::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::kDefaultBuckets;
+
+//==========================================================
+// Constructs a map with \param{buckets} buckets, rounded up
+// to a power of two
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+map::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::SplitOrderedMap(std::size_t buckets)
+    : m_pImpl(utility::make_unique<Impl>(buckets)) {}
+
+//==========================================================
+// Destructs the SplitOrderedMap, freeing all allocated memory
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+map::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::~SplitOrderedMap() {
+    // This automatically calls the dstor of Impl
+}
+
+//==========================================================
+// Defines the move constructor
+//
+// \param other     The other map to move into this one
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+map::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::SplitOrderedMap(SplitOrderedMap && other)
+    : m_pImpl{ std::move(other.m_pImpl) }
+{}
+
+//==========================================================
+// Defines the move assignment operator
+//
+// \param other     The other map to move into this one
+//==========================================================
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+map::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>& map::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::operator=(SplitOrderedMap && other) {
+    if (this != &other)
+        m_pImpl = std::move(other.m_pImpl);
+
+    return *this;
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+bool map::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::insert(const K& key, V&& value) {
+    return m_pImpl->insert(key, std::move(value));
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+bool map::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::upsert(const K& key, V&& value) {
+    return m_pImpl->upsert(key, std::move(value));
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+bool map::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::find(const K& key, V& out) const {
+    return m_pImpl->find(key, out);
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+bool map::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::erase(const K& key) {
+    return m_pImpl->erase(key);
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+std::size_t map::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::size() const {
+    return m_pImpl->size();
+}
+
+template<typename K, typename V, typename Hash, typename KeyEqual, typename Reclaimer>
+std::size_t map::SplitOrderedMap<K, V, Hash, KeyEqual, Reclaimer>::bucket_count() const {
+    return m_pImpl->bucket_count();
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "../../utility/tagged_ptr.h"
+
+#include <new>
+#include <atomic>
+#include <utility>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace map { namespace so {
+template<typename K, typename V>
+struct Node;
+
+// A node reference and the mark that logically deletes the
+// node holding it, see utility/tagged_ptr.h. The mark lives
+// in the counter, which is zero or one: the list has no ABA
+// to guard against, since its reclaimer keeps a node that a
+// thread still references from being reused
+template<typename K, typename V>
+using NodePtr = utility::TaggedPtr<Node<K, V>>;
+
+template<typename K, typename V>
+bool is_marked(const NodePtr<K, V>& ptr) { return ptr.count() != 0; }
+
+//==========================================================
+// A node of the split-ordered list. Its split-order key is
+// the bit reversed hash of its key, so that every bucket's
+// nodes are contiguous however many buckets there are.
+// Bucket heads are dummy nodes with even split-order keys
+// and no key or value; the nodes holding entries have odd
+// ones. The entry is constructed once and never modified,
+// so readers never race with writers over it
+//==========================================================
+template<typename K, typename V>
+struct Node
+{
+    std::uint64_t soKey;
+    std::atomic<NodePtr<K, V>> next;
+    typename std::aligned_storage<sizeof(std::pair<const K, V>), alignof(std::pair<const K, V>)>::type storage;
+
+    ~Node() {
+        if (!is_dummy())
+            entry().~pair();
+    }
+
+    template<typename ...Args>
+    void emplace(Args&& ...args) {
+        new (&storage) std::pair<const K, V>(std::forward<Args>(args)...);
+    }
+
+    bool is_dummy() const { return (soKey & 1) == 0; }
+
+    std::pair<const K, V>& entry() { return *reinterpret_cast<std::pair<const K, V>*>(&storage); }
+    const K& key() { return entry().first; }
+    V& value() { return entry().second; }
+};
+
+}  // namespace so
+}  // namespace map
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <memory>
+#include <cstddef>
+#include <functional>
+
+namespace priority_queue {
+
+namespace direct {
+template<typename T, typename Compare = std::less<T>>
+class MultiQueue;
+}
+
+//==========================================================
+// Represents the MultiQueue of Rihani, Sanders and
+// Dementiev: a relaxed concurrent priority queue made of
+// c * P binary heaps, each behind its own lock, for P
+// threads and a relaxation factor c. A push goes to a
+// random heap, and a pop takes the better of the tops of
+// two random heaps, so threads rarely meet on a lock.
+//
+// The price is ordering: a pop returns a value near the
+// front rather than the front itself. The expected rank of
+// the popped value grows linearly with c * P, so a smaller
+// factor orders more strictly and a larger one contends
+// less. Values are ordered by Compare, and pops return the
+// least, so the default pops the smallest value first
+//==========================================================
+template<typename T, typename Compare = std::less<T>>
+class MultiQueue {
+public:
+    using value_type = T;
+    using compare_type = Compare;
+
+    static constexpr std::size_t kDefaultFactor = 2;
+
+    explicit MultiQueue(std::size_t factor = kDefaultFactor, std::size_t threads = 0);
+    ~MultiQueue();
+
+    // Move operations
+    MultiQueue(MultiQueue&& other);
+    MultiQueue& operator=(MultiQueue&& other);
+
+    // Prevent copying
+    MultiQueue(const MultiQueue& other) = delete;
+    MultiQueue& operator=(const MultiQueue& other) = delete;
+
+    void push(T&& value);
+    void push(const T& value);
+    bool try_pop(T& out);
+
+    template<typename InputIt>
+    void push_bulk(InputIt first, InputIt last);
+
+    std::size_t heap_count() const;
+    std::size_t size() const;
+    bool empty() const;
+
+private:
+    using Impl = priority_queue::direct::MultiQueue<T, Compare>;
+    std::unique_ptr<Impl> m_pImpl;
+};
+}  // namespace priority_queue
+
+#include "../priority_queue/multi_queue_impl.h"
@@ -0,0 +1,389 @@
+#pragma once
+
+#include "../priority_queue/multi_queue.h"
+#include "../../utility/memory.h"
+#include "../../utility/backoff.h"
+#include "../../utility/cache_line.h"
+#include "../../utility/instrumentation.h"
+
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+
+//==========================================================
+// Represents the MultiQueue, with every operation dispatched
+// statically
+//==========================================================
+template<typename T, typename Compare>
+class priority_queue::direct::MultiQueue {
+public:
+    using value_type = T;
+    using compare_type = Compare;
+
+    static constexpr std::size_t kDefaultFactor = priority_queue::MultiQueue<T, Compare>::kDefaultFactor;
+
+    // The times a pop picks two new heaps because one it
+    // picked was locked, before it waits for the lock
+    static constexpr std::size_t kLockedRetries = 8;
+
+    explicit MultiQueue(std::size_t factor = kDefaultFactor, std::size_t threads = 0);
+    ~MultiQueue() = default;
+
+    // Prevent copying
+    MultiQueue(const MultiQueue& other) = delete;
+    MultiQueue& operator=(const MultiQueue& other) = delete;
+
+    void push(T&& value);
+    void push(const T& value);
+    bool try_pop(T& out);
+
+    template<typename InputIt>
+    void push_bulk(InputIt first, InputIt last);
+
+    std::size_t heap_count() const;
+    std::size_t size() const;
+    bool empty() const;
+
+private:
+    //======================================================
+    // One of the heaps, padded to its own cache lines. The
+    // size is written under the lock but read without it, so
+    // pops can skip heaps that look empty
+    //======================================================
+    struct Heap {
+        std::mutex mut;
+        std::vector<T> values;
+        std::atomic<std::size_t> size{ 0 };
+        char padding[utility::kCacheLineSize];
+    };
+
+    // Orders std's max-heap algorithms so the least value is
+    // on top
+    struct Reversed {
+        Compare compare;
+        bool operator()(const T& lhs, const T& rhs) const { return compare(rhs, lhs); }
+    };
+
+    Heap& random_heap();
+    bool pop_from(Heap& heap, T& out);
+
+    std::unique_ptr<Heap[]> m_pHeaps;
+    const std::size_t m_Count;
+    Reversed m_Reversed;
+};
+
+//==========================================================
+// Direct MultiQueue definitions
+//==========================================================
+
+template<typename T, typename Compare>
+constexpr std::size_t priority_queue::direct::MultiQueue<T, Compare>::kDefaultFactor;
+
+template<typename T, typename Compare>
+constexpr std::size_t priority_queue::direct::MultiQueue<T, Compare>::kLockedRetries;
+
+//==========================================================
+// Allocates factor * threads heaps, and at least two
+//
+// \param factor    - The relaxation factor, c
+// \param threads   - The number of threads that will use the
+//                    queue, P. Zero means one per hardware
+//                    thread
+//==========================================================
+template<typename T, typename Compare>
+priority_queue::direct::MultiQueue<T, Compare>::MultiQueue(std::size_t factor, std::size_t threads)
+    : m_Count(std::max<std::size_t>(2, std::max<std::size_t>(factor, 1) *
+              (threads != 0 ? threads : std::max(1u, std::thread::hardware_concurrency())))) {
+    m_pHeaps.reset(new Heap[m_Count]);
+}
+
+//==========================================================
+// Returns a heap chosen uniformly at random by the calling
+// thread's generator
+//==========================================================
+template<typename T, typename Compare>
+typename priority_queue::direct::MultiQueue<T, Compare>::Heap&
+priority_queue::direct::MultiQueue<T, Compare>::random_heap() {
+    return m_pHeaps[utility::backoff::next_random() % m_Count];
+}
+
+//==========================================================
+// Pushes the value onto a random heap. If that heap is
+// locked, another is tried, since any heap will do
+//
+// \param value   - The value to push
+//==========================================================
+template<typename T, typename Compare>
+void priority_queue::direct::MultiQueue<T, Compare>::push(T&& value) {
+    Heap* pHeap = &random_heap();
+    while (!pHeap->mut.try_lock()) {
+        utility::instrumentation::count(utility::instrumentation::Counter::LockContended);
+        pHeap = &random_heap();
+    }
+
+    std::lock_guard<std::mutex> lock{ pHeap->mut, std::adopt_lock };
+    utility::instrumentation::count(utility::instrumentation::Counter::LockAcquisitions);
+
+    pHeap->values.push_back(std::move(value));
+    std::push_heap(pHeap->values.begin(), pHeap->values.end(), m_Reversed);
+    pHeap->size.store(pHeap->values.size(), std::memory_order_relaxed);
+}
+
+template<typename T, typename Compare>
+void priority_queue::direct::MultiQueue<T, Compare>::push(const T& value) {
+    push(T(value));
+}
+
+//==========================================================
+// Pushes the values in [first, last) onto a single random
+// heap, under one acquisition of its lock
+//
+// \param first   - The first value to push
+// \param last    - One past the last value to push
+//==========================================================
+template<typename T, typename Compare>
+template<typename InputIt>
+void priority_queue::direct::MultiQueue<T, Compare>::push_bulk(InputIt first, InputIt last) {
+    if (first == last)
+        return;
+
+    Heap* pHeap = &random_heap();
+    while (!pHeap->mut.try_lock()) {
+        utility::instrumentation::count(utility::instrumentation::Counter::LockContended);
+        pHeap = &random_heap();
+    }
+
+    std::lock_guard<std::mutex> lock{ pHeap->mut, std::adopt_lock };
+    utility::instrumentation::count(utility::instrumentation::Counter::LockAcquisitions);
+
+    for (; first != last; ++first) {
+        pHeap->values.push_back(*first);
+        std::push_heap(pHeap->values.begin(), pHeap->values.end(), m_Reversed);
+    }
+
+    pHeap->size.store(pHeap->values.size(), std::memory_order_relaxed);
+}
+
+//==========================================================
+// Pops the top of \param{heap}, which the caller has locked
+//==========================================================
+template<typename T, typename Compare>
+bool priority_queue::direct::MultiQueue<T, Compare>::pop_from(Heap& heap, T& out) {
+    if (heap.values.empty())
+        return false;
+
+    std::pop_heap(heap.values.begin(), heap.values.end(), m_Reversed);
+    out = std::move(heap.values.back());
+    heap.values.pop_back();
+    heap.size.store(heap.values.size(), std::memory_order_relaxed);
+    return true;
+}
+
+//==========================================================
+// Pops the better of the tops of two random heaps. Both
+// heaps are locked while their tops are compared; a pop that
+// finds one locked picks two others, and only waits after
+// kLockedRetries tries. If both heaps look empty, it falls
+// back to the first heap that doesn't
+//
+// \param out   - Assigned the popped value
+//
+// \return      - False if every heap was empty
+//==========================================================
+template<typename T, typename Compare>
+bool priority_queue::direct::MultiQueue<T, Compare>::try_pop(T& out) {
+    for (std::size_t attempt = 0; ; ++attempt) {
+        auto& first = random_heap();
+        auto& second = random_heap();
+
+        if (&first == &second)
+            continue;
+
+        if (first.size.load(std::memory_order_relaxed) == 0 && second.size.load(std::memory_order_relaxed) == 0)
+            break;
+
+        std::unique_lock<std::mutex> firstLock{ first.mut, std::defer_lock };
+        std::unique_lock<std::mutex> secondLock{ second.mut, std::defer_lock };
+
+        if (attempt < kLockedRetries) {
+            if (std::try_lock(firstLock, secondLock) != -1) {
+                utility::instrumentation::count(utility::instrumentation::Counter::LockContended);
+                continue;
+            }
+        }
+        else {
+            std::lock(firstLock, secondLock);
+        }
+
+        utility::instrumentation::count(utility::instrumentation::Counter::LockAcquisitions, 2);
+
+        if (first.values.empty() && second.values.empty())
+            break;
+
+        auto pBetter = &first;
+        if (first.values.empty() || (!second.values.empty() && m_Reversed.compare(second.values.front(), first.values.front())))
+            pBetter = &second;
+
+        return pop_from(*pBetter, out);
+    }
+
+    // Both picks were empty, so look for any heap that isn't
+    for (std::size_t i = 0; i < m_Count; ++i) {
+        auto& heap = m_pHeaps[i];
+        if (heap.size.load(std::memory_order_relaxed) == 0)
+            continue;
+
+        std::lock_guard<std::mutex> lock{ heap.mut };
+        if (pop_from(heap, out))
+            return true;
+    }
+
+    return false;
+}
+
+//==========================================================
+// Returns the number of heaps, c * P
+//==========================================================
+template<typename T, typename Compare>
+std::size_t priority_queue::direct::MultiQueue<T, Compare>::heap_count() const {
+    return m_Count;
+}
+
+//==========================================================
+// Returns the number of values in the queue. The heaps are
+// read one at a time without their locks, so it's a hint
+//==========================================================
+template<typename T, typename Compare>
+std::size_t priority_queue::direct::MultiQueue<T, Compare>::size() const {
+    std::size_t total = 0;
+    for (std::size_t i = 0; i < m_Count; ++i)
+        total += m_pHeaps[i].size.load(std::memory_order_relaxed);
+
+    return total;
+}
+
+//==========================================================
+// Returns whether the queue looks empty, see size()
+//==========================================================
+template<typename T, typename Compare>
+bool priority_queue::direct::MultiQueue<T, Compare>::empty() const {
+    return size() == 0;
+}
+
+//==========================================================
+// MultiQueue class definitions
+//==========================================================
+
+template<typename T, typename Compare>
+constexpr std::size_t priority_queue::MultiQueue<T, Compare>::kDefaultFactor;
+
+//==========================================================
+// Constructs a queue of factor * threads heaps
+//
+// \param factor    - The relaxation factor; larger factors
+//                    contend less and order less strictly
+// \param threads   - The number of threads that will use the
+//                    queue. Zero means one per hardware thread
+//==========================================================
+template<typename T, typename Compare>
+priority_queue::MultiQueue<T, Compare>::MultiQueue(std::size_t factor, std::size_t threads)
+    : m_pImpl(utility::make_unique<Impl>(factor, threads)) {}
+
+//==========================================================
+// Destructs the MultiQueue, freeing all allocated memory
+//==========================================================
+template<typename T, typename Compare>
+priority_queue::MultiQueue<T, Compare>::~MultiQueue() {
+    // This automatically calls the dstor of Impl
+}
+
+//==========================================================
+// Defines the move constructor
+//
+// \param other     The other queue to move into this one
+//==========================================================
+template<typename T, typename Compare>
+priority_queue::MultiQueue<T, Compare>::MultiQueue(MultiQueue && other)
+    : m_pImpl{ std::move(other.m_pImpl) }
+{}
+
+//==========================================================
+// Defines the move assignment operator
+//
+// \param other     The other queue to move into this one
+//==========================================================
+template<typename T, typename Compare>
+priority_queue::MultiQueue<T, Compare>& priority_queue::MultiQueue<T, Compare>::operator=(MultiQueue && other) {
+    if (this != &other)
+        m_pImpl = std::move(other.m_pImpl);
+
+    return *this;
+}
+
+//==========================================================
+// Pushes the value onto a random heap
+//
+// \param value   - The value to push
+//==========================================================
+template<typename T, typename Compare>
+void priority_queue::MultiQueue<T, Compare>::push(T&& value) {
+    m_pImpl->push(std::move(value));
+}
+
+template<typename T, typename Compare>
+void priority_queue::MultiQueue<T, Compare>::push(const T& value) {
+    m_pImpl->push(value);
+}
+
+//==========================================================
+// Pushes the values in [first, last) onto one random heap
+//
+// \param first   - The first value to push
+// \param last    - One past the last value to push
+//==========================================================
+template<typename T, typename Compare>
+template<typename InputIt>
+void priority_queue::MultiQueue<T, Compare>::push_bulk(InputIt first, InputIt last) {
+    m_pImpl->push_bulk(first, last);
+}
+
+//==========================================================
+// Pops a value near the front of the queue
+//
+// \param out   - Assigned the popped value
+//
+// \return      - False if the queue was empty
+//==========================================================
+template<typename T, typename Compare>
+bool priority_queue::MultiQueue<T, Compare>::try_pop(T& out) {
+    return m_pImpl->try_pop(out);
+}
+
+//==========================================================
+// Returns the number of heaps
+//==========================================================
+template<typename T, typename Compare>
+std::size_t priority_queue::MultiQueue<T, Compare>::heap_count() const {
+    return m_pImpl->heap_count();
+}
+
+//==========================================================
+// Returns the number of values in the queue, as a hint
+//==========================================================
+template<typename T, typename Compare>
+std::size_t priority_queue::MultiQueue<T, Compare>::size() const {
+    return m_pImpl->size();
+}
+
+//==========================================================
+// Returns whether the queue looks empty
+//==========================================================
+template<typename T, typename Compare>
+bool priority_queue::MultiQueue<T, Compare>::empty() const {
+    return m_pImpl->empty();
+}
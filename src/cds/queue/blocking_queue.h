@@ -0,0 +1,69 @@
+#pragma once
+
+#include "../../utility/wait_strategy.h"
+
+#include <chrono>
+#include <cstddef>
+
+namespace queue {
+
+//==========================================================
+// Adds blocking dequeues to any of the queues, polymorphic
+// or direct. Producers notify the wait strategy after each
+// enqueue; consumers that find the queue empty wait on it,
+// according to the strategy, rather than returning false.
+//
+// Queue is the wrapped queue type, and Wait is one of the
+// strategies in utility::wait. The default, SpinPark, spins
+// briefly and then parks on a futex
+//==========================================================
+template<typename Queue, typename Wait = utility::wait::SpinPark>
+class BlockingQueue {
+public:
+    using value_type = typename Queue::value_type;
+    using T = value_type;
+
+    // Constructs the wrapped queue from \param{args}
+    template<typename ...Args>
+    explicit BlockingQueue(Args&& ...args);
+
+    // Prevent copying
+    BlockingQueue(const BlockingQueue& other) = delete;
+    BlockingQueue& operator=(const BlockingQueue& other) = delete;
+
+    void enqueue(T&& value);
+    void enqueue(const T& value);
+
+    template<typename ...Args>
+    void emplace(Args&& ...args);
+
+    bool try_enqueue(T&& value);
+    bool try_enqueue(const T& value);
+
+    template<typename InputIt>
+    void enqueue_bulk(InputIt first, InputIt last);
+
+    bool dequeue(T& out);
+
+    template<typename OutputIt>
+    std::size_t try_dequeue_bulk(OutputIt out, std::size_t max);
+
+    void wait_dequeue(T& out);
+
+    template<typename Rep, typename Period>
+    bool wait_dequeue_for(T& out, const std::chrono::duration<Rep, Period>& timeout);
+
+    template<typename Clock, typename Duration>
+    bool wait_dequeue_until(T& out, const std::chrono::time_point<Clock, Duration>& deadline);
+
+    // Enqueues through the wrapped queue would skip the notify,
+    // so it's only exposed for inspection
+    const Queue& underlying() const { return m_Queue; }
+
+private:
+    Queue m_Queue;
+    Wait m_Wait;
+};
+}  // namespace queue
+
+#include "../queue/blocking_queue_impl.h"
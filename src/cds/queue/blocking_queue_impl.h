@@ -0,0 +1,172 @@
+#pragma once
+
+#include "../queue/blocking_queue.h"
+
+#include <chrono>
+#include <utility>
+
+//==========================================================
+// Blocking Queue class definitions
+//==========================================================
+
+//==========================================================
+// Constructs the wrapped queue
+//
+// \param args    - The arguments to construct the queue with
+//==========================================================
+template<typename Queue, typename Wait>
+template<typename ...Args>
+queue::BlockingQueue<Queue, Wait>::BlockingQueue(Args&& ...args)
+    : m_Queue(std::forward<Args>(args)...) {}
+
+//==========================================================
+// This enqueues the specified value, and wakes a waiting
+// consumer
+//
+// \param value   - The value to move into the queue
+//==========================================================
+template<typename Queue, typename Wait>
+void queue::BlockingQueue<Queue, Wait>::enqueue(T&& value) {
+    m_Queue.enqueue(std::move(value));
+    m_Wait.notify_one();
+}
+
+//==========================================================
+// This enqueues a copy of the value, and wakes a waiting
+// consumer
+//
+// \param value   - The value to copy into the queue
+//==========================================================
+template<typename Queue, typename Wait>
+void queue::BlockingQueue<Queue, Wait>::enqueue(const T& value) {
+    m_Queue.enqueue(value);
+    m_Wait.notify_one();
+}
+
+//==========================================================
+// This enqueues a value constructed from \param{args}, and
+// wakes a waiting consumer
+//
+// \param args    - The arguments to construct the value with
+//==========================================================
+template<typename Queue, typename Wait>
+template<typename ...Args>
+void queue::BlockingQueue<Queue, Wait>::emplace(Args&& ...args) {
+    m_Queue.emplace(std::forward<Args>(args)...);
+    m_Wait.notify_one();
+}
+
+//==========================================================
+// This attempts to enqueue the value, waking a waiting
+// consumer if it was enqueued
+//
+// \param value   - The value to move into the queue
+//
+// \return        - False if the queue was full
+//==========================================================
+template<typename Queue, typename Wait>
+bool queue::BlockingQueue<Queue, Wait>::try_enqueue(T&& value) {
+    if (!m_Queue.try_enqueue(std::move(value)))
+        return false;
+
+    m_Wait.notify_one();
+    return true;
+}
+
+//==========================================================
+// This attempts to enqueue a copy of the value, waking a
+// waiting consumer if it was enqueued
+//
+// \param value   - The value to copy into the queue
+//
+// \return        - False if the queue was full
+//==========================================================
+template<typename Queue, typename Wait>
+bool queue::BlockingQueue<Queue, Wait>::try_enqueue(const T& value) {
+    if (!m_Queue.try_enqueue(value))
+        return false;
+
+    m_Wait.notify_one();
+    return true;
+}
+
+//==========================================================
+// This enqueues the values in [first, last), in order, and
+// wakes every waiting consumer
+//
+// \param first   - The first value to enqueue
+// \param last    - One past the last value to enqueue
+//==========================================================
+template<typename Queue, typename Wait>
+template<typename InputIt>
+void queue::BlockingQueue<Queue, Wait>::enqueue_bulk(InputIt first, InputIt last) {
+    m_Queue.enqueue_bulk(first, last);
+    m_Wait.notify_all();
+}
+
+//==========================================================
+// This attempts to dequeue a value without waiting
+//
+// \param out     - Assigned the dequeued value
+//
+// \return        - False if the queue was empty
+//==========================================================
+template<typename Queue, typename Wait>
+bool queue::BlockingQueue<Queue, Wait>::dequeue(T& out) {
+    return m_Queue.dequeue(out);
+}
+
+//==========================================================
+// This dequeues up to \param{max} values without waiting
+//
+// \param out     - Assigned the dequeued values
+// \param max     - The most values to dequeue
+//
+// \return        - The number of values that were dequeued
+//==========================================================
+template<typename Queue, typename Wait>
+template<typename OutputIt>
+std::size_t queue::BlockingQueue<Queue, Wait>::try_dequeue_bulk(OutputIt out, std::size_t max) {
+    return m_Queue.try_dequeue_bulk(out, max);
+}
+
+//==========================================================
+// This dequeues a value, waiting for one to be enqueued if
+// the queue is empty
+//
+// \param out     - Assigned the dequeued value
+//==========================================================
+template<typename Queue, typename Wait>
+void queue::BlockingQueue<Queue, Wait>::wait_dequeue(T& out) {
+    m_Wait.wait([&] { return m_Queue.dequeue(out); });
+}
+
+//==========================================================
+// This dequeues a value, waiting at most \param{timeout} for
+// one to be enqueued if the queue is empty
+//
+// \param out     - Assigned the dequeued value
+// \param timeout - The longest to wait
+//
+// \return        - False if the wait timed out
+//==========================================================
+template<typename Queue, typename Wait>
+template<typename Rep, typename Period>
+bool queue::BlockingQueue<Queue, Wait>::wait_dequeue_for(T& out, const std::chrono::duration<Rep, Period>& timeout) {
+    return wait_dequeue_until(out, std::chrono::steady_clock::now() + timeout);
+}
+
+//==========================================================
+// This dequeues a value, waiting until \param{deadline} for
+// one to be enqueued if the queue is empty
+//
+// \param out       - Assigned the dequeued value
+// \param deadline  - When to stop waiting
+//
+// \return          - False if the wait timed out
+//==========================================================
+template<typename Queue, typename Wait>
+template<typename Clock, typename Duration>
+bool queue::BlockingQueue<Queue, Wait>::wait_dequeue_until(T& out, const std::chrono::time_point<Clock, Duration>& deadline) {
+    return m_Wait.wait_until([&] { return m_Queue.dequeue(out); }, deadline);
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "../queue/queue.h"
+
+#include <memory>
+#include <cstddef>
+
+namespace queue {
+
+namespace direct {
+template<typename T>
+class BoundedQueue;
+}
+
+//==========================================================
+// Represents an implementation of Vyukov's bounded MPMC
+// queue. Values live in a fixed, power of two sized ring of
+// cells, and each cell's sequence number tells producers and
+// consumers whose turn it is to use it, so there's no per
+// value allocation and no double-width CAS
+//==========================================================
+template<typename T>
+class BoundedQueue : public queue::QueueBase<T> {
+public:
+    static constexpr std::size_t kDefaultCapacity = 1 << 16;
+
+    explicit BoundedQueue(std::size_t capacity = kDefaultCapacity);
+    ~BoundedQueue();
+
+    // Move operations
+    BoundedQueue(BoundedQueue&& other);
+    BoundedQueue& operator=(BoundedQueue&& other);
+
+    // Prevent copying
+    BoundedQueue(const BoundedQueue& other) = delete;
+    BoundedQueue& operator=(const BoundedQueue& other) = delete;
+
+    // inherited from queue::QueueBase
+    using queue::QueueBase<T>::enqueue;
+    using queue::QueueBase<T>::try_enqueue;
+    virtual void enqueue(T&& value) override;
+    virtual bool dequeue(T& out) override;
+    virtual bool try_enqueue(T&& value) override;
+
+    std::size_t capacity() const;
+
+private:
+    using Impl = queue::direct::BoundedQueue<T>;
+    std::unique_ptr<Impl> m_pImpl;
+};
+}  // namespace queue
+
+#include "../queue/bounded_queue_impl.h"
@@ -0,0 +1,314 @@
+#pragma once
+
+#include "../queue/bounded_queue.h"
+#include "../../utility/memory.h"
+#include "../../utility/cache_line.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cstddef>
+#include <cstdint>
+
+namespace queue { namespace detail {
+
+//==========================================================
+// Rounds the requested capacity up to a power of two, since
+// positions are mapped to cells with a mask
+//
+// \param capacity  - The requested capacity
+//
+// \return          - The capacity of the ring
+//==========================================================
+inline std::size_t ring_capacity(std::size_t capacity) {
+    std::size_t size = 2;
+    while (size < capacity)
+        size <<= 1;
+
+    return size;
+}
+
+}  // namespace detail
+}  // namespace queue
+
+//==========================================================
+// Represents Vyukov's bounded MPMC queue, with every
+// operation dispatched statically
+//==========================================================
+template<typename T>
+class queue::direct::BoundedQueue : public queue::direct::QueueOps<BoundedQueue<T>, T> {
+public:
+    static constexpr std::size_t kDefaultCapacity = queue::BoundedQueue<T>::kDefaultCapacity;
+
+    explicit BoundedQueue(std::size_t capacity = kDefaultCapacity);
+    ~BoundedQueue() = default;
+
+    // Prevent copying
+    BoundedQueue(const BoundedQueue& other) = delete;
+    BoundedQueue& operator=(const BoundedQueue& other) = delete;
+
+    using queue::direct::QueueOps<BoundedQueue<T>, T>::enqueue;
+    using queue::direct::QueueOps<BoundedQueue<T>, T>::try_enqueue;
+    void enqueue(T&& value);
+    bool try_enqueue(T&& value);
+    bool dequeue(T& out);
+
+    template<typename ...Args>
+    void emplace(Args&& ...args);
+
+    std::size_t capacity() const;
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> sequence;
+        T value;
+    };
+
+    const std::size_t m_Mask;
+    std::unique_ptr<Cell[]> m_pBuffer;
+
+    // Producers and consumers each get their own cache line
+    char m_Pad0[utility::kCacheLineSize];
+    std::atomic<std::size_t> m_EnqueuePos{ 0 };
+    char m_Pad1[utility::kCacheLineSize];
+    std::atomic<std::size_t> m_DequeuePos{ 0 };
+    char m_Pad2[utility::kCacheLineSize];
+};
+
+//==========================================================
+// Direct Bounded Queue definitions
+//==========================================================
+
+template<typename T>
+constexpr std::size_t queue::direct::BoundedQueue<T>::kDefaultCapacity;
+
+//==========================================================
+// Allocates the ring, and gives each cell the sequence number
+// of the first position that maps to it
+//
+// \param capacity  - The minimum number of values the queue
+//                    can hold
+//==========================================================
+template<typename T>
+queue::direct::BoundedQueue<T>::BoundedQueue(std::size_t capacity)
+    : m_Mask(queue::detail::ring_capacity(capacity) - 1),
+      m_pBuffer(new Cell[m_Mask + 1]) {
+    for (std::size_t i = 0; i <= m_Mask; ++i)
+        m_pBuffer[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+//==========================================================
+// This attempts to enqueue the specified value. A cell is
+// free for the producer at position pos once its sequence
+// number equals pos
+//
+// \param value   - The value to enqueue, which is only moved
+//                  from if there was room
+//
+// \return        - False if the queue is full
+//==========================================================
+template<typename T>
+bool queue::direct::BoundedQueue<T>::try_enqueue(T&& value) {
+    Cell* cell = nullptr;
+    auto pos = m_EnqueuePos.load(std::memory_order_relaxed);
+
+    while (true) {
+        cell = &m_pBuffer[pos & m_Mask];
+        auto seq = cell->sequence.load(std::memory_order_acquire);
+        auto dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+
+        if (dif == 0) {
+            // The cell is free, so try to claim its position
+            if (m_EnqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (dif < 0) {
+            // The cell still holds the value from a lap ago
+            return false;
+        }
+        else {
+            // Another producer claimed the position first
+            pos = m_EnqueuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    cell->value = std::move(value);
+
+    // Hand the cell to the consumer at this position
+    cell->sequence.store(pos + 1, std::memory_order_release);
+
+    return true;
+}
+
+//==========================================================
+// This enqueues the specified value, yielding while the
+// queue is full
+//
+// \param value   - The value to enqueue
+//==========================================================
+template<typename T>
+void queue::direct::BoundedQueue<T>::enqueue(T&& value) {
+    while (!try_enqueue(std::move(value)))
+        std::this_thread::yield();
+}
+
+//==========================================================
+// This enqueues a value constructed from \param{args},
+// yielding while the queue is full. The ring's cells
+// already hold a value, so it's moved into one
+//
+// \param args    - The arguments to construct the value with
+//==========================================================
+template<typename T>
+template<typename ...Args>
+void queue::direct::BoundedQueue<T>::emplace(Args&& ...args) {
+    enqueue(T(std::forward<Args>(args)...));
+}
+
+//==========================================================
+// Returns the number of values the queue can hold
+//==========================================================
+template<typename T>
+std::size_t queue::direct::BoundedQueue<T>::capacity() const {
+    return m_Mask + 1;
+}
+
+//==========================================================
+// This attempts to perform a dequeue operation, which puts
+// the front value into \param{out}, and returns true if the
+// operation was successful. A cell is full for the consumer
+// at position pos once its sequence number equals pos + 1
+//
+// \param out   - An output variable that is assigned the
+//                value that was at the front of the queue
+//
+// \return      - False if the queue was empty
+//==========================================================
+template<typename T>
+bool queue::direct::BoundedQueue<T>::dequeue(T& out) {
+    Cell* cell = nullptr;
+    auto pos = m_DequeuePos.load(std::memory_order_relaxed);
+
+    while (true) {
+        cell = &m_pBuffer[pos & m_Mask];
+        auto seq = cell->sequence.load(std::memory_order_acquire);
+        auto dif = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos + 1);
+
+        if (dif == 0) {
+            // The cell is full, so try to claim its position
+            if (m_DequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                break;
+        }
+        else if (dif < 0) {
+            // The producer for this position hasn't arrived yet
+            return false;
+        }
+        else {
+            // Another consumer claimed the position first
+            pos = m_DequeuePos.load(std::memory_order_relaxed);
+        }
+    }
+
+    out = std::move(cell->value);
+
+    // Hand the cell to the producer one lap ahead
+    cell->sequence.store(pos + m_Mask + 1, std::memory_order_release);
+
+    return true;
+}
+
+//==========================================================
+// Bounded Queue class definitions
+//==========================================================
+
+template<typename T>
+constexpr std::size_t queue::BoundedQueue<T>::kDefaultCapacity;
+
+//==========================================================
+// Constructs a queue that can hold at least \param{capacity}
+// values
+//
+// \param capacity  - The minimum capacity, which is rounded
+//                    up to a power of two
+//==========================================================
+template<typename T>
+queue::BoundedQueue<T>::BoundedQueue(std::size_t capacity)
+    : m_pImpl(utility::make_unique<Impl>(capacity)) {}
+
+//==========================================================
+// Destructs the BoundedQueue, freeing all allocated memory
+//==========================================================
+template<typename T>
+queue::BoundedQueue<T>::~BoundedQueue() {
+    // This automatically calls the dstor of Impl
+}
+
+//==========================================================
+// Defines the move constructor
+//
+// \param other     The other queue to move into this one
+//==========================================================
+template<typename T>
+queue::BoundedQueue<T>::BoundedQueue(BoundedQueue && other)
+    : m_pImpl{ std::move(other.m_pImpl) }
+{}
+
+//==========================================================
+// Defines the move assignment operator
+//
+// \param other     The other queue to move into this one
+//==========================================================
+template<typename T>
+queue::BoundedQueue<T>& queue::BoundedQueue<T>::operator=(BoundedQueue && other) {
+    if (this != &other)
+        m_pImpl = std::move(other.m_pImpl);
+
+    return *this;
+}
+
+//==========================================================
+// This enqueues the specified value, yielding while the
+// queue is full
+//
+// \param value   - The value to enqueue
+//==========================================================
+template<typename T>
+void queue::BoundedQueue<T>::enqueue(T&& value) {
+    m_pImpl->enqueue(std::move(value));
+}
+
+//==========================================================
+// This attempts to enqueue the specified value
+//
+// \param value   - The value to enqueue
+//
+// \return        - False if the queue is full
+//==========================================================
+template<typename T>
+bool queue::BoundedQueue<T>::try_enqueue(T&& value) {
+    return m_pImpl->try_enqueue(std::move(value));
+}
+
+//==========================================================
+// This attempts to perform a dequeue operation, which puts
+// the front value into \param{out}, and returns true if the
+// operation was successful. If the queue is empty, then it
+// returns false.
+//
+// \param out   - An output variable that is assigned the
+//                value that was at the front of the queue
+//
+// \return      - The success of the dequeue operation
+//==========================================================
+template<typename T>
+bool queue::BoundedQueue<T>::dequeue(T& out) {
+    return m_pImpl->dequeue(out);
+}
+
+//==========================================================
+// Returns the number of values the queue can hold
+//==========================================================
+template<typename T>
+std::size_t queue::BoundedQueue<T>::capacity() const {
+    return m_pImpl->capacity();
+}
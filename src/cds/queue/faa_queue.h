@@ -0,0 +1,56 @@
+#pragma once
+
+#include "../queue/queue.h"
+#include "../../utility/reclamation.h"
+
+#include <memory>
+
+namespace queue {
+
+namespace direct {
+template<typename T, typename Reclaimer = utility::reclaim::HazardPointers>
+class FaaQueue;
+}
+
+//==========================================================
+// This is an unbounded queue built from a linked list of
+// array segments, after the FAA array queue of Ramalhete and
+// Correia and the LCRQ of Morrison and Afek. Producers and
+// consumers claim slots in the current segment with fetch-
+// and-add on its indices, so contending threads spread over
+// different slots instead of retrying a CAS on one pointer.
+// Drained segments are freed through the Reclaimer policy,
+// see utility/reclamation.h. This is the polymorphic adapter
+// over queue::direct::FaaQueue
+//==========================================================
+template<typename T, typename Reclaimer = utility::reclaim::HazardPointers>
+class FaaQueue : public queue::QueueBase<T> {
+public:
+    using reclaimer_type = Reclaimer;
+
+    FaaQueue();
+    ~FaaQueue();
+
+    // Move operations
+    FaaQueue(FaaQueue&& other);
+    FaaQueue& operator=(FaaQueue&& other);
+
+    // Prevent copying
+    FaaQueue(const FaaQueue& other) = delete;
+    FaaQueue& operator=(const FaaQueue& other) = delete;
+
+    // inherited from queue::QueueBase
+    using queue::QueueBase<T>::enqueue;
+    virtual void enqueue(T&& value) override;
+    virtual bool dequeue(T& out) override;
+
+    template<typename ...Args>
+    void emplace(Args&& ...args);
+
+private:
+    using Impl = queue::direct::FaaQueue<T, Reclaimer>;
+    std::unique_ptr<Impl> m_pImpl;
+};
+}  // namespace queue
+
+#include "../queue/faa_queue_impl.h"
@@ -0,0 +1,363 @@
+#pragma once
+
+#include "../queue/faa_queue.h"
+#include "../../utility/memory.h"
+#include "../../utility/node_pool.h"
+#include "../../utility/cache_line.h"
+#include "../../utility/reclamation.h"
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+
+namespace queue { namespace faa {
+
+// The number of slots in each segment
+constexpr std::size_t kSegmentSize = 256;
+
+// The number of times an enqueue claims a slot in the tail
+// segment before it gives up on the segment, see enqueue()
+constexpr std::size_t kFastPathAttempts = 16;
+
+}  // namespace faa
+}  // namespace queue
+
+//==========================================================
+// Represents the fetch-and-add segment queue, with every
+// operation dispatched statically
+//==========================================================
+template<typename T, typename Reclaimer>
+class queue::direct::FaaQueue : public queue::direct::QueueOps<FaaQueue<T, Reclaimer>, T> {
+public:
+    using reclaimer_type = Reclaimer;
+
+    FaaQueue();
+    ~FaaQueue();
+
+    // Prevent copying
+    FaaQueue(const FaaQueue& other) = delete;
+    FaaQueue& operator=(const FaaQueue& other) = delete;
+
+    template<typename ...Args>
+    void emplace(Args&& ...args);
+    bool dequeue(T& out);
+
+private:
+    // A value in transit. Only the consumer that takes it out
+    // of its slot frees it, so it needs no reclamation
+    struct Item {
+        template<typename ...Args>
+        explicit Item(Args&& ...args)
+            : value(std::forward<Args>(args)...) {}
+
+        T value;
+    };
+
+    struct Segment;
+
+    // The reclamation policies protect references that expose
+    // the node through get()
+    struct SegmentPtr {
+        Segment* ptr;
+
+        Segment* get() const { return ptr; }
+
+        bool operator==(const SegmentPtr& other) const { return ptr == other.ptr; }
+        bool operator!=(const SegmentPtr& other) const { return ptr != other.ptr; }
+    };
+
+    struct Segment {
+        explicit Segment(Item* first);
+
+        std::atomic<std::size_t> dequeueIndex;
+        char pad0[utility::kCacheLineSize];
+        std::atomic<std::size_t> enqueueIndex;
+        char pad1[utility::kCacheLineSize];
+        std::atomic<SegmentPtr> next;
+        std::atomic<Item*> items[queue::faa::kSegmentSize];
+    };
+
+    using ItemPool = utility::NodePool<Item>;
+    using SegmentPool = utility::NodePool<Segment>;
+
+    // Marks a slot whose item was taken, or that a consumer
+    // claimed before its producer arrived. Items are at least
+    // pointer aligned, so this is never one
+    static Item* taken() { return reinterpret_cast<Item*>(std::uintptr_t{ 1 }); }
+
+    bool append(SegmentPtr tail, Item* item);
+
+    std::atomic<SegmentPtr> m_pHead;
+    char m_Pad0[utility::kCacheLineSize];
+    std::atomic<SegmentPtr> m_pTail;
+    char m_Pad1[utility::kCacheLineSize];
+};
+
+//==========================================================
+// Direct FAA Queue definitions
+//==========================================================
+
+//==========================================================
+// Constructs a segment, optionally holding a first item in
+// its first slot
+//
+// \param first   - The first item, or null
+//==========================================================
+template<typename T, typename Reclaimer>
+queue::direct::FaaQueue<T, Reclaimer>::Segment::Segment(Item* first)
+    : dequeueIndex(0), enqueueIndex(first != nullptr ? 1 : 0), next(SegmentPtr{ nullptr }) {
+    items[0].store(first, std::memory_order_relaxed);
+    for (std::size_t i = 1; i < queue::faa::kSegmentSize; ++i)
+        items[i].store(nullptr, std::memory_order_relaxed);
+}
+
+//==========================================================
+// The default constructor, which starts out with one empty
+// segment
+//==========================================================
+template<typename T, typename Reclaimer>
+queue::direct::FaaQueue<T, Reclaimer>::FaaQueue() {
+    auto segment = SegmentPtr{ SegmentPool::create(nullptr) };
+    m_pHead.store(segment, std::memory_order_relaxed);
+    m_pTail.store(segment, std::memory_order_relaxed);
+}
+
+//==========================================================
+// The destructor, which frees the segments that
+// are still linked, and the items left in them
+//==========================================================
+template<typename T, typename Reclaimer>
+queue::direct::FaaQueue<T, Reclaimer>::~FaaQueue() {
+    auto pIter = m_pHead.load(std::memory_order_acquire).ptr;
+    while (pIter != nullptr) {
+        for (auto& slot : pIter->items) {
+            auto item = slot.load(std::memory_order_relaxed);
+            if (item != nullptr && item != taken())
+                ItemPool::destroy(item);
+        }
+
+        auto segment = pIter;
+        pIter = pIter->next.load(std::memory_order_acquire).ptr;
+
+        SegmentPool::destroy(segment);
+    }
+}
+
+//==========================================================
+// This enqueues a value constructed in a new item. The
+// producer claims the
+// next slot of the tail segment with a fetch-and-add, and
+// stores the item unless a consumer claimed the slot first.
+//
+// A producer that keeps losing its slots to consumers stops
+// claiming slots, closes the segment, and links a new one
+// that already holds its item instead. That bounds the
+// number of slots a producer can lose; each failed attempt
+// to link a segment means another producer's append went in
+//
+// \param args    - The arguments to construct the value with
+//==========================================================
+template<typename T, typename Reclaimer>
+template<typename ...Args>
+void queue::direct::FaaQueue<T, Reclaimer>::emplace(Args&& ...args) {
+    auto item = ItemPool::create(std::forward<Args>(args)...);
+    typename Reclaimer::Guard guard;
+    std::size_t attempts = 0;
+
+    while (true) {
+        auto tail = guard.protect(0, m_pTail);
+
+        if (attempts < queue::faa::kFastPathAttempts) {
+            auto index = tail.ptr->enqueueIndex.fetch_add(1, std::memory_order_acq_rel);
+            if (index < queue::faa::kSegmentSize) {
+                Item* empty = nullptr;
+                if (tail.ptr->items[index].compare_exchange_strong(empty, item, std::memory_order_release, std::memory_order_relaxed))
+                    return;
+
+                ++attempts;
+                continue;
+            }
+        }
+        else {
+            // We've given up on the segment, so close it. Producers
+            // that claim a slot in it after our item is linked mustn't
+            // be dequeued ahead of it
+            tail.ptr->enqueueIndex.fetch_add(queue::faa::kSegmentSize, std::memory_order_acq_rel);
+        }
+
+        // The segment is full or closed
+        if (append(tail, item))
+            return;
+    }
+}
+
+//==========================================================
+// Links a new segment holding \param{item} after the tail
+// segment, or helps a concurrent append move the tail
+//
+// \param tail    - The protected tail segment
+// \param item    - The item to enqueue
+//
+// \return        - True if the item was enqueued
+//==========================================================
+template<typename T, typename Reclaimer>
+bool queue::direct::FaaQueue<T, Reclaimer>::append(SegmentPtr tail, Item* item) {
+    if (tail != m_pTail.load(std::memory_order_acquire))
+        return false;
+
+    auto next = tail.ptr->next.load(std::memory_order_acquire);
+    if (next.ptr != nullptr) {
+        // Another producer linked a segment, so help it along
+        m_pTail.compare_exchange_strong(tail, next);
+        return false;
+    }
+
+    auto segment = SegmentPtr{ SegmentPool::create(item) };
+    if (tail.ptr->next.compare_exchange_strong(next, segment)) {
+        m_pTail.compare_exchange_strong(tail, segment);
+        return true;
+    }
+
+    // We lost the race to link a segment. The item is still ours
+    segment.ptr->items[0].store(nullptr, std::memory_order_relaxed);
+    SegmentPool::destroy(segment.ptr);
+
+    return false;
+}
+
+//==========================================================
+// This attempts to perform a dequeue operation, which puts
+// the front value into \param{out}, and returns true if the
+// operation was successful. If the queue is empty, then it
+// returns false. The consumer claims the next slot of the
+// head segment with a fetch-and-add, and takes its item; an
+// empty slot is marked so that its producer moves on
+//
+// \param out   - An output variable that is assigned the
+//                value that was at the front of the queue
+//
+// \return      - The success of the dequeue operation
+//==========================================================
+template<typename T, typename Reclaimer>
+bool queue::direct::FaaQueue<T, Reclaimer>::dequeue(T& out) {
+    typename Reclaimer::Guard guard;
+
+    while (true) {
+        auto head = guard.protect(0, m_pHead);
+
+        // Don't claim slots in a segment that's been drained, or
+        // every empty poll would burn one of the producers' slots
+        if (head.ptr->dequeueIndex.load(std::memory_order_acquire) >=
+                head.ptr->enqueueIndex.load(std::memory_order_acquire) &&
+            head.ptr->next.load(std::memory_order_acquire).ptr == nullptr)
+            return false;
+
+        auto index = head.ptr->dequeueIndex.fetch_add(1, std::memory_order_acq_rel);
+        if (index >= queue::faa::kSegmentSize) {
+            // The segment is drained, so move on to the next one
+            auto next = head.ptr->next.load(std::memory_order_acquire);
+            if (next.ptr == nullptr)
+                return false;
+
+            // The tail mustn't be left pointing at a segment that
+            // is about to be retired
+            auto tail = m_pTail.load(std::memory_order_acquire);
+            if (tail == head)
+                m_pTail.compare_exchange_strong(tail, next);
+
+            if (m_pHead.compare_exchange_strong(head, next))
+                Reclaimer::retire(head.ptr);
+
+            continue;
+        }
+
+        auto item = head.ptr->items[index].exchange(taken(), std::memory_order_acq_rel);
+        if (item == nullptr)
+            continue;
+
+        out = std::move(item->value);
+        ItemPool::destroy(item);
+
+        return true;
+    }
+}
+
+//==========================================================
+// FAA Queue class definitions
+//==========================================================
+
+//==========================================================
+// The default constructor for the FaaQueue class
+//==========================================================
+template<typename T, typename Reclaimer>
+queue::FaaQueue<T, Reclaimer>::FaaQueue()
+    : m_pImpl(utility::make_unique<Impl>()) {}
+
+//==========================================================
+// Destructs the FaaQueue, freeing all allocated memory
+//==========================================================
+template<typename T, typename Reclaimer>
+queue::FaaQueue<T, Reclaimer>::~FaaQueue() {
+    // This automatically calls the dstor of Impl
+}
+
+//==========================================================
+// Defines the move constructor
+//
+// \param other     The other queue to move into this one
+//==========================================================
+template<typename T, typename Reclaimer>
+queue::FaaQueue<T, Reclaimer>::FaaQueue(FaaQueue && other)
+    : m_pImpl{ std::move(other.m_pImpl) }
+{}
+
+//==========================================================
+// Defines the move assignment operator
+//
+// \param other     The other queue to move into this one
+//==========================================================
+template<typename T, typename Reclaimer>
+queue::FaaQueue<T, Reclaimer>& queue::FaaQueue<T, Reclaimer>::operator=(FaaQueue && other) {
+    if (this != &other)
+        m_pImpl = std::move(other.m_pImpl);
+
+    return *this;
+}
+
+//==========================================================
+// This enqueues the specified value
+//
+// \param value   - The value to move into the queue
+//==========================================================
+template<typename T, typename Reclaimer>
+void queue::FaaQueue<T, Reclaimer>::enqueue(T&& value) {
+    m_pImpl->emplace(std::move(value));
+}
+
+//==========================================================
+// This enqueues a value constructed in place in its item
+//
+// \param args    - The arguments to construct the value with
+//==========================================================
+template<typename T, typename Reclaimer>
+template<typename ...Args>
+void queue::FaaQueue<T, Reclaimer>::emplace(Args&& ...args) {
+    m_pImpl->emplace(std::forward<Args>(args)...);
+}
+
+//==========================================================
+// This attempts to perform a dequeue operation, which puts
+// the front value into \param{out}, and returns true if the
+// operation was successful. If the queue is empty, then it
+// returns false.
+//
+// \param out   - An output variable that is assigned the
+//                value that was at the front of the queue
+//
+// \return      - The success of the dequeue operation
+//==========================================================
+template<typename T, typename Reclaimer>
+bool queue::FaaQueue<T, Reclaimer>::dequeue(T& out) {
+    return m_pImpl->dequeue(out);
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../queue/queue.h"
+
+#include <memory>
+
+namespace queue {
+
+namespace direct {
+template<typename T>
+class FlatCombiningQueue;
+}
+
+//==========================================================
+// This is a flat combining queue. Threads publish their
+// enqueues and dequeues, and whichever thread holds the
+// combiner lock applies all of them to a sequential deque
+// in one batch, see utility/flat_combining.h. This is the
+// polymorphic adapter over queue::direct::FlatCombiningQueue
+//==========================================================
+template<typename T>
+class FlatCombiningQueue : public queue::QueueBase<T> {
+public:
+    FlatCombiningQueue();
+    ~FlatCombiningQueue();
+
+    // Move operations
+    FlatCombiningQueue(FlatCombiningQueue&& other);
+    FlatCombiningQueue& operator=(FlatCombiningQueue&& other);
+
+    // Prevent copying
+    FlatCombiningQueue(const FlatCombiningQueue& other) = delete;
+    FlatCombiningQueue& operator=(const FlatCombiningQueue& other) = delete;
+
+    // inherited from queue::QueueBase
+    using queue::QueueBase<T>::enqueue;
+    virtual void enqueue(T&& value) override;
+    virtual bool dequeue(T& out) override;
+
+private:
+    using Impl = queue::direct::FlatCombiningQueue<T>;
+    std::unique_ptr<Impl> m_pImpl;
+};
+}  // namespace queue
+
+#include "../queue/flat_combining_queue_impl.h"
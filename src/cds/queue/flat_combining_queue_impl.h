@@ -0,0 +1,169 @@
+#pragma once
+
+#include "../queue/flat_combining_queue.h"
+#include "../../utility/memory.h"
+#include "../../utility/flat_combining.h"
+
+#include <memory>
+#include <deque>
+
+//==========================================================
+// Represents the flat combining queue, with every operation
+// dispatched statically
+//==========================================================
+template<typename T>
+class queue::direct::FlatCombiningQueue : public queue::direct::QueueOps<FlatCombiningQueue<T>, T> {
+public:
+    FlatCombiningQueue() = default;
+    ~FlatCombiningQueue() = default;
+
+    // Prevent copying
+    FlatCombiningQueue(const FlatCombiningQueue& other) = delete;
+    FlatCombiningQueue& operator=(const FlatCombiningQueue& other) = delete;
+
+    template<typename ...Args>
+    void emplace(Args&& ...args);
+    bool dequeue(T& out);
+
+private:
+    // A published enqueue or dequeue, and its result
+    struct Op {
+        bool isEnqueue;
+        bool success;
+        T value;
+    };
+
+    void apply(Op& op);
+
+    // Only touched by the combiner
+    std::deque<T> m_Values;
+
+    utility::fc::FlatCombiner<Op> m_Combiner;
+};
+
+//==========================================================
+// Direct Flat Combining Queue definitions
+//==========================================================
+
+//==========================================================
+// Applies a single request to the sequential queue. Only
+// the combiner calls this
+//
+// \param op      - The request, which is assigned its result
+//==========================================================
+template<typename T>
+void queue::direct::FlatCombiningQueue<T>::apply(Op& op) {
+    if (op.isEnqueue) {
+        m_Values.push_back(std::move(op.value));
+        op.success = true;
+        return;
+    }
+
+    op.success = !m_Values.empty();
+    if (op.success) {
+        op.value = std::move(m_Values.front());
+        m_Values.pop_front();
+    }
+}
+
+//==========================================================
+// This publishes an enqueue of a value constructed from
+// \param{args}, and waits for a combiner to apply it
+//
+// \param args    - The arguments to construct the value with
+//==========================================================
+template<typename T>
+template<typename ...Args>
+void queue::direct::FlatCombiningQueue<T>::emplace(Args&& ...args) {
+    Op op{ true, false, T(std::forward<Args>(args)...) };
+    m_Combiner.execute(op, [this](Op& request) { apply(request); });
+}
+
+//==========================================================
+// This publishes a dequeue, and waits for a combiner to apply
+// it
+//
+// \param out   - An output variable that is assigned the
+//                value that was at the front of the queue
+//
+// \return      - The success of the dequeue operation
+//==========================================================
+template<typename T>
+bool queue::direct::FlatCombiningQueue<T>::dequeue(T& out) {
+    Op op{ false, false, T{} };
+    m_Combiner.execute(op, [this](Op& request) { apply(request); });
+
+    if (op.success)
+        out = std::move(op.value);
+
+    return op.success;
+}
+
+//==========================================================
+// Flat Combining Queue class definitions
+//==========================================================
+
+//==========================================================
+// The default constructor for the FlatCombiningQueue class
+//==========================================================
+template<typename T>
+queue::FlatCombiningQueue<T>::FlatCombiningQueue()
+    : m_pImpl(utility::make_unique<Impl>()) {}
+
+//==========================================================
+// Destructs the FlatCombiningQueue, freeing all allocated
+// memory
+//==========================================================
+template<typename T>
+queue::FlatCombiningQueue<T>::~FlatCombiningQueue() {
+    // This automatically calls the dstor of impl
+}
+
+//==========================================================
+// This defines the move assignment operator
+//
+// \param other   - The value to move into this one
+//==========================================================
+template<typename T>
+queue::FlatCombiningQueue<T>& queue::FlatCombiningQueue<T>::operator=(FlatCombiningQueue&& other) {
+    if (this != &other)
+        m_pImpl = std::move(other.m_pImpl);
+
+    return *this;
+}
+
+//==========================================================
+// This defines the move constructor
+//
+// \param other   - The value to move into this one
+//==========================================================
+template<typename T>
+queue::FlatCombiningQueue<T>::FlatCombiningQueue(FlatCombiningQueue && other)
+    : m_pImpl{ std::move(other.m_pImpl) }
+{}
+
+//==========================================================
+// This enqueues the specified value
+//
+// \param value   - The value to move into the queue
+//==========================================================
+template<typename T>
+void queue::FlatCombiningQueue<T>::enqueue(T&& value) {
+    m_pImpl->emplace(std::move(value));
+}
+
+//==========================================================
+// This attempts to perform a dequeue operation, which puts
+// the front value into \param{out}, and returns true if the
+// operation was successful. If the queue is empty, then it
+// returns false.
+//
+// \param out   - An output variable that is assigned the
+//                value that was at the front of the queue
+//
+// \return      - The success of the dequeue operation
+//==========================================================
+template<typename T>
+bool queue::FlatCombiningQueue<T>::dequeue(T& out) {
+    return m_pImpl->dequeue(out);
+}
@@ -6,9 +6,15 @@
 
 namespace queue {
 
+namespace direct {
+template<typename T>
+class LockedQueue;
+}
+
 //==========================================================
 // Represents an implementation of the Michael and Scott
-// lock based queue
+// lock based queue. This is the polymorphic adapter over
+// queue::direct::LockedQueue
 //==========================================================
 template<typename T>
 class LockedQueue : public queue::QueueBase<T> {
@@ -24,12 +30,21 @@ public:
     LockedQueue(const LockedQueue& other) = delete;
     LockedQueue& operator=(const LockedQueue& other) = delete;
 
-    // inherited from stack::stack_base
-    virtual void enqueue(T value) override;
+    // inherited from queue::QueueBase
+    using queue::QueueBase<T>::enqueue;
+    virtual void enqueue(T&& value) override;
     virtual bool dequeue(T& out) override;
 
+    template<typename ...Args>
+    void emplace(Args&& ...args);
+
+protected:
+    // inherited from queue::QueueBase
+    virtual void enqueue_range(utility::ErasedInput<T> first, utility::ErasedInput<T> last) override;
+    virtual std::size_t dequeue_range(utility::ErasedOutput<T>& out, std::size_t max) override;
+
 private:
-    struct Impl;
+    using Impl = queue::direct::LockedQueue<T>;
     std::unique_ptr<Impl> m_pImpl;
 };
 }  // namespace queue
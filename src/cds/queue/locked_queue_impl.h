@@ -3,71 +3,93 @@
 #include "../queue/locked_queue.h"
 #include "../../utility/node.h"
 #include "../../utility/memory.h"
-
-#include "../../../application/command.h"
+#include "../../utility/node_pool.h"
+#include "../../utility/instrumentation.h"
 
 #include <mutex>
 #include <memory>
 
 //==========================================================
-// Locked Stack implementation definitions
+// Represents the Michael and Scott lock based queue, with
+// every operation dispatched statically. Nodes are plain
+// utility::Node objects, so traversing them involves no
+// virtual calls either
 //==========================================================
 template<typename T>
-struct queue::LockedQueue<T>::Impl {
-    Impl();
-    ~Impl();
+class queue::direct::LockedQueue : public queue::direct::QueueOps<LockedQueue<T>, T> {
+public:
+    LockedQueue();
+    ~LockedQueue();
 
     // Prevent copying
-    Impl(const Impl& other) = delete;
-    Impl& operator=(const Impl& other) = delete;
+    LockedQueue(const LockedQueue& other) = delete;
+    LockedQueue& operator=(const LockedQueue& other) = delete;
 
-    void enqueue(T value);
+    template<typename ...Args>
+    void emplace(Args&& ...args);
     bool dequeue(T& out);
 
-    utility::NodeBase<T>* m_pHead;
-    utility::NodeBase<T>* m_pTail;
+    template<typename InputIt>
+    void enqueue_range(InputIt first, InputIt last);
+
+    template<typename OutputIt>
+    std::size_t dequeue_range(OutputIt& out, std::size_t max);
+
+private:
+    using Node = utility::Node<T>;
+    using NodePool = utility::NodePool<Node>;
+
+    Node* m_pHead;
+    Node* m_pTail;
 
     mutable std::mutex m_HeadMut;
     mutable std::mutex m_TailMut;
 };
 
+//==========================================================
+// Direct Locked Queue definitions
+//==========================================================
+
+//==========================================================
+// The default constructor, which links in the dummy node
+//==========================================================
 template<typename T>
-queue::LockedQueue<T>::Impl::Impl()
+queue::direct::LockedQueue<T>::LockedQueue()
 {
-    auto node = new utility::Node<T>{};
+    auto node = NodePool::create();
     m_pHead = node;
     m_pTail = node;
 }
 //==========================================================
-// The destructor for the impl class. Handles all memory
-// cleanup
-//==========================================================
-template<typename T>
-queue::LockedQueue<T>::Impl::~Impl() {
-    //// Delete any remaining nodes that weren't dequeued
-    //auto pIter = m_pHead;
-    //while (pIter != nullptr) {
-    //    // Retain a reference to the current top
-    //    auto top = pIter;
-    //    pIter = pIter->get_next();
-    //
-    //    // delete the previous top
-    //    top->set_next(nullptr);
-    //    delete top;
-    //    top = nullptr;
-    //}
+// The destructor, which frees every remaining node
+//==========================================================
+template<typename T>
+queue::direct::LockedQueue<T>::~LockedQueue() {
+    // Delete any remaining nodes that weren't dequeued, along
+    // with the dummy node at the head
+    auto pIter = m_pHead;
+    while (pIter != nullptr) {
+        // Retain a reference to the current top
+        auto top = pIter;
+        pIter = pIter->get_next();
+
+        // delete the previous top
+        NodePool::destroy(top);
+    }
 }
 
 //==========================================================
-// This enqueues the specified value
+// This enqueues a value constructed in a new node
 //
-// \param value   - The value to enqueue
+// \param args    - The arguments to construct the value with
 //==========================================================
 template<typename T>
-void queue::LockedQueue<T>::Impl::enqueue(T value) {
-    std::lock_guard<std::mutex> lock{ m_TailMut };
+template<typename ...Args>
+void queue::direct::LockedQueue<T>::emplace(Args&& ...args) {
+    // Allocate outside of the critical section
+    auto node = NodePool::create(std::forward<Args>(args)...);
 
-    auto node = new utility::Node<T>{ value };
+    utility::instrumentation::LockGuard<std::mutex> lock{ m_TailMut };
 
     m_pTail->set_next(node);
     m_pTail = node;
@@ -85,23 +107,103 @@ void queue::LockedQueue<T>::Impl::enqueue(T value) {
 // \return      - The success of the pop operation
 //==========================================================
 template<typename T>
-bool queue::LockedQueue<T>::Impl::dequeue(T& out) {
-    std::lock_guard<std::mutex> lock{ m_HeadMut };
+bool queue::direct::LockedQueue<T>::dequeue(T& out) {
+    Node* node = nullptr;
+    {
+        utility::instrumentation::LockGuard<std::mutex> lock{ m_HeadMut };
+
+        node = m_pHead;
+        auto top = node->get_next();
 
-    auto node = m_pHead;
-    auto top = node->get_next();
+        if (!top) {
+            utility::instrumentation::count(utility::instrumentation::Counter::EmptyDequeues);
+            return false;
+        }
 
-    if (!top)
-        return false;
+        out = std::move(top->get_value());
 
-    out = top->get_value();
+        // set the new top, which becomes the new dummy node
+        m_pHead = top;
+    }
 
-    // set the new top
-    m_pHead = top;
+    // delete the old dummy outside of the critical section. It
+    // can't be the tail, since the queue wasn't empty
+    NodePool::destroy(node);
 
     return true;
 }
 
+//==========================================================
+// This enqueues the values in [first, last), taking the
+// tail lock once. The nodes are built straight from the
+// iterators and linked outside of the lock
+//
+// \param first   - The first value to enqueue
+// \param last    - One past the last value, after first
+//==========================================================
+template<typename T>
+template<typename InputIt>
+void queue::direct::LockedQueue<T>::enqueue_range(InputIt first, InputIt last) {
+    Node* head = NodePool::create(*first);
+    auto tail = head;
+
+    for (++first; first != last; ++first) {
+        auto node = NodePool::create(*first);
+        tail->set_next(node);
+        tail = node;
+    }
+
+    utility::instrumentation::LockGuard<std::mutex> lock{ m_TailMut };
+
+    m_pTail->set_next(head);
+    m_pTail = tail;
+}
+
+//==========================================================
+// This dequeues up to \param{max} values, taking the head
+// lock once
+//
+// \param out     - Assigned the dequeued values, and
+//                  advanced past them
+// \param max     - The most values to dequeue
+//
+// \return        - The number of values that were dequeued
+//==========================================================
+template<typename T>
+template<typename OutputIt>
+std::size_t queue::direct::LockedQueue<T>::dequeue_range(OutputIt& out, std::size_t max) {
+    std::size_t count = 0;
+    Node* first = nullptr;
+    Node* last = nullptr;
+    {
+        utility::instrumentation::LockGuard<std::mutex> lock{ m_HeadMut };
+
+        first = m_pHead;
+        for (; count < max; ++count) {
+            auto top = m_pHead->get_next();
+            if (!top)
+                break;
+
+            *out = std::move(top->get_value());
+            ++out;
+            m_pHead = top;
+        }
+
+        last = m_pHead;
+    }
+
+    // delete the old dummies outside of the critical section.
+    // None of them can be the tail, since each had a successor
+    while (first != last) {
+        auto node = first;
+        first = first->get_next();
+
+        NodePool::destroy(node);
+    }
+
+    return count;
+}
+
 //==========================================================
 // Locked Queue class definitions
 //==========================================================
@@ -147,11 +249,22 @@ queue::LockedQueue<T>& queue::LockedQueue<T>::operator=(LockedQueue<T> && other)
 //==========================================================
 // This enqueues the specified value
 //
-// \param value   - The value to enqueue
+// \param value   - The value to move into the queue
+//==========================================================
+template<typename T>
+void queue::LockedQueue<T>::enqueue(T&& value) {
+    m_pImpl->emplace(std::move(value));
+}
+
+//==========================================================
+// This enqueues a value constructed in place in its node
+//
+// \param args    - The arguments to construct the value with
 //==========================================================
 template<typename T>
-void queue::LockedQueue<T>::enqueue(T value) {
-    m_pImpl->enqueue(value);
+template<typename ...Args>
+void queue::LockedQueue<T>::emplace(Args&& ...args) {
+    m_pImpl->emplace(std::forward<Args>(args)...);
 }
 
 //==========================================================
@@ -169,3 +282,29 @@ template<typename T>
 bool queue::LockedQueue<T>::dequeue(T& out) {
     return m_pImpl->dequeue(out);
 }
+
+//==========================================================
+// This enqueues the values in [first, last), taking the
+// tail lock once
+//
+// \param first   - The first value to enqueue
+// \param last    - One past the last value
+//==========================================================
+template<typename T>
+void queue::LockedQueue<T>::enqueue_range(utility::ErasedInput<T> first, utility::ErasedInput<T> last) {
+    m_pImpl->enqueue_range(first, last);
+}
+
+//==========================================================
+// This dequeues up to \param{max} values, taking the head
+// lock once
+//
+// \param out     - Assigned the dequeued values
+// \param max     - The most values to dequeue
+//
+// \return        - The number of values that were dequeued
+//==========================================================
+template<typename T>
+std::size_t queue::LockedQueue<T>::dequeue_range(utility::ErasedOutput<T>& out, std::size_t max) {
+    return m_pImpl->dequeue_range(out, max);
+}
@@ -1,32 +1,43 @@
 #pragma once
 
+#include "../../utility/tagged_ptr.h"
+
+#include <new>
 #include <atomic>
+#include <utility>
+#include <cstddef>
+#include <type_traits>
 
 namespace queue { namespace lf {
 template<typename T>
 struct Node;
 
+// A node reference and its ABA counter, see
+// utility/tagged_ptr.h
 template<typename T>
-struct alignas(2 * sizeof(void*)) NodePtr
-{
-    Node<T>* ptr;
-    size_t count;
-
-    NodePtr() = default;
-    NodePtr(Node<T>* p, size_t c)
-        : ptr(std::move(p)), count(c) {}
-
-    bool operator==(const NodePtr& other) {
-        return other.ptr == ptr && other.count == count;
-    }
-};
+using NodePtr = utility::TaggedPtr<Node<T>>;
 
+//==========================================================
+// A queue node. The value is only alive while the node is
+// queued behind the dummy: it's constructed in place by the
+// enqueue, and moved out and destroyed by the dequeue that
+// turns the node into the new dummy. The dummy needs no
+// value, so T needn't be default constructible
+//==========================================================
 template<typename T>
 struct Node
 {
-    T value;
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
     std::atomic<NodePtr<T>> next;
+
+    template<typename ...Args>
+    void emplace(Args&& ...args) {
+        new (&storage) T(std::forward<Args>(args)...);
+    }
+
+    T& value() { return *reinterpret_cast<T*>(&storage); }
+    void destroy() { value().~T(); }
 };
 
 }  // namespace lf
-} // namespace stack
+} // namespace queue
@@ -1,18 +1,34 @@
 #pragma once
 
 #include "../queue/queue.h"
+#include "../../utility/backoff.h"
+#include "../../utility/reclamation.h"
 
 #include <memory>
 
 namespace queue {
 
+namespace direct {
+template<typename T, typename Reclaimer = utility::reclaim::HazardPointers,
+         typename Backoff = utility::backoff::None>
+class LockFreeQueue;
+}
+
 //==========================================================
 // Represents an implementation of the lock-free queue described
-// in the paper by Michael and Scott
+// in the paper by Michael and Scott. Dequeued nodes are freed
+// through the Reclaimer policy, see utility/reclamation.h,
+// and failed CASes are retried after the Backoff policy, see
+// utility/backoff.h. This is the polymorphic adapter over
+// queue::direct::LockFreeQueue
 //==========================================================
-template<typename T>
+template<typename T, typename Reclaimer = utility::reclaim::HazardPointers,
+         typename Backoff = utility::backoff::None>
 class LockFreeQueue : public queue::QueueBase<T> {
 public:
+    using reclaimer_type = Reclaimer;
+    using backoff_type = Backoff;
+
     LockFreeQueue();
     ~LockFreeQueue();
 
@@ -24,12 +40,21 @@ public:
     LockFreeQueue(const LockFreeQueue& other) = delete;
     LockFreeQueue& operator=(const LockFreeQueue& other) = delete;
 
-    // inherited from stack::stack_base
-    virtual void enqueue(T value) override;
+    // inherited from queue::QueueBase
+    using queue::QueueBase<T>::enqueue;
+    virtual void enqueue(T&& value) override;
     virtual bool dequeue(T& out) override;
 
+    template<typename ...Args>
+    void emplace(Args&& ...args);
+
+protected:
+    // inherited from queue::QueueBase
+    virtual void enqueue_range(utility::ErasedInput<T> first, utility::ErasedInput<T> last) override;
+    virtual std::size_t dequeue_range(utility::ErasedOutput<T>& out, std::size_t max) override;
+
 private:
-    struct Impl;
+    using Impl = queue::direct::LockFreeQueue<T, Reclaimer, Backoff>;
     std::unique_ptr<Impl> m_pImpl;
 };
 }  // namespace queue
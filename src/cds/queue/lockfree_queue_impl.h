@@ -3,6 +3,10 @@
 #include "../queue/lockfree_queue.h"
 #include "../queue/lockfree_node.h"
 #include "../../utility/memory.h"
+#include "../../utility/backoff.h"
+#include "../../utility/node_pool.h"
+#include "../../utility/instrumentation.h"
+#include "../../utility/reclamation.h"
 
 #include <mutex>
 #include <atomic>
@@ -10,97 +14,192 @@
 #include <cassert>
 
 //==========================================================
-// Locked Stack Implementation definitions
+// Represents the Michael and Scott lock-free queue, with
+// every operation dispatched statically
 //==========================================================
-template<typename T>
-struct queue::LockFreeQueue<T>::Impl {
-    Impl();
-    ~Impl();
+template<typename T, typename Reclaimer, typename Backoff>
+class queue::direct::LockFreeQueue : public queue::direct::QueueOps<LockFreeQueue<T, Reclaimer, Backoff>, T> {
+public:
+    using reclaimer_type = Reclaimer;
+    using backoff_type = Backoff;
+
+    LockFreeQueue();
+    ~LockFreeQueue();
 
     // Prevent copying
-    Impl(const Impl& other) = delete;
-    Impl& operator=(const Impl& other) = delete;
+    LockFreeQueue(const LockFreeQueue& other) = delete;
+    LockFreeQueue& operator=(const LockFreeQueue& other) = delete;
 
-    void enqueue(T value);
+    template<typename ...Args>
+    void emplace(Args&& ...args);
     bool dequeue(T& out);
 
+    template<typename InputIt>
+    void enqueue_range(InputIt first, InputIt last);
+
+private:
+    using NodePool = utility::NodePool<queue::lf::Node<T>>;
+
+    template<typename ...Args>
+    static queue::lf::Node<T>* make_node(Args&& ...args);
+
+    void link(queue::lf::Node<T>* first, queue::lf::Node<T>* last);
+
     std::atomic<queue::lf::NodePtr<T>> m_pHead{};
     std::atomic<queue::lf::NodePtr<T>> m_pTail{};
 };
 
 //==========================================================
-// The default constructor for the Impl struct
+// Direct Lock-Free Queue definitions
+//==========================================================
+
+//==========================================================
+// The default constructor, which links in the dummy node
 //==========================================================
-template<typename T>
-queue::LockFreeQueue<T>::Impl::Impl() {
+template<typename T, typename Reclaimer, typename Backoff>
+queue::direct::LockFreeQueue<T, Reclaimer, Backoff>::LockFreeQueue() {
     // Assign a dummy node to the head and tail pointers
-    auto wrapper = queue::lf::NodePtr<T>{ new queue::lf::Node<T>{}, 0 };
+    auto wrapper = queue::lf::NodePtr<T>{ NodePool::create(), 0 };
     m_pHead = wrapper;
     m_pTail = wrapper;
 }
 
 //==========================================================
-// The destructor for the Impl class. Handles all memory
-// cleanup
+// The destructor, which frees every remaining node
 //==========================================================
-template<typename T>
-queue::LockFreeQueue<T>::Impl::~Impl() {
-    auto pIter = m_pHead.load(std::memory_order_acquire);
-    while (pIter.ptr != nullptr) {
+template<typename T, typename Reclaimer, typename Backoff>
+queue::direct::LockFreeQueue<T, Reclaimer, Backoff>::~LockFreeQueue() {
+    // Retired nodes have already been unlinked, so everything
+    // reachable from the head still belongs to the queue
+    auto pIter = m_pHead.load(std::memory_order_acquire).get();
+    auto dummy = pIter;
+    while (pIter != nullptr) {
         // Retain a reference to the current top
         auto top = pIter;
-        pIter = pIter.ptr->next;
+        pIter = pIter->next.load(std::memory_order_acquire).get();
+
+        // Every node behind the dummy holds a value
+        if (top != dummy)
+            top->destroy();
 
-        //// delete the previous top
-        //top.ptr->next.store({ nullptr, 0 }, std::memory_order_release);
-        //delete top.ptr;
-        //top.ptr = nullptr;
+        // delete the previous top
+        NodePool::destroy(top);
     }
 }
 
 //==========================================================
-// This enqueues the specified value
+// Allocates a node and constructs its value in place
+//
+// \param args    - The arguments to construct the value with
+//
+// \return        - The new node
+//==========================================================
+template<typename T, typename Reclaimer, typename Backoff>
+template<typename ...Args>
+queue::lf::Node<T>* queue::direct::LockFreeQueue<T, Reclaimer, Backoff>::make_node(Args&& ...args) {
+    auto node = NodePool::create();
+    try {
+        node->emplace(std::forward<Args>(args)...);
+    }
+    catch (...) {
+        NodePool::destroy(node);
+        throw;
+    }
+
+    return node;
+}
+
+//==========================================================
+// This enqueues a value constructed in a new node
+//
+// \param args    - The arguments to construct the value with
+//==========================================================
+template<typename T, typename Reclaimer, typename Backoff>
+template<typename ...Args>
+void queue::direct::LockFreeQueue<T, Reclaimer, Backoff>::emplace(Args&& ...args) {
+    auto node = make_node(std::forward<Args>(args)...);
+    link(node, node);
+}
+
+//==========================================================
+// This enqueues the values in [first, last) at once. The
+// nodes are built straight from the iterators and linked to
+// each other privately first, so the whole chain is
+// published by a single CAS on the tail's next pointer
+//
+// \param first   - The first value to enqueue
+// \param last    - One past the last value, after first
+//==========================================================
+template<typename T, typename Reclaimer, typename Backoff>
+template<typename InputIt>
+void queue::direct::LockFreeQueue<T, Reclaimer, Backoff>::enqueue_range(InputIt first, InputIt last) {
+    auto head = make_node(*first);
+    auto tail = head;
+
+    for (++first; first != last; ++first) {
+        auto node = make_node(*first);
+        tail->next.store(queue::lf::NodePtr<T>{ node, 0 }, std::memory_order_relaxed);
+        tail = node;
+    }
+
+    link(head, tail);
+}
+
+//==========================================================
+// This appends a privately linked chain of nodes to the
+// queue. Other threads that find the tail lagging advance
+// it through the chain one node at a time
 //
-// \param value   - The value to enqueue
+// \param first   - The first node of the chain
+// \param last    - The last node of the chain
 //==========================================================
-template<typename T>
-void queue::LockFreeQueue<T>::Impl::enqueue(T value) {
-    queue::lf::Node<T>* node = new queue::lf::Node<T>{ value };
+template<typename T, typename Reclaimer, typename Backoff>
+void queue::direct::LockFreeQueue<T, Reclaimer, Backoff>::link(queue::lf::Node<T>* first, queue::lf::Node<T>* last) {
+    typename Reclaimer::Guard guard;
+    utility::instrumentation::RetryLoop retries;
+    Backoff backoff;
     queue::lf::NodePtr<T> tail{};
     queue::lf::NodePtr<T> next{};
     queue::lf::NodePtr<T> wrapper{};
 
     while (true) {
-        // Repeatedly obtain the value of the tail and the next value
-        tail = m_pTail.load(std::memory_order_acquire);
-        next = tail.ptr->next.load(std::memory_order_acquire);
+        // Repeatedly obtain the value of the tail and the next value.
+        // The guard keeps the tail alive while we dereference it
+        tail = guard.protect(0, m_pTail);
+        next = tail.get()->next.load(std::memory_order_acquire);
 
         // Ensure that the tail hasn't been changed 
         if (tail == m_pTail.load(std::memory_order_acquire)) {
 
             // If we aren't observing an intermediate enqueue result
-            if (next.ptr == nullptr) {
+            if (next.get() == nullptr) {
 
                 // Perform the CAS to set tail's next node with the new
                 // node we're enqueueing
-                wrapper = queue::lf::NodePtr<T>{ node, next.count + 1 };
-                if (tail.ptr->next.compare_exchange_strong(next, wrapper))
+                wrapper = queue::lf::NodePtr<T>{ first, next.count() + 1 };
+                if (utility::instrumentation::cas(tail.get()->next.compare_exchange_strong(next, wrapper)))
                     break;
 
+                // Another enqueuer linked its node first
+                backoff();
             }
             else {
 
                 // We're observing an intermediate result where the next pointer
                 // was set, and so let us complete the operation
-                wrapper = queue::lf::NodePtr<T>{ next.ptr, tail.count + 1 };
-                m_pTail.compare_exchange_strong(tail, wrapper);
+                utility::instrumentation::count(utility::instrumentation::Counter::TailHelps);
+
+                wrapper = queue::lf::NodePtr<T>{ next.get(), tail.count() + 1 };
+                utility::instrumentation::cas(m_pTail.compare_exchange_strong(tail, wrapper));
             }
         }
+
+        retries.failed();
     }
 
-    // Lastly, point the tail at the enqueued node
-    wrapper = queue::lf::NodePtr<T>{ node, tail.count + 1 };
-    m_pTail.compare_exchange_strong(tail, wrapper);
+    // Lastly, point the tail at the end of the chain
+    wrapper = queue::lf::NodePtr<T>{ last, tail.count() + 1 };
+    utility::instrumentation::cas(m_pTail.compare_exchange_strong(tail, wrapper));
 }
 
 //==========================================================
@@ -114,49 +213,65 @@ void queue::LockFreeQueue<T>::Impl::enqueue(T value) {
 //
 // \return      - The success of the pop operation
 //==========================================================
-template<typename T>
-bool queue::LockFreeQueue<T>::Impl::dequeue(T& out) {
+template<typename T, typename Reclaimer, typename Backoff>
+bool queue::direct::LockFreeQueue<T, Reclaimer, Backoff>::dequeue(T& out) {
+    typename Reclaimer::Guard guard;
+    utility::instrumentation::RetryLoop retries;
+    Backoff backoff;
     queue::lf::NodePtr<T> head{};
     queue::lf::NodePtr<T> tail{};
     queue::lf::NodePtr<T> next{};
     queue::lf::NodePtr<T> wrapper{};
 
     while (true) {
-        head = m_pHead;
-        tail = m_pTail;
-        next = head.ptr->next;
+        // Protect the head, and then its successor, whose value
+        // we read before swinging the head past it
+        head = guard.protect(0, m_pHead);
+        tail = m_pTail.load(std::memory_order_acquire);
+        next = guard.protect(1, head.get()->next);
 
         // Make sure that we're not observing an intermediate state
         if (head == m_pHead.load(std::memory_order_acquire)) {
 
             // Check to see if the tail is falling behind
-            if (head.ptr == tail.ptr) {
+            if (head.get() == tail.get()) {
 
                 // Is the queue empty?
-                if (next.ptr == nullptr)
+                if (next.get() == nullptr) {
+                    utility::instrumentation::count(utility::instrumentation::Counter::EmptyDequeues);
                     return false;
+                }
 
                 // Advance tail since it's falling behind
-                wrapper = queue::lf::NodePtr<T>{ next.ptr, tail.count + 1 };
-                m_pTail.compare_exchange_strong(tail, wrapper);
+                utility::instrumentation::count(utility::instrumentation::Counter::TailHelps);
+
+                wrapper = queue::lf::NodePtr<T>{ next.get(), tail.count() + 1 };
+                utility::instrumentation::cas(m_pTail.compare_exchange_strong(tail, wrapper));
             }
             else {
 
-                // Obtain the value of the top of the queue and advance
-                // the top to the next node
-                out = next.ptr->value;
-
-                wrapper = queue::lf::NodePtr<T>{ next.ptr, head.count + 1 };
-                if (m_pHead.compare_exchange_strong(head, wrapper))
+                // Advance the top to the next node. Only the thread whose
+                // CAS succeeds touches its value
+                wrapper = queue::lf::NodePtr<T>{ next.get(), head.count() + 1 };
+                if (utility::instrumentation::cas(m_pHead.compare_exchange_strong(head, wrapper)))
                     break;
+
+                // Another dequeuer took this node first
+                backoff();
             }
         }
+
+        retries.failed();
     }
 
-    //// delete the previous head
-    //head.ptr->next.store({ nullptr, 0 }, std::memory_order_release);
-    //delete head.ptr;
-    //head.ptr = nullptr;
+    // The next node is the new dummy, so its value is ours. The
+    // guard keeps it alive until we've moved the value out
+    out = std::move(next.get()->value());
+    next.get()->destroy();
+
+    // The old head is now unreachable, but other dequeuers may
+    // still be reading it, so defer its deletion
+    Reclaimer::retire(head.get());
 
     return true;
 }
@@ -168,15 +283,15 @@ bool queue::LockFreeQueue<T>::Impl::dequeue(T& out) {
 //==========================================================
 // The default constructor for the LockFreeQueue class
 //==========================================================
-template<typename T>
-queue::LockFreeQueue<T>::LockFreeQueue()
+template<typename T, typename Reclaimer, typename Backoff>
+queue::LockFreeQueue<T, Reclaimer, Backoff>::LockFreeQueue()
     : m_pImpl(utility::make_unique<Impl>()) {}
 
 //==========================================================
 // Destructs the LockFreeQueue, freeing all allocated memory
 //==========================================================
-template<typename T>
-queue::LockFreeQueue<T>::~LockFreeQueue() {
+template<typename T, typename Reclaimer, typename Backoff>
+queue::LockFreeQueue<T, Reclaimer, Backoff>::~LockFreeQueue() {
     // This automatically calls the dstor of Impl
 }
 
@@ -185,8 +300,8 @@ queue::LockFreeQueue<T>::~LockFreeQueue() {
 //
 // \param other     The other queue to move into this one
 //==========================================================
-template<typename T>
-queue::LockFreeQueue<T>::LockFreeQueue(LockFreeQueue && other) {
+template<typename T, typename Reclaimer, typename Backoff>
+queue::LockFreeQueue<T, Reclaimer, Backoff>::LockFreeQueue(LockFreeQueue && other) {
     m_pImpl = std::move(other.m_pImpl);
 }
 
@@ -195,8 +310,8 @@ queue::LockFreeQueue<T>::LockFreeQueue(LockFreeQueue && other) {
 //
 // \param other     The other queue to move into this one
 //==========================================================
-template<typename T>
-queue::LockFreeQueue<T>& queue::LockFreeQueue<T>::operator=(LockFreeQueue && other) {
+template<typename T, typename Reclaimer, typename Backoff>
+queue::LockFreeQueue<T, Reclaimer, Backoff>& queue::LockFreeQueue<T, Reclaimer, Backoff>::operator=(LockFreeQueue && other) {
     if (this != &other)
         m_pImpl = std::move(other.m_pImpl);
 
@@ -206,11 +321,22 @@ queue::LockFreeQueue<T>& queue::LockFreeQueue<T>::operator=(LockFreeQueue && oth
 //==========================================================
 // This enqueues the specified value
 //
-// \param value   - The value to enqueue
+// \param value   - The value to move into the queue
+//==========================================================
+template<typename T, typename Reclaimer, typename Backoff>
+void queue::LockFreeQueue<T, Reclaimer, Backoff>::enqueue(T&& value) {
+    m_pImpl->emplace(std::move(value));
+}
+
+//==========================================================
+// This enqueues a value constructed in place in its node
+//
+// \param args    - The arguments to construct the value with
 //==========================================================
-template<typename T>
-void queue::LockFreeQueue<T>::enqueue(T value) {
-    m_pImpl->enqueue(value);
+template<typename T, typename Reclaimer, typename Backoff>
+template<typename ...Args>
+void queue::LockFreeQueue<T, Reclaimer, Backoff>::emplace(Args&& ...args) {
+    m_pImpl->emplace(std::forward<Args>(args)...);
 }
 
 //==========================================================
@@ -224,7 +350,34 @@ void queue::LockFreeQueue<T>::enqueue(T value) {
 //
 // \return      - The success of the pop operation
 //==========================================================
-template<typename T>
-bool queue::LockFreeQueue<T>::dequeue(T& out) {
+template<typename T, typename Reclaimer, typename Backoff>
+bool queue::LockFreeQueue<T, Reclaimer, Backoff>::dequeue(T& out) {
     return m_pImpl->dequeue(out);
 }
+
+//==========================================================
+// This enqueues the values in [first, last) with a single
+// CAS
+//
+// \param first   - The first value to enqueue
+// \param last    - One past the last value
+//==========================================================
+template<typename T, typename Reclaimer, typename Backoff>
+void queue::LockFreeQueue<T, Reclaimer, Backoff>::enqueue_range(utility::ErasedInput<T> first, utility::ErasedInput<T> last) {
+    m_pImpl->enqueue_range(first, last);
+}
+
+//==========================================================
+// This dequeues up to \param{max} values. The values behind
+// the head can't be protected all at once, so they're taken
+// one at a time
+//
+// \param out     - Assigned the dequeued values
+// \param max     - The most values to dequeue
+//
+// \return        - The number of values that were dequeued
+//==========================================================
+template<typename T, typename Reclaimer, typename Backoff>
+std::size_t queue::LockFreeQueue<T, Reclaimer, Backoff>::dequeue_range(utility::ErasedOutput<T>& out, std::size_t max) {
+    return m_pImpl->dequeue_range(out, max);
+}
@@ -1,5 +1,10 @@
 #pragma once
 
+#include "../../utility/erased_iterator.h"
+
+#include <cstddef>
+#include <utility>
+
 namespace queue {
 
 //==========================================================
@@ -9,9 +14,191 @@ namespace queue {
 template<typename T>
 class QueueBase {
 public:
+    using value_type = T;
+
     virtual ~QueueBase() { };
 
-    virtual void enqueue(T value) = 0;
+    virtual void enqueue(T&& value) = 0;
     virtual bool dequeue(T& out) = 0;
+
+    //==========================================================
+    // Enqueues a copy of the value
+    //==========================================================
+    void enqueue(const T& value) {
+        enqueue(T(value));
+    }
+
+    //==========================================================
+    // Enqueues a value constructed from \param{args}. Queues
+    // that store values in nodes construct it in place
+    //==========================================================
+    template<typename ...Args>
+    void emplace(Args&& ...args) {
+        enqueue(T(std::forward<Args>(args)...));
+    }
+
+    //==========================================================
+    // Attempts to enqueue the value, returning false if the
+    // queue is full. Unbounded queues always succeed. The value
+    // is only moved from if it was enqueued
+    //==========================================================
+    virtual bool try_enqueue(T&& value) {
+        enqueue(std::move(value));
+        return true;
+    }
+
+    bool try_enqueue(const T& value) {
+        T copy(value);
+        return try_enqueue(std::move(copy));
+    }
+
+    //==========================================================
+    // Enqueues the values in [first, last), in order. Pass
+    // move iterators to move the values in
+    //
+    // \param first   - The first value to enqueue
+    // \param last    - One past the last value to enqueue
+    //==========================================================
+    template<typename InputIt>
+    void enqueue_bulk(InputIt first, InputIt last) {
+        if (first != last)
+            enqueue_range(utility::ErasedInput<T>(first, last), utility::ErasedInput<T>());
+    }
+
+    //==========================================================
+    // Dequeues up to \param{max} values, in order
+    //
+    // \param out     - Assigned the dequeued values
+    // \param max     - The most values to dequeue
+    //
+    // \return        - The number of values that were dequeued
+    //==========================================================
+    template<typename OutputIt>
+    std::size_t try_dequeue_bulk(OutputIt out, std::size_t max) {
+        utility::ErasedOutput<T> erased(out);
+        return dequeue_range(erased, max);
+    }
+
+protected:
+    //==========================================================
+    // The hooks behind the bulk operations, which see the
+    // caller's iterators through utility::ErasedInput and
+    // ErasedOutput, so no batch is copied on the way. Queues
+    // that can publish or take several values at once override
+    // these; by default they enqueue and dequeue one value at a
+    // time. enqueue_range is never given an empty range
+    //==========================================================
+    virtual void enqueue_range(utility::ErasedInput<T> first, utility::ErasedInput<T> last) {
+        for (; first != last; ++first)
+            enqueue(*first);
+    }
+
+    virtual std::size_t dequeue_range(utility::ErasedOutput<T>& out, std::size_t max) {
+        std::size_t count = 0;
+        T value{};
+        while (count < max && dequeue(value)) {
+            *out = std::move(value);
+            ++out;
+            ++count;
+        }
+
+        return count;
+    }
+};
+
+namespace direct {
+
+//==========================================================
+// The statically dispatched counterpart of QueueBase. Each
+// queue in queue::direct derives from it, naming itself as
+// Derived, and provides:
+//
+//   emplace(args...)   - Enqueues a value constructed from
+//                        the arguments
+//   dequeue(out)       - Dequeues into out, returning false
+//                        if the queue was empty
+//
+// Bounded queues also provide try_enqueue(T&&), and queues
+// that can move several values at once provide their own
+// enqueue_range and dequeue_range. Everything else is built
+// on those without a single virtual call
+//==========================================================
+template<typename Derived, typename T>
+class QueueOps {
+public:
+    using value_type = T;
+
+    void enqueue(T&& value) {
+        derived().emplace(std::move(value));
+    }
+
+    void enqueue(const T& value) {
+        derived().emplace(value);
+    }
+
+    //==========================================================
+    // Attempts to enqueue the value, returning false if the
+    // queue is full. Unbounded queues always succeed
+    //==========================================================
+    bool try_enqueue(T&& value) {
+        derived().emplace(std::move(value));
+        return true;
+    }
+
+    bool try_enqueue(const T& value) {
+        T copy(value);
+        return derived().try_enqueue(std::move(copy));
+    }
+
+    //==========================================================
+    // Enqueues the values in [first, last), in order, see
+    // QueueBase::enqueue_bulk
+    //==========================================================
+    template<typename InputIt>
+    void enqueue_bulk(InputIt first, InputIt last) {
+        if (first != last)
+            derived().enqueue_range(first, last);
+    }
+
+    //==========================================================
+    // Dequeues up to \param{max} values, in order, see
+    // QueueBase::try_dequeue_bulk
+    //==========================================================
+    template<typename OutputIt>
+    std::size_t try_dequeue_bulk(OutputIt out, std::size_t max) {
+        return derived().dequeue_range(out, max);
+    }
+
+    //==========================================================
+    // The default bulk hooks, which move one value at a time.
+    // enqueue_range is never given an empty range, and
+    // dequeue_range advances \param{out} past what it wrote
+    //==========================================================
+    template<typename InputIt>
+    void enqueue_range(InputIt first, InputIt last) {
+        for (; first != last; ++first)
+            derived().emplace(*first);
+    }
+
+    template<typename OutputIt>
+    std::size_t dequeue_range(OutputIt& out, std::size_t max) {
+        std::size_t count = 0;
+        T value{};
+        while (count < max && derived().dequeue(value)) {
+            *out = std::move(value);
+            ++out;
+            ++count;
+        }
+
+        return count;
+    }
+
+protected:
+    QueueOps() = default;
+    ~QueueOps() = default;
+
+private:
+    Derived& derived() { return static_cast<Derived&>(*this); }
 };
-}  // namespace stack
+}  // namespace direct
+}  // namespace queue
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "../queue/queue.h"
+#include "../queue/lockfree_queue.h"
+
+#include <memory>
+#include <cstddef>
+
+namespace queue {
+
+//==========================================================
+// Where a consumer starts its sweep over the lanes of a
+// ShardedQueue. Affinity starts at the thread's own lane,
+// so a thread that both produces and consumes takes back
+// its own values while they're still in its cache. Random
+// starts anywhere, which spreads consumers over the lanes
+// when they don't produce
+//==========================================================
+enum class Sweep {
+    Affinity,
+    Random
+};
+
+namespace direct {
+template<typename T, typename Lane = queue::direct::LockFreeQueue<T>>
+class ShardedQueue;
+}
+
+//==========================================================
+// Represents a relaxed FIFO queue sharded into lanes, each
+// an independent inner queue. Every thread has a home lane
+// it enqueues to, so producers on different lanes never
+// touch the same head or tail, and consumers sweep the lanes
+// until one yields a value.
+//
+// Values from one producer come out in the order it
+// enqueued them, but values from different producers may
+// come out in any order. A sweep that finds every lane empty
+// returns false even if a lane it had already passed was
+// refilled in the meantime. Lane is a queue from
+// queue::direct. This is the polymorphic adapter over
+// queue::direct::ShardedQueue
+//==========================================================
+template<typename T, typename Lane = queue::direct::LockFreeQueue<T>>
+class ShardedQueue : public queue::QueueBase<T> {
+public:
+    using lane_type = Lane;
+
+    explicit ShardedQueue(std::size_t lanes = 0, queue::Sweep sweep = queue::Sweep::Affinity);
+    ~ShardedQueue();
+
+    // Move operations
+    ShardedQueue(ShardedQueue&& other);
+    ShardedQueue& operator=(ShardedQueue&& other);
+
+    // Prevent copying
+    ShardedQueue(const ShardedQueue& other) = delete;
+    ShardedQueue& operator=(const ShardedQueue& other) = delete;
+
+    // inherited from queue::QueueBase
+    using queue::QueueBase<T>::enqueue;
+    virtual void enqueue(T&& value) override;
+    virtual bool dequeue(T& out) override;
+
+    template<typename ...Args>
+    void emplace(Args&& ...args);
+
+    std::size_t lane_count() const;
+
+protected:
+    // inherited from queue::QueueBase
+    virtual void enqueue_range(utility::ErasedInput<T> first, utility::ErasedInput<T> last) override;
+    virtual std::size_t dequeue_range(utility::ErasedOutput<T>& out, std::size_t max) override;
+
+private:
+    using Impl = queue::direct::ShardedQueue<T, Lane>;
+    std::unique_ptr<Impl> m_pImpl;
+};
+}  // namespace queue
+
+#include "../queue/sharded_queue_impl.h"
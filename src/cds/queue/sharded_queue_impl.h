@@ -0,0 +1,381 @@
+#pragma once
+
+#include "../queue/sharded_queue.h"
+#include "../../utility/memory.h"
+#include "../../utility/backoff.h"
+#include "../../utility/cache_line.h"
+#include "../../utility/thread_records.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+
+namespace queue { namespace detail {
+
+//==========================================================
+// A lane id that's held by one thread at a time. Ids are
+// handed out in the order their records are created, and a
+// thread that exits releases its id for a later one
+//==========================================================
+struct LaneRecord {
+    LaneRecord()
+        : index(next_lane_index()), active(true), next(nullptr) {}
+
+    static std::size_t next_lane_index() {
+        static std::atomic<std::size_t> next{ 0 };
+        return next.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    const std::size_t index;
+    std::atomic<bool> active;
+    LaneRecord* next;
+};
+
+//==========================================================
+// Returns the process-wide list of lane ids. It's never
+// destroyed, so threads that exit during static destruction
+// can still release their ids
+//==========================================================
+inline utility::RecordList<LaneRecord>& lane_records() {
+    static auto pRecords = new utility::RecordList<LaneRecord>{};
+    return *pRecords;
+}
+
+//==========================================================
+// Adopts the lowest lane id that no live thread holds, or a
+// new one if every id is taken. Taking the lowest keeps the
+// ids of the live threads dense, so that as many threads as
+// there are lanes land on lanes of their own
+//
+// \return      - The record of the adopted id
+//==========================================================
+inline LaneRecord* acquire_lane_record() {
+    auto& records = lane_records();
+    while (true) {
+        LaneRecord* lowest = nullptr;
+        for (auto pIter = records.head(); pIter != nullptr; pIter = pIter->next) {
+            if (!pIter->active.load(std::memory_order_relaxed) &&
+                (lowest == nullptr || pIter->index < lowest->index))
+                lowest = pIter;
+        }
+
+        if (lowest == nullptr)
+            return records.acquire();
+
+        bool expected = false;
+        if (lowest->active.compare_exchange_strong(expected, true))
+            return lowest;
+    }
+}
+
+//==========================================================
+// Owns the calling thread's lane id for the thread's
+// lifetime
+//==========================================================
+class LaneId {
+public:
+    LaneId()
+        : m_pRecord(acquire_lane_record()) {}
+
+    ~LaneId() { lane_records().release(m_pRecord); }
+
+    // Prevent copying
+    LaneId(const LaneId& other) = delete;
+    LaneId& operator=(const LaneId& other) = delete;
+
+    std::size_t get() const { return m_pRecord->index; }
+
+private:
+    LaneRecord* m_pRecord;
+};
+
+inline std::size_t lane_id() {
+    static thread_local LaneId id;
+    return id.get();
+}
+
+}  // namespace detail
+}  // namespace queue
+
+//==========================================================
+// Represents the sharded queue, with every operation
+// dispatched statically
+//==========================================================
+template<typename T, typename Lane>
+class queue::direct::ShardedQueue : public queue::direct::QueueOps<ShardedQueue<T, Lane>, T> {
+public:
+    using lane_type = Lane;
+
+    explicit ShardedQueue(std::size_t lanes = 0, queue::Sweep sweep = queue::Sweep::Affinity);
+    ~ShardedQueue() = default;
+
+    // Prevent copying
+    ShardedQueue(const ShardedQueue& other) = delete;
+    ShardedQueue& operator=(const ShardedQueue& other) = delete;
+
+    template<typename ...Args>
+    void emplace(Args&& ...args);
+    bool dequeue(T& out);
+
+    template<typename InputIt>
+    void enqueue_range(InputIt first, InputIt last);
+
+    template<typename OutputIt>
+    std::size_t dequeue_range(OutputIt& out, std::size_t max);
+
+    std::size_t lane_count() const;
+
+private:
+    //======================================================
+    // One of the lanes, padded to its own cache lines so
+    // producers on neighbouring lanes don't falsely share
+    //======================================================
+    struct Slot {
+        Lane lane;
+        char padding[utility::kCacheLineSize];
+    };
+
+    static std::size_t thread_index();
+
+    Lane& home_lane();
+    std::size_t sweep_start();
+
+    std::unique_ptr<Slot[]> m_pSlots;
+    const std::size_t m_Count;
+    const queue::Sweep m_Sweep;
+};
+
+//==========================================================
+// Direct Sharded Queue definitions
+//==========================================================
+
+//==========================================================
+// Allocates the lanes
+//
+// \param lanes     - The number of lanes, which should be
+//                    the number of producers. Zero means
+//                    one per hardware thread
+// \param sweep     - Where consumers start their sweeps
+//==========================================================
+template<typename T, typename Lane>
+queue::direct::ShardedQueue<T, Lane>::ShardedQueue(std::size_t lanes, queue::Sweep sweep)
+    : m_Count(lanes != 0 ? lanes : std::max(1u, std::thread::hardware_concurrency())),
+      m_Sweep(sweep) {
+    m_pSlots.reset(new Slot[m_Count]);
+}
+
+//==========================================================
+// Returns the calling thread's lane id. Ids are recycled
+// when threads exit, and a new thread takes the lowest free
+// one, so while no more than lane_count() threads that use
+// sharded queues are alive, each has a lane of its own
+//==========================================================
+template<typename T, typename Lane>
+std::size_t queue::direct::ShardedQueue<T, Lane>::thread_index() {
+    return queue::detail::lane_id();
+}
+
+//==========================================================
+// Returns the lane the calling thread enqueues to
+//==========================================================
+template<typename T, typename Lane>
+Lane& queue::direct::ShardedQueue<T, Lane>::home_lane() {
+    return m_pSlots[thread_index() % m_Count].lane;
+}
+
+//==========================================================
+// Returns the lane the calling thread's next sweep starts at
+//==========================================================
+template<typename T, typename Lane>
+std::size_t queue::direct::ShardedQueue<T, Lane>::sweep_start() {
+    if (m_Sweep == queue::Sweep::Random)
+        return utility::backoff::next_random() % m_Count;
+
+    return thread_index() % m_Count;
+}
+
+//==========================================================
+// Enqueues a value constructed from \param{args} to the
+// calling thread's lane
+//==========================================================
+template<typename T, typename Lane>
+template<typename ...Args>
+void queue::direct::ShardedQueue<T, Lane>::emplace(Args&& ...args) {
+    home_lane().emplace(std::forward<Args>(args)...);
+}
+
+//==========================================================
+// Dequeues from the first lane of the sweep that yields a
+// value
+//
+// \param out   - Assigned the dequeued value
+//
+// \return      - False if every lane was empty when the
+//                sweep reached it
+//==========================================================
+template<typename T, typename Lane>
+bool queue::direct::ShardedQueue<T, Lane>::dequeue(T& out) {
+    auto start = sweep_start();
+    for (std::size_t i = 0; i < m_Count; ++i) {
+        if (m_pSlots[(start + i) % m_Count].lane.dequeue(out))
+            return true;
+    }
+
+    return false;
+}
+
+//==========================================================
+// Enqueues the values in [first, last) to the calling
+// thread's lane, in one bulk operation of the lane's
+//
+// \param first   - The first value to enqueue
+// \param last    - One past the last value, after first
+//==========================================================
+template<typename T, typename Lane>
+template<typename InputIt>
+void queue::direct::ShardedQueue<T, Lane>::enqueue_range(InputIt first, InputIt last) {
+    home_lane().enqueue_range(first, last);
+}
+
+//==========================================================
+// Drains up to \param{max} values, taking all it can from
+// each lane of the sweep before it moves to the next, so a
+// consumer stays on one lane's nodes for the whole batch
+//
+// \param out     - Assigned the dequeued values, and
+//                  advanced past them
+// \param max     - The most values to dequeue
+//
+// \return        - The number of values that were dequeued
+//==========================================================
+template<typename T, typename Lane>
+template<typename OutputIt>
+std::size_t queue::direct::ShardedQueue<T, Lane>::dequeue_range(OutputIt& out, std::size_t max) {
+    std::size_t count = 0;
+    auto start = sweep_start();
+    for (std::size_t i = 0; i < m_Count && count < max; ++i)
+        count += m_pSlots[(start + i) % m_Count].lane.dequeue_range(out, max - count);
+
+    return count;
+}
+
+//==========================================================
+// Returns the number of lanes
+//==========================================================
+template<typename T, typename Lane>
+std::size_t queue::direct::ShardedQueue<T, Lane>::lane_count() const {
+    return m_Count;
+}
+
+//==========================================================
+// Sharded Queue class definitions
+//==========================================================
+
+//==========================================================
+// Allocates the lanes, see direct::ShardedQueue
+//==========================================================
+template<typename T, typename Lane>
+queue::ShardedQueue<T, Lane>::ShardedQueue(std::size_t lanes, queue::Sweep sweep)
+    : m_pImpl(utility::make_unique<Impl>(lanes, sweep)) {}
+
+//==========================================================
+// Destructs the ShardedQueue, freeing all allocated memory
+//==========================================================
+template<typename T, typename Lane>
+queue::ShardedQueue<T, Lane>::~ShardedQueue() {
+    // This automatically calls the dstor of Impl
+}
+
+//==========================================================
+// Defines the move constructor
+//
+// \param other     The other queue to move into this one
+//==========================================================
+template<typename T, typename Lane>
+queue::ShardedQueue<T, Lane>::ShardedQueue(ShardedQueue && other)
+    : m_pImpl{ std::move(other.m_pImpl) }
+{}
+
+//==========================================================
+// Defines the move assignment operator
+//
+// \param other     The other queue to move into this one
+//==========================================================
+template<typename T, typename Lane>
+queue::ShardedQueue<T, Lane>& queue::ShardedQueue<T, Lane>::operator=(ShardedQueue && other) {
+    if (this != &other)
+        m_pImpl = std::move(other.m_pImpl);
+
+    return *this;
+}
+
+//==========================================================
+// This enqueues the value to the calling thread's lane
+//
+// \param value   - The value to move into the queue
+//==========================================================
+template<typename T, typename Lane>
+void queue::ShardedQueue<T, Lane>::enqueue(T&& value) {
+    m_pImpl->emplace(std::move(value));
+}
+
+//==========================================================
+// This enqueues a value constructed in place in the calling
+// thread's lane
+//
+// \param args    - The arguments to construct the value with
+//==========================================================
+template<typename T, typename Lane>
+template<typename ...Args>
+void queue::ShardedQueue<T, Lane>::emplace(Args&& ...args) {
+    m_pImpl->emplace(std::forward<Args>(args)...);
+}
+
+//==========================================================
+// Dequeues from the first lane of the sweep that yields a
+// value
+//
+// \param out   - Assigned the dequeued value
+//
+// \return      - False if every lane looked empty
+//==========================================================
+template<typename T, typename Lane>
+bool queue::ShardedQueue<T, Lane>::dequeue(T& out) {
+    return m_pImpl->dequeue(out);
+}
+
+//==========================================================
+// Returns the number of lanes
+//==========================================================
+template<typename T, typename Lane>
+std::size_t queue::ShardedQueue<T, Lane>::lane_count() const {
+    return m_pImpl->lane_count();
+}
+
+//==========================================================
+// This enqueues the values in [first, last) to the calling
+// thread's lane at once
+//
+// \param first   - The first value to enqueue
+// \param last    - One past the last value
+//==========================================================
+template<typename T, typename Lane>
+void queue::ShardedQueue<T, Lane>::enqueue_range(utility::ErasedInput<T> first, utility::ErasedInput<T> last) {
+    m_pImpl->enqueue_range(first, last);
+}
+
+//==========================================================
+// This drains up to \param{max} values, lane by lane
+//
+// \param out     - Assigned the dequeued values
+// \param max     - The most values to dequeue
+//
+// \return        - The number of values that were dequeued
+//==========================================================
+template<typename T, typename Lane>
+std::size_t queue::ShardedQueue<T, Lane>::dequeue_range(utility::ErasedOutput<T>& out, std::size_t max) {
+    return m_pImpl->dequeue_range(out, max);
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include "../queue/queue.h"
+
+#include <memory>
+#include <cstddef>
+
+namespace queue {
+
+namespace direct {
+template<typename T>
+class SpscQueue;
+}
+
+//==========================================================
+// Represents a bounded ring queue for exactly one producer
+// thread and one consumer thread. Each side owns its index
+// and keeps a cached copy of the other side's, so the shared
+// indices are only read when the cached copy says the ring
+// is full or empty. No operation needs a CAS; every one
+// completes in a bounded number of steps
+//==========================================================
+template<typename T>
+class SpscQueue : public queue::QueueBase<T> {
+public:
+    static constexpr std::size_t kDefaultCapacity = 1 << 16;
+
+    explicit SpscQueue(std::size_t capacity = kDefaultCapacity);
+    ~SpscQueue();
+
+    // Move operations
+    SpscQueue(SpscQueue&& other);
+    SpscQueue& operator=(SpscQueue&& other);
+
+    // Prevent copying
+    SpscQueue(const SpscQueue& other) = delete;
+    SpscQueue& operator=(const SpscQueue& other) = delete;
+
+    // inherited from queue::QueueBase
+    using queue::QueueBase<T>::enqueue;
+    using queue::QueueBase<T>::try_enqueue;
+    virtual void enqueue(T&& value) override;
+    virtual bool dequeue(T& out) override;
+    virtual bool try_enqueue(T&& value) override;
+
+    std::size_t capacity() const;
+
+private:
+    using Impl = queue::direct::SpscQueue<T>;
+    std::unique_ptr<Impl> m_pImpl;
+};
+}  // namespace queue
+
+#include "../queue/spsc_queue_impl.h"
@@ -0,0 +1,261 @@
+#pragma once
+
+#include "../queue/spsc_queue.h"
+#include "../queue/bounded_queue.h"
+#include "../../utility/memory.h"
+#include "../../utility/cache_line.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cstddef>
+
+//==========================================================
+// Represents the single-producer/single-consumer ring queue,
+// with every operation dispatched statically
+//==========================================================
+template<typename T>
+class queue::direct::SpscQueue : public queue::direct::QueueOps<SpscQueue<T>, T> {
+public:
+    static constexpr std::size_t kDefaultCapacity = queue::SpscQueue<T>::kDefaultCapacity;
+
+    explicit SpscQueue(std::size_t capacity = kDefaultCapacity);
+    ~SpscQueue() = default;
+
+    // Prevent copying
+    SpscQueue(const SpscQueue& other) = delete;
+    SpscQueue& operator=(const SpscQueue& other) = delete;
+
+    using queue::direct::QueueOps<SpscQueue<T>, T>::enqueue;
+    using queue::direct::QueueOps<SpscQueue<T>, T>::try_enqueue;
+    void enqueue(T&& value);
+    bool try_enqueue(T&& value);
+    bool dequeue(T& out);
+
+    template<typename ...Args>
+    void emplace(Args&& ...args);
+
+    std::size_t capacity() const;
+
+private:
+    const std::size_t m_Mask;
+    std::unique_ptr<T[]> m_pBuffer;
+
+    // Producer state. Only the producer writes to this line
+    char m_Pad0[utility::kCacheLineSize];
+    std::atomic<std::size_t> m_Tail{ 0 };
+    std::size_t m_CachedHead = 0;
+
+    // Consumer state. Only the consumer writes to this line
+    char m_Pad1[utility::kCacheLineSize];
+    std::atomic<std::size_t> m_Head{ 0 };
+    std::size_t m_CachedTail = 0;
+    char m_Pad2[utility::kCacheLineSize];
+};
+
+//==========================================================
+// Direct SPSC Queue definitions
+//==========================================================
+
+template<typename T>
+constexpr std::size_t queue::direct::SpscQueue<T>::kDefaultCapacity;
+
+//==========================================================
+// Allocates the ring
+//
+// \param capacity  - The minimum number of values the queue
+//                    can hold
+//==========================================================
+template<typename T>
+queue::direct::SpscQueue<T>::SpscQueue(std::size_t capacity)
+    : m_Mask(queue::detail::ring_capacity(capacity) - 1),
+      m_pBuffer(new T[m_Mask + 1]) {}
+
+//==========================================================
+// This attempts to enqueue the specified value. It must only
+// be called by the producer thread
+//
+// \param value   - The value to enqueue, which is only moved
+//                  from if there was room
+//
+// \return        - False if the queue is full
+//==========================================================
+template<typename T>
+bool queue::direct::SpscQueue<T>::try_enqueue(T&& value) {
+    auto tail = m_Tail.load(std::memory_order_relaxed);
+
+    if (tail - m_CachedHead > m_Mask) {
+        // The ring looks full, so see how far the consumer has
+        // gotten since we last looked
+        m_CachedHead = m_Head.load(std::memory_order_acquire);
+        if (tail - m_CachedHead > m_Mask)
+            return false;
+    }
+
+    m_pBuffer[tail & m_Mask] = std::move(value);
+
+    // Publish the value to the consumer
+    m_Tail.store(tail + 1, std::memory_order_release);
+
+    return true;
+}
+
+//==========================================================
+// This enqueues the specified value, yielding while the
+// queue is full. It must only be called by the producer
+//
+// \param value   - The value to enqueue
+//==========================================================
+template<typename T>
+void queue::direct::SpscQueue<T>::enqueue(T&& value) {
+    while (!try_enqueue(std::move(value)))
+        std::this_thread::yield();
+}
+
+//==========================================================
+// This enqueues a value constructed from \param{args},
+// yielding while the queue is full. It must only be called
+// by the producer. The ring's cells already hold a value,
+// so it's moved into one
+//
+// \param args    - The arguments to construct the value with
+//==========================================================
+template<typename T>
+template<typename ...Args>
+void queue::direct::SpscQueue<T>::emplace(Args&& ...args) {
+    enqueue(T(std::forward<Args>(args)...));
+}
+
+//==========================================================
+// Returns the number of values the queue can hold
+//==========================================================
+template<typename T>
+std::size_t queue::direct::SpscQueue<T>::capacity() const {
+    return m_Mask + 1;
+}
+
+//==========================================================
+// This attempts to dequeue the front value. It must only be
+// called by the consumer thread
+//
+// \param out   - An output variable that is assigned the
+//                value that was at the front of the queue
+//
+// \return      - False if the queue was empty
+//==========================================================
+template<typename T>
+bool queue::direct::SpscQueue<T>::dequeue(T& out) {
+    auto head = m_Head.load(std::memory_order_relaxed);
+
+    if (head == m_CachedTail) {
+        // The ring looks empty, so see whether the producer has
+        // published anything since we last looked
+        m_CachedTail = m_Tail.load(std::memory_order_acquire);
+        if (head == m_CachedTail)
+            return false;
+    }
+
+    out = std::move(m_pBuffer[head & m_Mask]);
+
+    // Hand the slot back to the producer
+    m_Head.store(head + 1, std::memory_order_release);
+
+    return true;
+}
+
+//==========================================================
+// SPSC Queue class definitions
+//==========================================================
+
+template<typename T>
+constexpr std::size_t queue::SpscQueue<T>::kDefaultCapacity;
+
+//==========================================================
+// Constructs a queue that can hold at least \param{capacity}
+// values
+//
+// \param capacity  - The minimum capacity, which is rounded
+//                    up to a power of two
+//==========================================================
+template<typename T>
+queue::SpscQueue<T>::SpscQueue(std::size_t capacity)
+    : m_pImpl(utility::make_unique<Impl>(capacity)) {}
+
+//==========================================================
+// Destructs the SpscQueue, freeing all allocated memory
+//==========================================================
+template<typename T>
+queue::SpscQueue<T>::~SpscQueue() {
+    // This automatically calls the dstor of Impl
+}
+
+//==========================================================
+// Defines the move constructor
+//
+// \param other     The other queue to move into this one
+//==========================================================
+template<typename T>
+queue::SpscQueue<T>::SpscQueue(SpscQueue && other)
+    : m_pImpl{ std::move(other.m_pImpl) }
+{}
+
+//==========================================================
+// Defines the move assignment operator
+//
+// \param other     The other queue to move into this one
+//==========================================================
+template<typename T>
+queue::SpscQueue<T>& queue::SpscQueue<T>::operator=(SpscQueue && other) {
+    if (this != &other)
+        m_pImpl = std::move(other.m_pImpl);
+
+    return *this;
+}
+
+//==========================================================
+// This enqueues the specified value, yielding while the
+// queue is full. It must only be called by the producer
+//
+// \param value   - The value to enqueue
+//==========================================================
+template<typename T>
+void queue::SpscQueue<T>::enqueue(T&& value) {
+    m_pImpl->enqueue(std::move(value));
+}
+
+//==========================================================
+// This attempts to enqueue the specified value. It must only
+// be called by the producer
+//
+// \param value   - The value to enqueue
+//
+// \return        - False if the queue is full
+//==========================================================
+template<typename T>
+bool queue::SpscQueue<T>::try_enqueue(T&& value) {
+    return m_pImpl->try_enqueue(std::move(value));
+}
+
+//==========================================================
+// This attempts to perform a dequeue operation, which puts
+// the front value into \param{out}, and returns true if the
+// operation was successful. If the queue is empty, then it
+// returns false. It must only be called by the consumer
+//
+// \param out   - An output variable that is assigned the
+//                value that was at the front of the queue
+//
+// \return      - The success of the dequeue operation
+//==========================================================
+template<typename T>
+bool queue::SpscQueue<T>::dequeue(T& out) {
+    return m_pImpl->dequeue(out);
+}
+
+//==========================================================
+// Returns the number of values the queue can hold
+//==========================================================
+template<typename T>
+std::size_t queue::SpscQueue<T>::capacity() const {
+    return m_pImpl->capacity();
+}
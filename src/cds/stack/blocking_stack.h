@@ -0,0 +1,65 @@
+#pragma once
+
+#include "../../utility/wait_strategy.h"
+
+#include <chrono>
+#include <cstddef>
+
+namespace stack {
+
+//==========================================================
+// Adds blocking pops to any of the stacks, polymorphic or
+// direct. Producers notify the wait strategy after each
+// push; consumers that find the stack empty wait on it,
+// according to the strategy, rather than returning false.
+//
+// Stack is the wrapped stack type, and Wait is one of the
+// strategies in utility::wait, see queue::BlockingQueue
+//==========================================================
+template<typename Stack, typename Wait = utility::wait::SpinPark>
+class BlockingStack {
+public:
+    using value_type = typename Stack::value_type;
+    using T = value_type;
+
+    // Constructs the wrapped stack from \param{args}
+    template<typename ...Args>
+    explicit BlockingStack(Args&& ...args);
+
+    // Prevent copying
+    BlockingStack(const BlockingStack& other) = delete;
+    BlockingStack& operator=(const BlockingStack& other) = delete;
+
+    void push(T&& value);
+    void push(const T& value);
+
+    template<typename ...Args>
+    void emplace(Args&& ...args);
+
+    template<typename InputIt>
+    void push_bulk(InputIt first, InputIt last);
+
+    bool pop(T& out);
+
+    template<typename OutputIt>
+    std::size_t pop_all(OutputIt out);
+
+    void wait_pop(T& out);
+
+    template<typename Rep, typename Period>
+    bool wait_pop_for(T& out, const std::chrono::duration<Rep, Period>& timeout);
+
+    template<typename Clock, typename Duration>
+    bool wait_pop_until(T& out, const std::chrono::time_point<Clock, Duration>& deadline);
+
+    // Pushes through the wrapped stack would skip the notify, so
+    // it's only exposed for inspection
+    const Stack& underlying() const { return m_Stack; }
+
+private:
+    Stack m_Stack;
+    Wait m_Wait;
+};
+}  // namespace stack
+
+#include "../stack/blocking_stack_impl.h"
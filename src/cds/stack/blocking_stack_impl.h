@@ -0,0 +1,137 @@
+#pragma once
+
+#include "../stack/blocking_stack.h"
+
+#include <chrono>
+#include <utility>
+
+//==========================================================
+// Blocking Stack class definitions
+//==========================================================
+
+//==========================================================
+// Constructs the wrapped stack
+//
+// \param args    - The arguments to construct the stack with
+//==========================================================
+template<typename Stack, typename Wait>
+template<typename ...Args>
+stack::BlockingStack<Stack, Wait>::BlockingStack(Args&& ...args)
+    : m_Stack(std::forward<Args>(args)...) {}
+
+//==========================================================
+// This pushes the specified value, and wakes a waiting
+// consumer
+//
+// \param value   - The value to move onto the stack
+//==========================================================
+template<typename Stack, typename Wait>
+void stack::BlockingStack<Stack, Wait>::push(T&& value) {
+    m_Stack.push(std::move(value));
+    m_Wait.notify_one();
+}
+
+//==========================================================
+// This pushes a copy of the value, and wakes a waiting
+// consumer
+//
+// \param value   - The value to copy onto the stack
+//==========================================================
+template<typename Stack, typename Wait>
+void stack::BlockingStack<Stack, Wait>::push(const T& value) {
+    m_Stack.push(value);
+    m_Wait.notify_one();
+}
+
+//==========================================================
+// This pushes a value constructed from \param{args}, and
+// wakes a waiting consumer
+//
+// \param args    - The arguments to construct the value with
+//==========================================================
+template<typename Stack, typename Wait>
+template<typename ...Args>
+void stack::BlockingStack<Stack, Wait>::emplace(Args&& ...args) {
+    m_Stack.emplace(std::forward<Args>(args)...);
+    m_Wait.notify_one();
+}
+
+//==========================================================
+// This pushes the values in [first, last), in order, and
+// wakes every waiting consumer
+//
+// \param first   - The first value to push
+// \param last    - One past the last value to push
+//==========================================================
+template<typename Stack, typename Wait>
+template<typename InputIt>
+void stack::BlockingStack<Stack, Wait>::push_bulk(InputIt first, InputIt last) {
+    m_Stack.push_bulk(first, last);
+    m_Wait.notify_all();
+}
+
+//==========================================================
+// This attempts to pop a value without waiting
+//
+// \param out     - Assigned the popped value
+//
+// \return        - False if the stack was empty
+//==========================================================
+template<typename Stack, typename Wait>
+bool stack::BlockingStack<Stack, Wait>::pop(T& out) {
+    return m_Stack.pop(out);
+}
+
+//==========================================================
+// This pops every value on the stack without waiting
+//
+// \param out     - Assigned the popped values
+//
+// \return        - The number of values that were popped
+//==========================================================
+template<typename Stack, typename Wait>
+template<typename OutputIt>
+std::size_t stack::BlockingStack<Stack, Wait>::pop_all(OutputIt out) {
+    return m_Stack.pop_all(out);
+}
+
+//==========================================================
+// This pops a value, waiting for one to be pushed if the
+// stack is empty
+//
+// \param out     - Assigned the popped value
+//==========================================================
+template<typename Stack, typename Wait>
+void stack::BlockingStack<Stack, Wait>::wait_pop(T& out) {
+    m_Wait.wait([&] { return m_Stack.pop(out); });
+}
+
+//==========================================================
+// This pops a value, waiting at most \param{timeout} for one
+// to be pushed if the stack is empty
+//
+// \param out     - Assigned the popped value
+// \param timeout - The longest to wait
+//
+// \return        - False if the wait timed out
+//==========================================================
+template<typename Stack, typename Wait>
+template<typename Rep, typename Period>
+bool stack::BlockingStack<Stack, Wait>::wait_pop_for(T& out, const std::chrono::duration<Rep, Period>& timeout) {
+    return wait_pop_until(out, std::chrono::steady_clock::now() + timeout);
+}
+
+//==========================================================
+// This pops a value, waiting until \param{deadline} for one
+// to be pushed if the stack is empty
+//
+// \param out       - Assigned the popped value
+// \param deadline  - When to stop waiting
+//
+// \return          - False if the wait timed out
+//==========================================================
+template<typename Stack, typename Wait>
+template<typename Clock, typename Duration>
+bool stack::BlockingStack<Stack, Wait>::wait_pop_until(T& out, const std::chrono::time_point<Clock, Duration>& deadline) {
+    return m_Wait.wait_until([&] { return m_Stack.pop(out); }, deadline);
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "../stack/stack.h"
+#include "../stack/lockfree_stack.h"
+#include "../../utility/reclamation.h"
+
+namespace stack {
+
+namespace direct {
+template<typename T, typename Reclaimer = utility::reclaim::HazardPointers>
+class EliminationStack;
+}
+
+//==========================================================
+// This is an implementation of the elimination-backoff stack
+// of Hendler, Shavit and Yerushalmi. It's a Treiber stack
+// whose push and pop back off to an elimination array when
+// their CAS on the top fails: a push waiting in the array
+// hands its value straight to a pop, and neither one touches
+// the top. The array's width and the time a push waits in it
+// adapt to how often eliminations succeed. This is the
+// polymorphic adapter over stack::direct::EliminationStack
+//==========================================================
+template<typename T, typename Reclaimer = utility::reclaim::HazardPointers>
+class EliminationStack : public stack::StackBase<T> {
+public:
+    using reclaimer_type = Reclaimer;
+
+    EliminationStack();
+    ~EliminationStack();
+
+    // Move operations
+    EliminationStack(EliminationStack&& other);
+    EliminationStack& operator=(EliminationStack&& other);
+
+    // Prevent copying
+    EliminationStack(const EliminationStack& other) = delete;
+    EliminationStack& operator=(const EliminationStack& other) = delete;
+
+    // inherited from stack::StackBase
+    using stack::StackBase<T>::push;
+    virtual void push(T&& value) override;
+    virtual bool pop(T& out) override;
+
+    template<typename ...Args>
+    void emplace(Args&& ...args);
+
+protected:
+    // inherited from stack::StackBase
+    virtual void push_range(utility::ErasedInput<T> first, utility::ErasedInput<T> last) override;
+    virtual std::size_t take_all(utility::ErasedOutput<T>& out) override;
+
+private:
+    using Impl = stack::direct::EliminationStack<T, Reclaimer>;
+    std::unique_ptr<Impl> m_pImpl;
+};
+}  // namespace stack
+
+#include "../stack/elimination_stack_impl.h"
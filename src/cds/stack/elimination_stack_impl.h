@@ -0,0 +1,399 @@
+#pragma once
+
+#include "../stack/elimination_stack.h"
+#include "../stack/lockfree_stack.h"
+#include "../stack/lockfree_node.h"
+#include "../../utility/memory.h"
+#include "../../utility/backoff.h"
+#include "../../utility/node_pool.h"
+#include "../../utility/cache_line.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+
+namespace stack { namespace elimination {
+
+// The most slots the elimination array can have
+constexpr std::size_t kMaxSlots = 32;
+
+// The bounds on the number of polls a push waits in a slot
+// for a pop to take its value
+constexpr std::size_t kMinSpins = 16;
+constexpr std::size_t kMaxSpins = 1024;
+
+//==========================================================
+// Returns a random number for the calling thread, used to
+// spread the threads across the array's slots
+//==========================================================
+inline std::uint32_t next_random() {
+    static thread_local std::uint32_t state = static_cast<std::uint32_t>(
+        std::hash<std::thread::id>{}(std::this_thread::get_id())) | 1;
+
+    // xorshift32
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+
+    return state;
+}
+
+}  // namespace elimination
+}  // namespace stack
+
+//==========================================================
+// Represents the elimination-backoff stack, with every
+// operation dispatched statically. It builds directly on the
+// single-attempt push and pop of the Treiber stack
+//==========================================================
+template<typename T, typename Reclaimer>
+class stack::direct::EliminationStack : public stack::direct::StackOps<EliminationStack<T, Reclaimer>, T> {
+public:
+    using reclaimer_type = Reclaimer;
+
+    EliminationStack();
+    ~EliminationStack();
+
+    // Prevent copying
+    EliminationStack(const EliminationStack& other) = delete;
+    EliminationStack& operator=(const EliminationStack& other) = delete;
+
+    template<typename ...Args>
+    void emplace(Args&& ...args);
+    bool pop(T& out);
+
+    template<typename InputIt>
+    void push_range(InputIt first, InputIt last);
+
+    template<typename OutputIt>
+    std::size_t take_all(OutputIt& out);
+
+private:
+    bool eliminate_push(stack::lf::Node<T>* node);
+    bool eliminate_pop(T& out);
+
+    void on_eliminated();
+    void on_timeout();
+
+    using Node = stack::lf::Node<T>;
+    using Core = stack::direct::LockFreeStack<T, Reclaimer>;
+    using Attempt = typename Core::Attempt;
+    using NodePool = utility::NodePool<Node>;
+
+    // A slot holds nothing, a node offered by a waiting push,
+    // or the taken marker once a pop has claimed the offer
+    struct Slot {
+        std::atomic<Node*> offer{ nullptr };
+        char padding[utility::kCacheLineSize - sizeof(std::atomic<Node*>)];
+    };
+
+    // Nodes are at least pointer aligned, so this is never one
+    static Node* taken() { return reinterpret_cast<Node*>(std::uintptr_t{ 1 }); }
+
+    Core m_Stack;
+
+    const std::size_t m_Capacity;
+    std::unique_ptr<Slot[]> m_pSlots;
+
+    // The adaptive width of the array and wait of a push
+    std::atomic<std::size_t> m_Width{ 1 };
+    std::atomic<std::size_t> m_Spins{ stack::elimination::kMinSpins };
+};
+
+//==========================================================
+// Direct Elimination Stack definitions
+//==========================================================
+
+//==========================================================
+// Sizes the elimination array to half of the hardware
+// threads, since each elimination pairs off two of them
+//==========================================================
+template<typename T, typename Reclaimer>
+stack::direct::EliminationStack<T, Reclaimer>::EliminationStack()
+    : m_Capacity(std::max<std::size_t>(1, std::min<std::size_t>(
+          stack::elimination::kMaxSlots, std::thread::hardware_concurrency() / 2))),
+      m_pSlots(new Slot[m_Capacity]) {}
+
+//==========================================================
+// Every push withdraws its offer before returning, so the
+// array holds no nodes by now. The core frees the stack
+//==========================================================
+template<typename T, typename Reclaimer>
+stack::direct::EliminationStack<T, Reclaimer>::~EliminationStack() {}
+
+//==========================================================
+// This pushes a value constructed in a new node, alternating
+// between the top of the stack and the elimination array
+// until one of them takes it
+//
+// \param args    - The arguments to construct the value with
+//==========================================================
+template<typename T, typename Reclaimer>
+template<typename ...Args>
+void stack::direct::EliminationStack<T, Reclaimer>::emplace(Args&& ...args) {
+    auto node = NodePool::create(std::forward<Args>(args)...);
+
+    while (!m_Stack.try_push(node)) {
+        if (eliminate_push(node))
+            return;
+    }
+}
+
+//==========================================================
+// This attempts to pop the stack, alternating between the
+// top of the stack and the elimination array. A pop only
+// fails if it finds the stack empty
+//
+// \param out   - An output variable that is assigned the
+//                value that was at the top of the stack
+//
+// \return      - The success of the pop operation
+//==========================================================
+template<typename T, typename Reclaimer>
+bool stack::direct::EliminationStack<T, Reclaimer>::pop(T& out) {
+    while (true) {
+        auto result = m_Stack.try_pop(out);
+        if (result != Attempt::Contended)
+            return result == Attempt::Popped;
+
+        if (eliminate_pop(out))
+            return true;
+    }
+}
+
+//==========================================================
+// Offers the node in a random slot, and waits for a pop to
+// take it
+//
+// \param node    - The node holding the value being pushed
+//
+// \return        - True if a pop took the value. Otherwise
+//                  the caller still owns the node
+//==========================================================
+template<typename T, typename Reclaimer>
+bool stack::direct::EliminationStack<T, Reclaimer>::eliminate_push(Node* node) {
+    auto width = m_Width.load(std::memory_order_relaxed);
+    auto& slot = m_pSlots[stack::elimination::next_random() % width];
+
+    // Release so that a pop that takes the offer sees the value
+    Node* empty = nullptr;
+    if (!slot.offer.compare_exchange_strong(empty, node, std::memory_order_release, std::memory_order_relaxed))
+        return false;
+
+    auto spins = m_Spins.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < spins; ++i) {
+        if (slot.offer.load(std::memory_order_relaxed) != node)
+            break;
+
+        utility::cpu_relax();
+    }
+
+    // Withdraw the offer, unless a pop took it first
+    auto offered = node;
+    if (slot.offer.compare_exchange_strong(offered, nullptr, std::memory_order_relaxed)) {
+        on_timeout();
+        return false;
+    }
+
+    // The pop owns the node now, so just free up the slot
+    slot.offer.store(nullptr, std::memory_order_relaxed);
+    on_eliminated();
+
+    return true;
+}
+
+//==========================================================
+// Takes the value offered by a push waiting in a random slot
+//
+// \param out   - An output variable that is assigned the
+//                value that was offered
+//
+// \return      - False if the slot held no offer
+//==========================================================
+template<typename T, typename Reclaimer>
+bool stack::direct::EliminationStack<T, Reclaimer>::eliminate_pop(T& out) {
+    auto width = m_Width.load(std::memory_order_relaxed);
+    auto& slot = m_pSlots[stack::elimination::next_random() % width];
+
+    auto node = slot.offer.load(std::memory_order_relaxed);
+    if (node == nullptr || node == taken())
+        return false;
+
+    // The node isn't read until the offer is claimed, so it
+    // doesn't matter if it was withdrawn and offered again
+    if (!slot.offer.compare_exchange_strong(node, taken(), std::memory_order_acquire, std::memory_order_relaxed))
+        return false;
+
+    out = std::move(node->value);
+    NodePool::destroy(node);
+
+    return true;
+}
+
+//==========================================================
+// Eliminations are succeeding, so spread the threads over
+// more slots and let pushes wait longer for a partner
+//==========================================================
+template<typename T, typename Reclaimer>
+void stack::direct::EliminationStack<T, Reclaimer>::on_eliminated() {
+    auto width = m_Width.load(std::memory_order_relaxed);
+    if (width < m_Capacity)
+        m_Width.store(width + 1, std::memory_order_relaxed);
+
+    auto spins = m_Spins.load(std::memory_order_relaxed);
+    if (spins < stack::elimination::kMaxSpins)
+        m_Spins.store(spins * 2, std::memory_order_relaxed);
+}
+
+//==========================================================
+// A push found no partner, so concentrate the threads on
+// fewer slots. Once they're all on one slot, contention is
+// low, so stop making pushes wait as long
+//==========================================================
+template<typename T, typename Reclaimer>
+void stack::direct::EliminationStack<T, Reclaimer>::on_timeout() {
+    auto width = m_Width.load(std::memory_order_relaxed);
+    if (width > 1) {
+        m_Width.store(width - 1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto spins = m_Spins.load(std::memory_order_relaxed);
+    if (spins > stack::elimination::kMinSpins)
+        m_Spins.store(spins / 2, std::memory_order_relaxed);
+}
+
+//==========================================================
+// This pushes the values in [first, last) with a single CAS
+// on the top. Batches aren't offered for elimination
+//
+// \param first   - The first value to push
+// \param last    - One past the last value, after first
+//==========================================================
+template<typename T, typename Reclaimer>
+template<typename InputIt>
+void stack::direct::EliminationStack<T, Reclaimer>::push_range(InputIt first, InputIt last) {
+    m_Stack.push_range(first, last);
+}
+
+//==========================================================
+// This pops every value on the stack with a single CAS
+//
+// \param out   - Assigned the popped values, from the top
+//                down, and advanced past them
+//
+// \return      - The number of values that were popped
+//==========================================================
+template<typename T, typename Reclaimer>
+template<typename OutputIt>
+std::size_t stack::direct::EliminationStack<T, Reclaimer>::take_all(OutputIt& out) {
+    return m_Stack.take_all(out);
+}
+
+//==========================================================
+// Elimination Stack class definitions
+//==========================================================
+
+//==========================================================
+// The default constructor for the EliminationStack class
+//==========================================================
+template<typename T, typename Reclaimer>
+stack::EliminationStack<T, Reclaimer>::EliminationStack()
+    : m_pImpl(utility::make_unique<Impl>()) {}
+
+//==========================================================
+// Destructs the EliminationStack, freeing all allocated
+// memory
+//==========================================================
+template<typename T, typename Reclaimer>
+stack::EliminationStack<T, Reclaimer>::~EliminationStack() {
+    // This automatically calls the dstor of impl
+}
+
+//==========================================================
+// This defines the move assignment operator
+//
+// \param other   - The value to move into this one
+//==========================================================
+template<typename T, typename Reclaimer>
+stack::EliminationStack<T, Reclaimer>& stack::EliminationStack<T, Reclaimer>::operator=(EliminationStack&& other) {
+    if (this != &other)
+        m_pImpl = std::move(other.m_pImpl);
+
+    return *this;
+}
+
+//==========================================================
+// This defines the move constructor
+//
+// \param other   - The value to move into this one
+//==========================================================
+template<typename T, typename Reclaimer>
+stack::EliminationStack<T, Reclaimer>::EliminationStack(EliminationStack && other)
+    : m_pImpl{ std::move(other.m_pImpl) }
+{}
+
+//==========================================================
+// This pushes the specified value onto the stack
+//
+// \param value   - The value to move onto the stack
+//==========================================================
+template<typename T, typename Reclaimer>
+void stack::EliminationStack<T, Reclaimer>::push(T&& value) {
+    m_pImpl->emplace(std::move(value));
+}
+
+//==========================================================
+// This pushes a value constructed in place in its node
+//
+// \param args    - The arguments to construct the value with
+//==========================================================
+template<typename T, typename Reclaimer>
+template<typename ...Args>
+void stack::EliminationStack<T, Reclaimer>::emplace(Args&& ...args) {
+    m_pImpl->emplace(std::forward<Args>(args)...);
+}
+
+//==========================================================
+// This attempts to pop the stack, which puts the top value
+// into \param{out}, and returns true if the operation was
+// successful. If the stack is empty, then it returns false.
+//
+// \param out   - An output variable that is assigned the
+//                value that was at the top of the stack
+//
+// \return      - The success of the pop operation
+//==========================================================
+template<typename T, typename Reclaimer>
+bool stack::EliminationStack<T, Reclaimer>::pop(T& out) {
+    return m_pImpl->pop(out);
+}
+
+//==========================================================
+// This pushes the values in [first, last) with a single CAS
+// on the top. Batches aren't offered for elimination
+//
+// \param first   - The first value to push
+// \param last    - One past the last value
+//==========================================================
+template<typename T, typename Reclaimer>
+void stack::EliminationStack<T, Reclaimer>::push_range(utility::ErasedInput<T> first, utility::ErasedInput<T> last) {
+    m_pImpl->push_range(first, last);
+}
+
+//==========================================================
+// This pops every value on the stack with a single CAS
+//
+// \param out   - Assigned the popped values, from the top
+//                down
+//
+// \return      - The number of values that were popped
+//==========================================================
+template<typename T, typename Reclaimer>
+std::size_t stack::EliminationStack<T, Reclaimer>::take_all(utility::ErasedOutput<T>& out) {
+    return m_pImpl->take_all(out);
+}
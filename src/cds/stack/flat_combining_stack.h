@@ -0,0 +1,46 @@
+#pragma once
+
+#include "../stack/stack.h"
+
+#include <memory>
+
+namespace stack {
+
+namespace direct {
+template<typename T>
+class FlatCombiningStack;
+}
+
+//==========================================================
+// This is a flat combining stack. Threads publish their
+// pushes and pops, and whichever thread holds the combiner
+// lock applies all of them to a sequential vector in one
+// batch, see utility/flat_combining.h. This is the
+// polymorphic adapter over stack::direct::FlatCombiningStack
+//==========================================================
+template<typename T>
+class FlatCombiningStack : public stack::StackBase<T> {
+public:
+    FlatCombiningStack();
+    ~FlatCombiningStack();
+
+    // Move operations
+    FlatCombiningStack(FlatCombiningStack&& other);
+    FlatCombiningStack& operator=(FlatCombiningStack&& other);
+
+    // Prevent copying
+    FlatCombiningStack(const FlatCombiningStack& other) = delete;
+    FlatCombiningStack& operator=(const FlatCombiningStack& other) = delete;
+
+    // inherited from stack::StackBase
+    using stack::StackBase<T>::push;
+    virtual void push(T&& value) override;
+    virtual bool pop(T& out) override;
+
+private:
+    using Impl = stack::direct::FlatCombiningStack<T>;
+    std::unique_ptr<Impl> m_pImpl;
+};
+}  // namespace stack
+
+#include "../stack/flat_combining_stack_impl.h"
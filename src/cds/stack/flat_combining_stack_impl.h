@@ -0,0 +1,168 @@
+#pragma once
+
+#include "../stack/flat_combining_stack.h"
+#include "../../utility/memory.h"
+#include "../../utility/flat_combining.h"
+
+#include <memory>
+#include <vector>
+
+//==========================================================
+// Represents the flat combining stack, with every operation
+// dispatched statically
+//==========================================================
+template<typename T>
+class stack::direct::FlatCombiningStack : public stack::direct::StackOps<FlatCombiningStack<T>, T> {
+public:
+    FlatCombiningStack() = default;
+    ~FlatCombiningStack() = default;
+
+    // Prevent copying
+    FlatCombiningStack(const FlatCombiningStack& other) = delete;
+    FlatCombiningStack& operator=(const FlatCombiningStack& other) = delete;
+
+    template<typename ...Args>
+    void emplace(Args&& ...args);
+    bool pop(T& out);
+
+private:
+    // A published push or pop, and its result
+    struct Op {
+        bool isPush;
+        bool success;
+        T value;
+    };
+
+    void apply(Op& op);
+
+    // Only touched by the combiner
+    std::vector<T> m_Values;
+
+    utility::fc::FlatCombiner<Op> m_Combiner;
+};
+
+//==========================================================
+// Direct Flat Combining Stack definitions
+//==========================================================
+
+//==========================================================
+// Applies a single request to the sequential stack. Only
+// the combiner calls this
+//
+// \param op      - The request, which is assigned its result
+//==========================================================
+template<typename T>
+void stack::direct::FlatCombiningStack<T>::apply(Op& op) {
+    if (op.isPush) {
+        m_Values.push_back(std::move(op.value));
+        op.success = true;
+        return;
+    }
+
+    op.success = !m_Values.empty();
+    if (op.success) {
+        op.value = std::move(m_Values.back());
+        m_Values.pop_back();
+    }
+}
+
+//==========================================================
+// This publishes a push of a value constructed from
+// \param{args}, and waits for a combiner to apply it
+//
+// \param args    - The arguments to construct the value with
+//==========================================================
+template<typename T>
+template<typename ...Args>
+void stack::direct::FlatCombiningStack<T>::emplace(Args&& ...args) {
+    Op op{ true, false, T(std::forward<Args>(args)...) };
+    m_Combiner.execute(op, [this](Op& request) { apply(request); });
+}
+
+//==========================================================
+// This publishes a pop, and waits for a combiner to apply
+// it
+//
+// \param out   - An output variable that is assigned the
+//                value that was at the top of the stack
+//
+// \return      - The success of the pop operation
+//==========================================================
+template<typename T>
+bool stack::direct::FlatCombiningStack<T>::pop(T& out) {
+    Op op{ false, false, T{} };
+    m_Combiner.execute(op, [this](Op& request) { apply(request); });
+
+    if (op.success)
+        out = std::move(op.value);
+
+    return op.success;
+}
+
+//==========================================================
+// Flat Combining Stack class definitions
+//==========================================================
+
+//==========================================================
+// The default constructor for the FlatCombiningStack class
+//==========================================================
+template<typename T>
+stack::FlatCombiningStack<T>::FlatCombiningStack()
+    : m_pImpl(utility::make_unique<Impl>()) {}
+
+//==========================================================
+// Destructs the FlatCombiningStack, freeing all allocated
+// memory
+//==========================================================
+template<typename T>
+stack::FlatCombiningStack<T>::~FlatCombiningStack() {
+    // This automatically calls the dstor of impl
+}
+
+//==========================================================
+// This defines the move assignment operator
+//
+// \param other   - The value to move into this one
+//==========================================================
+template<typename T>
+stack::FlatCombiningStack<T>& stack::FlatCombiningStack<T>::operator=(FlatCombiningStack&& other) {
+    if (this != &other)
+        m_pImpl = std::move(other.m_pImpl);
+
+    return *this;
+}
+
+//==========================================================
+// This defines the move constructor
+//
+// \param other   - The value to move into this one
+//==========================================================
+template<typename T>
+stack::FlatCombiningStack<T>::FlatCombiningStack(FlatCombiningStack && other)
+    : m_pImpl{ std::move(other.m_pImpl) }
+{}
+
+//==========================================================
+// This pushes the specified value onto the stack
+//
+// \param value   - The value to move onto the stack
+//==========================================================
+template<typename T>
+void stack::FlatCombiningStack<T>::push(T&& value) {
+    m_pImpl->emplace(std::move(value));
+}
+
+//==========================================================
+// This attempts to pop the stack, which puts the top value
+// into \param{out}, and returns true if the operation was
+// successful. If the stack is empty, then it returns false.
+//
+// \param out   - An output variable that is assigned the
+//                value that was at the top of the stack
+//
+// \return      - The success of the pop operation
+//==========================================================
+template<typename T>
+bool stack::FlatCombiningStack<T>::pop(T& out) {
+    return m_pImpl->pop(out);
+}
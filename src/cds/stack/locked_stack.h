@@ -4,10 +4,16 @@
 
 namespace stack {
 
+namespace direct {
+template<typename T>
+class LockedStack;
+}
+
 //==========================================================
 // This is an implementation of the Michael and Scott lock-
 // based stack that controls access to the top node using a
-// scoped lock
+// scoped lock. This is the polymorphic adapter over
+// stack::direct::LockedStack
 //==========================================================
 template<typename T>
 class LockedStack : public stack::StackBase<T> {
@@ -23,12 +29,21 @@ public:
     LockedStack(const LockedStack& other) = delete;
     LockedStack& operator=(const LockedStack& other) = delete;
 
-    // inherited from stack::stack_base
-    virtual void push(T value) override;
+    // inherited from stack::StackBase
+    using stack::StackBase<T>::push;
+    virtual void push(T&& value) override;
     virtual bool pop(T& out) override;
 
+    template<typename ...Args>
+    void emplace(Args&& ...args);
+
+protected:
+    // inherited from stack::StackBase
+    virtual void push_range(utility::ErasedInput<T> first, utility::ErasedInput<T> last) override;
+    virtual std::size_t take_all(utility::ErasedOutput<T>& out) override;
+
 private:
-    struct Impl;
+    using Impl = stack::direct::LockedStack<T>;
     std::unique_ptr<Impl> m_pImpl;
 };
 }  // namespace stack
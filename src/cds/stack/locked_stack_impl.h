@@ -3,36 +3,54 @@
 #include "../stack/locked_stack.h"
 #include "../../utility/node.h"
 #include "../../utility/memory.h"
+#include "../../utility/node_pool.h"
+#include "../../utility/instrumentation.h"
 
 #include <memory>
 #include <mutex>
 
 //==========================================================
-// Locked Stack implementation definitions
+// Represents the lock based stack, with every operation
+// dispatched statically and plain, non-polymorphic nodes
 //==========================================================
 template<typename T>
-struct stack::LockedStack<T>::Impl {
-    Impl() = default;
-    ~Impl();
+class stack::direct::LockedStack : public stack::direct::StackOps<LockedStack<T>, T> {
+public:
+    LockedStack() = default;
+    ~LockedStack();
 
     // Prevent copying
-    Impl(const Impl& other) = delete;
-    Impl& operator=(const Impl& other) = delete;
+    LockedStack(const LockedStack& other) = delete;
+    LockedStack& operator=(const LockedStack& other) = delete;
 
-    void push(T value);
+    template<typename ...Args>
+    void emplace(Args&& ...args);
     bool pop(T& out);
 
-    utility::NodeBase<T>* m_pTop;
+    template<typename InputIt>
+    void push_range(InputIt first, InputIt last);
+
+    template<typename OutputIt>
+    std::size_t take_all(OutputIt& out);
+
+private:
+    using Node = utility::Node<T>;
+    using NodePool = utility::NodePool<Node>;
+
+    Node* m_pTop = nullptr;
 
     mutable std::mutex mTopMut;
 };
 
 //==========================================================
-// The destructor for the impl class. Handles all memory
-// cleanup
+// Direct Locked Stack definitions
+//==========================================================
+
+//==========================================================
+// The destructor, which frees every remaining node
 //==========================================================
 template<typename T>
-stack::LockedStack<T>::Impl::~Impl() {
+stack::direct::LockedStack<T>::~LockedStack() {
     // Need to investigate the safety of this..
     auto pIter = m_pTop;
     while (pIter != nullptr) {
@@ -41,22 +59,22 @@ stack::LockedStack<T>::Impl::~Impl() {
         pIter = pIter->get_next();
 
         // delete the previous top
-        top->set_next(nullptr);
-        delete top;
-        top = nullptr;
+        NodePool::destroy(top);
     }
 }
 
 //==========================================================
-// This pushes the specified value onto the stack
+// This pushes a value constructed in a new node
 //
-// \param value   - The value to push onto the stack
+// \param args    - The arguments to construct the value with
 //==========================================================
 template<typename T>
-void stack::LockedStack<T>::Impl::push(T value) {
-    std::lock_guard<std::mutex> lock{ mTopMut };
+template<typename ...Args>
+void stack::direct::LockedStack<T>::emplace(Args&& ...args) {
+    // Allocate outside of the critical section
+    auto node = NodePool::create(std::forward<Args>(args)...);
 
-    auto node = new utility::Node<T>{ value };
+    utility::instrumentation::LockGuard<std::mutex> lock{ mTopMut };
 
     if (m_pTop == nullptr) {
         m_pTop = node;
@@ -77,27 +95,92 @@ void stack::LockedStack<T>::Impl::push(T value) {
 // \return      - The success of the pop operation
 //==========================================================
 template<typename T>
-bool stack::LockedStack<T>::Impl::pop(T& out) {
-    std::lock_guard<std::mutex> lock{ mTopMut };
+bool stack::direct::LockedStack<T>::pop(T& out) {
+    Node* top = nullptr;
+    {
+        utility::instrumentation::LockGuard<std::mutex> lock{ mTopMut };
 
-    if (m_pTop == nullptr)
-        return false;
+        if (m_pTop == nullptr) {
+            utility::instrumentation::count(utility::instrumentation::Counter::EmptyPops);
+            return false;
+        }
 
-    // Retain a temp ref to the old top
-    auto top = m_pTop;
-    out = top->get_value();
+        // Retain a temp ref to the old top
+        top = m_pTop;
+        out = std::move(top->get_value());
 
-    // set the new top
-    m_pTop = m_pTop->get_next();
+        // set the new top
+        m_pTop = m_pTop->get_next();
+    }
 
-    // delete the old top
-    top->set_next(nullptr);
-    delete top;
-    top = nullptr;
+    // delete the old top outside of the critical section
+    NodePool::destroy(top);
 
     return true;
 }
 
+//==========================================================
+// This pushes the values in [first, last), taking the lock
+// once. The nodes are built straight from the iterators and
+// linked outside of the lock
+//
+// \param first   - The first value to push
+// \param last    - One past the last value, after first
+//==========================================================
+template<typename T>
+template<typename InputIt>
+void stack::direct::LockedStack<T>::push_range(InputIt first, InputIt last) {
+    Node* bottom = NodePool::create(*first);
+    auto top = bottom;
+
+    for (++first; first != last; ++first) {
+        auto node = NodePool::create(*first);
+        node->set_next(top);
+        top = node;
+    }
+
+    utility::instrumentation::LockGuard<std::mutex> lock{ mTopMut };
+
+    bottom->set_next(m_pTop);
+    m_pTop = top;
+}
+
+//==========================================================
+// This pops every value on the stack, taking the lock once
+// to detach the whole list
+//
+// \param out   - Assigned the popped values, from the top
+//                down, and advanced past them
+//
+// \return      - The number of values that were popped
+//==========================================================
+template<typename T>
+template<typename OutputIt>
+std::size_t stack::direct::LockedStack<T>::take_all(OutputIt& out) {
+    std::size_t count = 0;
+    Node* top = nullptr;
+    {
+        utility::instrumentation::LockGuard<std::mutex> lock{ mTopMut };
+
+        top = m_pTop;
+        m_pTop = nullptr;
+    }
+
+    // The detached nodes are ours, so free them outside of the
+    // critical section
+    while (top != nullptr) {
+        auto node = top;
+        top = top->get_next();
+
+        *out = std::move(node->get_value());
+        ++out;
+        ++count;
+        NodePool::destroy(node);
+    }
+
+    return count;
+}
+
 //==========================================================
 // Locked Stack class definitions
 //==========================================================
@@ -144,11 +227,22 @@ stack::LockedStack<T>::LockedStack(LockedStack&& other)
 //==========================================================
 // This pushes the specified value onto the stack
 //
-// \param value   - The value to push onto the stack
+// \param value   - The value to move onto the stack
 //==========================================================
 template<typename T>
-void stack::LockedStack<T>::push(T value) {
-    m_pImpl->push(value);
+void stack::LockedStack<T>::push(T&& value) {
+    m_pImpl->emplace(std::move(value));
+}
+
+//==========================================================
+// This pushes a value constructed in place in its node
+//
+// \param args    - The arguments to construct the value with
+//==========================================================
+template<typename T>
+template<typename ...Args>
+void stack::LockedStack<T>::emplace(Args&& ...args) {
+    m_pImpl->emplace(std::forward<Args>(args)...);
 }
 
 //==========================================================
@@ -165,3 +259,28 @@ template<typename T>
 bool stack::LockedStack<T>::pop(T& out) {
     return m_pImpl->pop(out);
 }
+
+//==========================================================
+// This pushes the values in [first, last), taking the lock
+// once
+//
+// \param first   - The first value to push
+// \param last    - One past the last value
+//==========================================================
+template<typename T>
+void stack::LockedStack<T>::push_range(utility::ErasedInput<T> first, utility::ErasedInput<T> last) {
+    m_pImpl->push_range(first, last);
+}
+
+//==========================================================
+// This pops every value on the stack, taking the lock once
+//
+// \param out   - Assigned the popped values, from the top
+//                down
+//
+// \return      - The number of values that were popped
+//==========================================================
+template<typename T>
+std::size_t stack::LockedStack<T>::take_all(utility::ErasedOutput<T>& out) {
+    return m_pImpl->take_all(out);
+}
@@ -1,23 +1,27 @@
 #pragma once
 
+#include "../../utility/tagged_ptr.h"
+
+#include <utility>
+#include <cstddef>
+
 namespace stack { namespace lf {
 template<typename T>
 struct Node;
 
+// A node reference and its ABA counter, see
+// utility/tagged_ptr.h
 template<typename T>
-struct alignas(2 * sizeof(void*)) NodePtr
-{
-    Node<T>* ptr;
-    size_t count;
-
-    NodePtr() = default;
-    NodePtr(Node<T>* p, size_t c)
-        : ptr(std::move(p)), count(c) {}
-};
+using NodePtr = utility::TaggedPtr<Node<T>>;
 
 template<typename T>
 struct Node
 {
+    // Constructs the value in place from \param{args}
+    template<typename ...Args>
+    explicit Node(Args&& ...args)
+        : value(std::forward<Args>(args)...), next(nullptr, 0) {}
+
     T value;
     NodePtr<T> next;
 };
@@ -1,17 +1,36 @@
 #pragma once
 
 #include "../stack/stack.h"
+#include "../../utility/backoff.h"
+#include "../../utility/reclamation.h"
 
 namespace stack {
 
+namespace direct {
+template<typename T, typename Reclaimer = utility::reclaim::HazardPointers,
+         typename Backoff = utility::backoff::None>
+class LockFreeStack;
+
+template<typename T, typename Reclaimer>
+class EliminationStack;
+}
+
 //==========================================================
 // This is an implementation of the Trieber Stack, which is
 // a lock-free stack algorithm that utilizes compare and swap
-// to atomically swap the top node during pushes and pops
+// to atomically swap the top node during pushes and pops.
+// Popped nodes are freed through the Reclaimer policy, see
+// utility/reclamation.h, and failed CASes are retried after
+// the Backoff policy, see utility/backoff.h. This is the
+// polymorphic adapter over stack::direct::LockFreeStack
 //==========================================================
-template<typename T>
+template<typename T, typename Reclaimer = utility::reclaim::HazardPointers,
+         typename Backoff = utility::backoff::None>
 class LockFreeStack : public stack::StackBase<T> {
 public:
+    using reclaimer_type = Reclaimer;
+    using backoff_type = Backoff;
+
     LockFreeStack();
     ~LockFreeStack();
 
@@ -23,12 +42,21 @@ public:
     LockFreeStack(const LockFreeStack& other) = delete;
     LockFreeStack& operator=(const LockFreeStack& other) = delete;
 
-    // inherited from stack::stack_base
-    virtual void push(T value) override;
+    // inherited from stack::StackBase
+    using stack::StackBase<T>::push;
+    virtual void push(T&& value) override;
     virtual bool pop(T& out) override;
 
+    template<typename ...Args>
+    void emplace(Args&& ...args);
+
+protected:
+    // inherited from stack::StackBase
+    virtual void push_range(utility::ErasedInput<T> first, utility::ErasedInput<T> last) override;
+    virtual std::size_t take_all(utility::ErasedOutput<T>& out) override;
+
 private:
-    struct Impl;
+    using Impl = stack::direct::LockFreeStack<T, Reclaimer, Backoff>;
     std::unique_ptr<Impl> m_pImpl;
 };
 }  // namespace stack
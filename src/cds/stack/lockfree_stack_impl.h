@@ -3,79 +3,102 @@
 #include "../stack/lockfree_stack.h"
 #include "../stack/lockfree_node.h"
 #include "../../utility/memory.h"
+#include "../../utility/backoff.h"
+#include "../../utility/node_pool.h"
+#include "../../utility/instrumentation.h"
+#include "../../utility/reclamation.h"
 
 #include <atomic>
 #include <memory>
 #include <cassert>
 
 //==========================================================
-// Locked Stack implementation definitions
+// Represents the Treiber stack, with every operation
+// dispatched statically
 //==========================================================
-template<typename T>
-struct stack::LockFreeStack<T>::Impl {
-    Impl();
-    ~Impl();
+template<typename T, typename Reclaimer, typename Backoff>
+class stack::direct::LockFreeStack : public stack::direct::StackOps<LockFreeStack<T, Reclaimer, Backoff>, T> {
+public:
+    using reclaimer_type = Reclaimer;
+    using backoff_type = Backoff;
+
+    LockFreeStack();
+    ~LockFreeStack();
 
     // Prevent copying
-    Impl(const Impl& other) = delete;
-    Impl& operator=(const Impl& other) = delete;
+    LockFreeStack(const LockFreeStack& other) = delete;
+    LockFreeStack& operator=(const LockFreeStack& other) = delete;
 
-    void push(T value);
+    template<typename ...Args>
+    void emplace(Args&& ...args);
     bool pop(T& out);
 
+    template<typename InputIt>
+    void push_range(InputIt first, InputIt last);
+
+    template<typename OutputIt>
+    std::size_t take_all(OutputIt& out);
+
+private:
+    // Builds on the single-attempt push and pop
+    friend class stack::direct::EliminationStack<T, Reclaimer>;
+
+    // The outcome of a single attempt to pop the stack
+    enum class Attempt { Popped, Empty, Contended };
+
+    bool try_push(stack::lf::Node<T>* node);
+    Attempt try_pop(T& out);
+    bool try_splice(stack::lf::Node<T>* top, stack::lf::Node<T>* bottom);
+
+    using NodePool = utility::NodePool<stack::lf::Node<T>>;
+
     std::atomic<stack::lf::NodePtr<T>> m_pTop;
 };
 
 //==========================================================
-// The default constructor for the impl struct
+// Direct Lock-Free Stack definitions
+//==========================================================
+
+//==========================================================
+// The default constructor, which starts out empty
 //==========================================================
-template<typename T>
-stack::LockFreeStack<T>::Impl::Impl()
+template<typename T, typename Reclaimer, typename Backoff>
+stack::direct::LockFreeStack<T, Reclaimer, Backoff>::LockFreeStack()
     : m_pTop{} {}
 
 //==========================================================
-// The destructor for the impl class. Handles all memory
-// cleanup
+// The destructor, which frees every remaining node
 //==========================================================
-template<typename T>
-stack::LockFreeStack<T>::Impl::~Impl() {
+template<typename T, typename Reclaimer, typename Backoff>
+stack::direct::LockFreeStack<T, Reclaimer, Backoff>::~LockFreeStack() {
     auto pIter = m_pTop.load(std::memory_order_acquire);
-    while (pIter.ptr != nullptr) {
+    while (pIter.get() != nullptr) {
         // Retain a reference to the current top
         auto top = pIter;
-        pIter = pIter.ptr->next;
+        pIter = pIter.get()->next;
 
         // delete the previous top
-        top.ptr->next.ptr = nullptr;
-        delete top.ptr;
-        top.ptr = nullptr;
+        NodePool::destroy(top.get());
     }
 }
 
 //==========================================================
-// This pushes the specified value onto the stack
+// This pushes a value constructed in a new node
 //
-// \param value   - The value to push onto the stack
-//==========================================================
-template<typename T>
-void stack::LockFreeStack<T>::Impl::push(T value) {
-    auto node = new stack::lf::Node<T>{};
-    node->value = value;
-
-    stack::lf::NodePtr<T> top{};
-    stack::lf::NodePtr<T> wrapper{};
-
-    do
-    {
-        // Repeatedly try to set the new node as the new top
-        // as long as the retrieved value and the current top
-        // aren't equal.
-        top = m_pTop;
-        node->next.ptr = top.ptr;
-        
-        wrapper = stack::lf::NodePtr<T>{ node, top.count + 1 };
-    } 
-    while (!m_pTop.compare_exchange_weak(top, wrapper));
+// \param args    - The arguments to construct the value with
+//==========================================================
+template<typename T, typename Reclaimer, typename Backoff>
+template<typename ...Args>
+void stack::direct::LockFreeStack<T, Reclaimer, Backoff>::emplace(Args&& ...args) {
+    auto node = NodePool::create(std::forward<Args>(args)...);
+
+    // Repeatedly try to set the new node as the new top
+    utility::instrumentation::RetryLoop retries;
+    Backoff backoff;
+    while (!try_push(node)) {
+        retries.failed();
+        backoff();
+    }
 }
 
 //==========================================================
@@ -88,33 +111,169 @@ void stack::LockFreeStack<T>::Impl::push(T value) {
 //
 // \return      - The success of the pop operation
 //==========================================================
-template<typename T>
-bool stack::LockFreeStack<T>::Impl::pop(T& out) {
-    stack::lf::NodePtr<T> top{};
+template<typename T, typename Reclaimer, typename Backoff>
+bool stack::direct::LockFreeStack<T, Reclaimer, Backoff>::pop(T& out) {
+    utility::instrumentation::RetryLoop retries;
+    Backoff backoff;
+
+    // Repeatedly try to swap out the top node
+    auto result = try_pop(out);
+    while (result == Attempt::Contended) {
+        retries.failed();
+        backoff();
+        result = try_pop(out);
+    }
 
-    do
-    {
-        // Repeatedly try to obtain the top node until they're equal,
-        // upon which replace the top node with the next one in the list
-        top = m_pTop;
+    if (result == Attempt::Empty)
+        utility::instrumentation::count(utility::instrumentation::Counter::EmptyPops);
 
-        if (top.ptr == nullptr)
-            return false;
+    return result == Attempt::Popped;
+}
 
-        auto wrapper = stack::lf::NodePtr<T>{
-            top.ptr->next.ptr, top.count + 1 };
+//==========================================================
+// This makes a single attempt to set \param{node} as the
+// new top of the stack
+//
+// \param node    - A node made by NodePool holding the value
+//
+// \return        - False if another thread changed the top
+//                  first
+//==========================================================
+template<typename T, typename Reclaimer, typename Backoff>
+bool stack::direct::LockFreeStack<T, Reclaimer, Backoff>::try_push(stack::lf::Node<T>* node) {
+    return try_splice(node, node);
+}
+
+//==========================================================
+// This pushes the values in [first, last) at once. The
+// nodes are built straight from the iterators and linked to
+// each other privately first, so the whole chain is
+// published by a single CAS on the top
+//
+// \param first   - The first value to push
+// \param last    - One past the last value, after first
+//==========================================================
+template<typename T, typename Reclaimer, typename Backoff>
+template<typename InputIt>
+void stack::direct::LockFreeStack<T, Reclaimer, Backoff>::push_range(InputIt first, InputIt last) {
+    auto bottom = NodePool::create(*first);
+    auto top = bottom;
+
+    for (++first; first != last; ++first) {
+        auto node = NodePool::create(*first);
+        node->next = stack::lf::NodePtr<T>{ top, 0 };
+        top = node;
     }
-    while (!m_pTop.compare_exchange_weak(top, wrapper));
 
-    // Obtain the old top's value and pass it out
-    out = top.ptr->value;
+    utility::instrumentation::RetryLoop retries;
+    Backoff backoff;
+    while (!try_splice(top, bottom)) {
+        retries.failed();
+        backoff();
+    }
+}
 
-    // Delete the old top
-    top.ptr->next.ptr = nullptr;
-    delete top.ptr;
-    top.ptr = nullptr;
+//==========================================================
+// This pops every value on the stack by swapping the top out
+// for null with a single CAS
+//
+// \param out   - Assigned the popped values, from the top
+//                down, and advanced past them
+//
+// \return      - The number of values that were popped
+//==========================================================
+template<typename T, typename Reclaimer, typename Backoff>
+template<typename OutputIt>
+std::size_t stack::direct::LockFreeStack<T, Reclaimer, Backoff>::take_all(OutputIt& out) {
+    std::size_t count = 0;
+    utility::instrumentation::RetryLoop retries;
+    Backoff backoff;
+    auto top = m_pTop.load(std::memory_order_acquire);
+
+    while (true) {
+        if (top.get() == nullptr) {
+            utility::instrumentation::count(utility::instrumentation::Counter::EmptyPops);
+            return 0;
+        }
+
+        auto wrapper = stack::lf::NodePtr<T>{ nullptr, top.count() + 1 };
+        if (utility::instrumentation::cas(m_pTop.compare_exchange_weak(top, wrapper)))
+            break;
 
-    return true;
+        retries.failed();
+        backoff();
+    }
+
+    // The chain is ours now, but poppers that lost the race may
+    // still be reading its first node, so retire every node
+    auto pIter = top.get();
+    while (pIter != nullptr) {
+        auto node = pIter;
+        pIter = pIter->next.get();
+
+        *out = std::move(node->value);
+        ++out;
+        ++count;
+        Reclaimer::retire(node);
+    }
+
+    return count;
+}
+
+//==========================================================
+// This makes a single attempt to put a privately linked
+// chain of nodes on top of the stack
+//
+// \param top     - The node that becomes the new top
+// \param bottom  - The last node of the chain, which is
+//                  linked to the current top
+//
+// \return        - False if another thread changed the top
+//                  first
+//==========================================================
+template<typename T, typename Reclaimer, typename Backoff>
+bool stack::direct::LockFreeStack<T, Reclaimer, Backoff>::try_splice(stack::lf::Node<T>* top, stack::lf::Node<T>* bottom) {
+    auto current = m_pTop.load(std::memory_order_acquire);
+    bottom->next = stack::lf::NodePtr<T>{ current.get(), 0 };
+
+    auto wrapper = stack::lf::NodePtr<T>{ top, current.count() + 1 };
+
+    return utility::instrumentation::cas(m_pTop.compare_exchange_weak(current, wrapper));
+}
+
+//==========================================================
+// This makes a single attempt to pop the stack
+//
+// \param out   - An output variable that is assigned the
+//                value that was at the top of the stack
+//
+// \return      - Popped if \param{out} was assigned, Empty
+//                if the stack was empty, or Contended if
+//                another thread changed the top first
+//==========================================================
+template<typename T, typename Reclaimer, typename Backoff>
+typename stack::direct::LockFreeStack<T, Reclaimer, Backoff>::Attempt
+stack::direct::LockFreeStack<T, Reclaimer, Backoff>::try_pop(T& out) {
+    // The guard keeps the top alive while we read its next pointer
+    typename Reclaimer::Guard guard;
+    auto top = guard.protect(0, m_pTop);
+
+    if (top.get() == nullptr)
+        return Attempt::Empty;
+
+    auto wrapper = stack::lf::NodePtr<T>{ top.get()->next.get(), top.count() + 1 };
+    if (!utility::instrumentation::cas(m_pTop.compare_exchange_weak(top, wrapper)))
+        return Attempt::Contended;
+
+    // Only the thread whose CAS succeeds touches the old top's
+    // value, so move it out
+    out = std::move(top.get()->value);
+
+    // Other poppers may still be reading the old top, so defer
+    // its deletion until they're done with it
+    Reclaimer::retire(top.get());
+
+    return Attempt::Popped;
 }
 
 //==========================================================
@@ -124,15 +283,15 @@ bool stack::LockFreeStack<T>::Impl::pop(T& out) {
 //==========================================================
 // The default constructor for the lockfree_stack class
 //==========================================================
-template<typename T>
-stack::LockFreeStack<T>::LockFreeStack()
+template<typename T, typename Reclaimer, typename Backoff>
+stack::LockFreeStack<T, Reclaimer, Backoff>::LockFreeStack()
     : m_pImpl(utility::make_unique<Impl>()) {}
 
 //==========================================================
 // Destructs the lockfree_stack, freeing all allocated memory
 //==========================================================
-template<typename T>
-stack::LockFreeStack<T>::~LockFreeStack() {
+template<typename T, typename Reclaimer, typename Backoff>
+stack::LockFreeStack<T, Reclaimer, Backoff>::~LockFreeStack() {
     // This automatically calls the dstor of impl
 }
 
@@ -141,8 +300,8 @@ stack::LockFreeStack<T>::~LockFreeStack() {
 //
 // \param other   - The value to move into this one
 //==========================================================
-template<typename T>
-stack::LockFreeStack<T>& stack::LockFreeStack<T>::operator=(LockFreeStack&& other) {
+template<typename T, typename Reclaimer, typename Backoff>
+stack::LockFreeStack<T, Reclaimer, Backoff>& stack::LockFreeStack<T, Reclaimer, Backoff>::operator=(LockFreeStack&& other) {
     if (this != &other)
         m_pImpl = std::move(other.m_pImpl);
 
@@ -154,19 +313,30 @@ stack::LockFreeStack<T>& stack::LockFreeStack<T>::operator=(LockFreeStack&& othe
 //
 // \param other   - The value to move into this one
 //==========================================================
-template<typename T>
-stack::LockFreeStack<T>::LockFreeStack(LockFreeStack && other)
+template<typename T, typename Reclaimer, typename Backoff>
+stack::LockFreeStack<T, Reclaimer, Backoff>::LockFreeStack(LockFreeStack && other)
     : m_pImpl{ std::move(other.m_pImpl) }
 {}
 
 //==========================================================
 // This pushes the specified value onto the stack
 //
-// \param value   - The value to push onto the stack
+// \param value   - The value to move onto the stack
+//==========================================================
+template<typename T, typename Reclaimer, typename Backoff>
+void stack::LockFreeStack<T, Reclaimer, Backoff>::push(T&& value) {
+    m_pImpl->emplace(std::move(value));
+}
+
+//==========================================================
+// This pushes a value constructed in place in its node
+//
+// \param args    - The arguments to construct the value with
 //==========================================================
-template<typename T>
-void stack::LockFreeStack<T>::push(T value) {
-    m_pImpl->push(value);
+template<typename T, typename Reclaimer, typename Backoff>
+template<typename ...Args>
+void stack::LockFreeStack<T, Reclaimer, Backoff>::emplace(Args&& ...args) {
+    m_pImpl->emplace(std::forward<Args>(args)...);
 }
 
 //==========================================================
@@ -179,7 +349,31 @@ void stack::LockFreeStack<T>::push(T value) {
 //
 // \return      - The success of the pop operation
 //==========================================================
-template<typename T>
-bool stack::LockFreeStack<T>::pop(T& out) {
+template<typename T, typename Reclaimer, typename Backoff>
+bool stack::LockFreeStack<T, Reclaimer, Backoff>::pop(T& out) {
     return m_pImpl->pop(out);
 }
+
+//==========================================================
+// This pushes the values in [first, last) with a single CAS
+//
+// \param first   - The first value to push
+// \param last    - One past the last value
+//==========================================================
+template<typename T, typename Reclaimer, typename Backoff>
+void stack::LockFreeStack<T, Reclaimer, Backoff>::push_range(utility::ErasedInput<T> first, utility::ErasedInput<T> last) {
+    m_pImpl->push_range(first, last);
+}
+
+//==========================================================
+// This pops every value on the stack with a single CAS
+//
+// \param out   - Assigned the popped values, from the top
+//                down
+//
+// \return      - The number of values that were popped
+//==========================================================
+template<typename T, typename Reclaimer, typename Backoff>
+std::size_t stack::LockFreeStack<T, Reclaimer, Backoff>::take_all(utility::ErasedOutput<T>& out) {
+    return m_pImpl->take_all(out);
+}
@@ -1,6 +1,10 @@
 #pragma once
 
+#include "../../utility/erased_iterator.h"
+
 #include <memory>
+#include <cstddef>
+#include <utility>
 
 namespace stack {
 
@@ -11,9 +15,162 @@ namespace stack {
 template<typename T>
 class StackBase {
 public:
+    using value_type = T;
+
     virtual ~StackBase() { };
 
-    virtual void push(T value) = 0;
+    virtual void push(T&& value) = 0;
     virtual bool pop(T& out) = 0;
+
+    //==========================================================
+    // Pushes a copy of the value
+    //==========================================================
+    void push(const T& value) {
+        push(T(value));
+    }
+
+    //==========================================================
+    // Pushes a value constructed from \param{args}. Stacks
+    // that store values in nodes construct it in place
+    //==========================================================
+    template<typename ...Args>
+    void emplace(Args&& ...args) {
+        push(T(std::forward<Args>(args)...));
+    }
+
+    //==========================================================
+    // Pushes the values in [first, last), in order, so that
+    // the last value ends up on top. Pass move iterators to
+    // move the values in
+    //
+    // \param first   - The first value to push
+    // \param last    - One past the last value to push
+    //==========================================================
+    template<typename InputIt>
+    void push_bulk(InputIt first, InputIt last) {
+        if (first != last)
+            push_range(utility::ErasedInput<T>(first, last), utility::ErasedInput<T>());
+    }
+
+    //==========================================================
+    // Pops every value on the stack, from the top down
+    //
+    // \param out     - Assigned the popped values
+    //
+    // \return        - The number of values that were popped
+    //==========================================================
+    template<typename OutputIt>
+    std::size_t pop_all(OutputIt out) {
+        utility::ErasedOutput<T> erased(out);
+        return take_all(erased);
+    }
+
+protected:
+    //==========================================================
+    // The hooks behind the bulk operations, which see the
+    // caller's iterators through utility::ErasedInput and
+    // ErasedOutput, so no batch is copied on the way. Stacks
+    // that can publish or detach several values at once
+    // override these; by default they push and pop one value
+    // at a time, so the default take_all may race with
+    // concurrent pushes. push_range is never given an empty
+    // range
+    //==========================================================
+    virtual void push_range(utility::ErasedInput<T> first, utility::ErasedInput<T> last) {
+        for (; first != last; ++first)
+            push(*first);
+    }
+
+    virtual std::size_t take_all(utility::ErasedOutput<T>& out) {
+        std::size_t count = 0;
+        T value{};
+        while (pop(value)) {
+            *out = std::move(value);
+            ++out;
+            ++count;
+        }
+
+        return count;
+    }
+};
+
+namespace direct {
+
+//==========================================================
+// The statically dispatched counterpart of StackBase. Each
+// stack in stack::direct derives from it, naming itself as
+// Derived, and provides:
+//
+//   emplace(args...)   - Pushes a value constructed from the
+//                        arguments
+//   pop(out)           - Pops into out, returning false if
+//                        the stack was empty
+//
+// Stacks that can move several values at once provide their
+// own push_range and take_all
+//==========================================================
+template<typename Derived, typename T>
+class StackOps {
+public:
+    using value_type = T;
+
+    void push(T&& value) {
+        derived().emplace(std::move(value));
+    }
+
+    void push(const T& value) {
+        derived().emplace(value);
+    }
+
+    //==========================================================
+    // Pushes the values in [first, last), in order, see
+    // StackBase::push_bulk
+    //==========================================================
+    template<typename InputIt>
+    void push_bulk(InputIt first, InputIt last) {
+        if (first != last)
+            derived().push_range(first, last);
+    }
+
+    //==========================================================
+    // Pops every value on the stack, from the top down, see
+    // StackBase::pop_all
+    //==========================================================
+    template<typename OutputIt>
+    std::size_t pop_all(OutputIt out) {
+        return derived().take_all(out);
+    }
+
+    //==========================================================
+    // The default bulk hooks, which move one value at a time.
+    // push_range is never given an empty range, and take_all
+    // advances \param{out} past what it wrote
+    //==========================================================
+    template<typename InputIt>
+    void push_range(InputIt first, InputIt last) {
+        for (; first != last; ++first)
+            derived().emplace(*first);
+    }
+
+    template<typename OutputIt>
+    std::size_t take_all(OutputIt& out) {
+        std::size_t count = 0;
+        T value{};
+        while (derived().pop(value)) {
+            *out = std::move(value);
+            ++out;
+            ++count;
+        }
+
+        return count;
+    }
+
+protected:
+    StackOps() = default;
+    ~StackOps() = default;
+
+private:
+    Derived& derived() { return static_cast<Derived&>(*this); }
 };
+}  // namespace direct
 }  // namespace stack
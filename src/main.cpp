@@ -5,6 +5,7 @@
 #include "cds/stack/lockfree_stack.h"
 #include "cds/queue/locked_queue.h"
 #include "cds/queue/lockfree_queue.h"
+#include "cds/queue/spsc_queue.h"
 
 void produceS(stack::StackBase<float>* stack, const float& n)
 { 
@@ -52,8 +53,19 @@ int main()
     t4.join();
     t6.join();
 
+    std::cout << "\n\n";
+
+    auto spsc = new queue::SpscQueue<float>{};
+
+    auto t7 = std::thread{ produceQ, spsc, 10 };
+    auto t8 = std::thread{ consumeQ, spsc };
+
+    t7.join();
+    t8.join();
+
     delete stack;
     delete queue;
+    delete spsc;
 
     std::cin.get();
 }
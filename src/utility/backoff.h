@@ -0,0 +1,176 @@
+#pragma once
+
+#include <thread>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#include <immintrin.h>
+#endif
+
+namespace utility {
+
+//==========================================================
+// Tells the processor that the calling thread is spinning,
+// which frees up resources for its sibling hyperthread and
+// avoids a pipeline flush when the spin ends
+//==========================================================
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    _mm_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile("yield" ::: "memory");
+#endif
+}
+
+//==========================================================
+// Backoff policies for the CAS retry loops of the lock-free
+// structures. A policy is constructed at the start of each
+// operation, and called after every CAS that fails because
+// another thread got there first:
+//
+//   Backoff backoff;
+//   while (!try_cas())
+//       backoff();
+//
+// Backing off spreads the retries out, so the contended line
+// isn't bounced between cores on every attempt
+//==========================================================
+namespace backoff {
+
+// The pauses per retry for the Constant policy
+constexpr std::size_t kConstantPauses = 16;
+
+// The bounds of the randomized backoff window, in pauses. Once
+// the window reaches the upper bound the thread yields instead
+constexpr std::size_t kMinPauses = 4;
+constexpr std::size_t kMaxPauses = 1024;
+
+// The fixed point scale of the Adaptive policy's failure rate,
+// and the most failures a single operation adds to it
+constexpr std::size_t kRateScale = 256;
+constexpr std::size_t kMaxSampled = 16;
+
+//==========================================================
+// Returns a pseudo-random number from the calling thread's
+// xorshift generator. Each thread is seeded differently, so
+// that threads which collided once don't collide again
+//==========================================================
+inline std::uint32_t next_random() {
+    static thread_local std::uint32_t state = 0;
+    if (state == 0) {
+        auto seed = reinterpret_cast<std::uintptr_t>(&state);
+        state = static_cast<std::uint32_t>(seed ^ (seed >> 32)) | 1;
+    }
+
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+//==========================================================
+// Pauses for a random number of iterations in the upper half
+// of [0, \param{window}], or yields if the window is capped
+//==========================================================
+inline void pause_within(std::size_t window) {
+    if (window >= kMaxPauses) {
+        std::this_thread::yield();
+        return;
+    }
+
+    auto pauses = window / 2 + next_random() % (window / 2 + 1);
+    for (std::size_t i = 0; i < pauses; ++i)
+        utility::cpu_relax();
+}
+
+//==========================================================
+// Retries immediately. This was the only behaviour before
+// the policies existed, and it's the baseline they're
+// measured against
+//==========================================================
+struct None {
+    void operator()() {}
+};
+
+//==========================================================
+// Pauses for a fixed number of iterations after every
+// failure
+//==========================================================
+struct Constant {
+    void operator()() {
+        for (std::size_t i = 0; i < kConstantPauses; ++i)
+            utility::cpu_relax();
+    }
+};
+
+//==========================================================
+// Truncated exponential backoff with jitter. Each failure
+// doubles the window, up to kMaxPauses, and the thread
+// pauses for a random part of it
+//==========================================================
+class Exponential {
+public:
+    void operator()() {
+        pause_within(m_Window);
+        m_Window = std::min(m_Window * 2, kMaxPauses);
+    }
+
+private:
+    std::size_t m_Window = kMinPauses;
+};
+
+//==========================================================
+// Exponential backoff whose starting window follows the
+// failure rate the calling thread has recently seen. A
+// thread that keeps losing its CAS starts with a wide
+// window, rather than ramping up from the minimum on every
+// operation; one that rarely loses retries almost at once.
+//
+// The rate is a moving average of the failures per
+// operation, kept per thread so that tracking it adds no
+// shared writes. It's updated when the policy is destroyed
+//==========================================================
+class Adaptive {
+public:
+    Adaptive()
+        : m_Window(start_window()) {}
+
+    ~Adaptive() {
+        // Weigh this operation's failures in at 1/8, in fixed
+        // point with kRateScale per failure
+        auto& rate = failure_rate();
+        auto sample = std::min<std::size_t>(m_Failures, kMaxSampled) * kRateScale;
+        rate = rate - rate / 8 + sample / 8;
+    }
+
+    // Prevent copying
+    Adaptive(const Adaptive& other) = delete;
+    Adaptive& operator=(const Adaptive& other) = delete;
+
+    void operator()() {
+        ++m_Failures;
+        pause_within(m_Window);
+        m_Window = std::min(m_Window * 2, kMaxPauses);
+    }
+
+private:
+    static std::size_t& failure_rate() {
+        static thread_local std::size_t rate = 0;
+        return rate;
+    }
+
+    // Scales the minimum window by one plus the average number
+    // of failures per operation
+    static std::size_t start_window() {
+        auto window = kMinPauses + kMinPauses * failure_rate() / kRateScale;
+        return std::min(window, kMaxPauses);
+    }
+
+    std::size_t m_Window;
+    std::size_t m_Failures = 0;
+};
+
+}  // namespace backoff
+}  // namespace utility
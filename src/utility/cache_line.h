@@ -0,0 +1,12 @@
+#pragma once
+
+#include <cstddef>
+
+namespace utility {
+
+// The size of a cache line on the targets we benchmark on. Members
+// written by different threads are padded apart by this much so
+// they don't falsely share a line
+constexpr std::size_t kCacheLineSize = 64;
+
+}  // namespace utility
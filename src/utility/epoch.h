@@ -0,0 +1,365 @@
+#pragma once
+
+#include "../utility/thread_records.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+namespace utility { namespace epoch {
+
+// The number of retired nodes a thread buffers before it tries
+// to advance the global epoch and free what it can
+constexpr std::size_t kCollectThreshold = 64;
+
+//==========================================================
+// The pinning state of a single thread
+//==========================================================
+struct Record {
+    Record()
+        : state(0), active(true), next(nullptr) {}
+
+    // The epoch the owning thread is pinned in, shifted left by
+    // one with the low bit set, or zero while it isn't pinned
+    std::atomic<std::uint64_t> state;
+    std::atomic<bool> active;
+    Record* next;
+
+    // Keep neighbouring records off of each other's cache line
+    char padding[64];
+};
+
+//==========================================================
+// A retired node tagged with the epoch it was retired in
+//==========================================================
+struct Deferred {
+    Retired node;
+    std::uint64_t epoch;
+};
+
+//==========================================================
+// The process-wide epoch domain. A node retired in epoch e
+// can be freed once the global epoch reaches e + 2, since
+// the epoch only advances when every pinned thread has
+// observed the current one
+//==========================================================
+class Domain {
+public:
+    static Domain& instance();
+
+    ~Domain();
+
+    // Prevent copying
+    Domain(const Domain& other) = delete;
+    Domain& operator=(const Domain& other) = delete;
+
+    Record* acquire() { return m_Records.acquire(); }
+    void release(Record* record);
+
+    std::uint64_t epoch() const { return m_Epoch.load(std::memory_order_acquire); }
+    bool try_advance();
+
+    std::size_t collect(std::vector<Deferred>& deferred);
+    void orphan(std::vector<Deferred>& deferred);
+
+    void account(std::ptrdiff_t delta);
+    std::size_t pending() const;
+
+private:
+    Domain() = default;
+
+    RecordList<Record> m_Records;
+    std::atomic<std::uint64_t> m_Epoch{ 0 };
+    std::atomic<std::ptrdiff_t> m_Pending{ 0 };
+
+    std::mutex m_OrphanMut;
+    std::vector<Deferred> m_Orphans;
+    std::atomic<bool> m_HasOrphans{ false };
+};
+
+//==========================================================
+// The per-thread view of the domain: the thread's record,
+// its pinning depth, and its retired nodes
+//==========================================================
+class ThreadContext {
+public:
+    ThreadContext();
+    ~ThreadContext();
+
+    // Prevent copying
+    ThreadContext(const ThreadContext& other) = delete;
+    ThreadContext& operator=(const ThreadContext& other) = delete;
+
+    void pin();
+    void unpin();
+
+    void retire(void* ptr, void (*reclaim)(void*));
+
+private:
+    void collect();
+
+    Record* m_pRecord;
+    std::size_t m_PinDepth = 0;
+    std::vector<Deferred> m_Deferred;
+    std::size_t m_Reported = 0;
+    std::size_t m_NextCollect = kCollectThreshold;
+};
+
+//==========================================================
+// Returns the calling thread's context, creating it on the
+// thread's first use of the domain
+//==========================================================
+inline ThreadContext& context() {
+    static thread_local ThreadContext ctx;
+    return ctx;
+}
+
+//==========================================================
+// Pins the calling thread to the current epoch for the
+// guard's lifetime. References loaded while pinned stay
+// valid until the guard goes out of scope
+//==========================================================
+class Guard {
+public:
+    Guard()
+        : m_Context(context()) { m_Context.pin(); }
+
+    ~Guard() { m_Context.unpin(); }
+
+    // Prevent copying
+    Guard(const Guard& other) = delete;
+    Guard& operator=(const Guard& other) = delete;
+
+    //==========================================================
+    // Loads the reference. Pinning already protects every node
+    // reachable from it, so there's nothing to publish
+    //==========================================================
+    template<typename Ptr>
+    Ptr protect(std::size_t, const std::atomic<Ptr>& src) {
+        return src.load(std::memory_order_acquire);
+    }
+
+private:
+    ThreadContext& m_Context;
+};
+
+//==========================================================
+// Hands an unlinked node to the calling thread's retire list.
+// The node is freed two epochs after the current one
+//
+// \param node    - The node that was unlinked
+//==========================================================
+template<typename Node>
+void retire(Node* node) {
+    context().retire(node, &utility::destroy_node<Node>);
+}
+
+//==========================================================
+// Domain definitions
+//==========================================================
+
+//==========================================================
+// Returns the process-wide domain
+//==========================================================
+inline Domain& Domain::instance() {
+    static Domain domain;
+    return domain;
+}
+
+//==========================================================
+// Frees any orphaned nodes. This only runs at static
+// destruction, after every thread has exited
+//==========================================================
+inline Domain::~Domain() {
+    for (auto& deferred : m_Orphans)
+        deferred.node.reclaim(deferred.node.ptr);
+}
+
+//==========================================================
+// Unpins the record and makes it available for adoption by
+// another thread
+//
+// \param record  - The record to release
+//==========================================================
+inline void Domain::release(Record* record) {
+    record->state.store(0, std::memory_order_release);
+    m_Records.release(record);
+}
+
+//==========================================================
+// Advances the global epoch if every pinned thread has
+// observed the current one
+//
+// \return      - True if this call advanced the epoch
+//==========================================================
+inline bool Domain::try_advance() {
+    auto current = m_Epoch.load(std::memory_order_relaxed);
+
+    // Pairs with the fence in ThreadContext::pin
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+
+    for (auto pIter = m_Records.head(); pIter != nullptr; pIter = pIter->next) {
+        auto state = pIter->state.load(std::memory_order_relaxed);
+        if ((state & 1) && (state >> 1) != current)
+            return false;
+    }
+
+    return m_Epoch.compare_exchange_strong(current, current + 1);
+}
+
+//==========================================================
+// Frees every node in \param{deferred} that was retired at
+// least two epochs ago
+//
+// \param deferred  - The calling thread's retire list
+//
+// \return          - The number of nodes that were freed
+//==========================================================
+inline std::size_t Domain::collect(std::vector<Deferred>& deferred) {
+    // Adopt the nodes left behind by exited threads
+    if (m_HasOrphans.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock{ m_OrphanMut };
+        deferred.insert(deferred.end(), m_Orphans.begin(), m_Orphans.end());
+        m_Orphans.clear();
+        m_HasOrphans.store(false, std::memory_order_relaxed);
+    }
+
+    auto current = epoch();
+    auto kept = std::partition(deferred.begin(), deferred.end(),
+        [current](const Deferred& item) { return item.epoch + 2 > current; });
+
+    for (auto pIter = kept; pIter != deferred.end(); ++pIter)
+        pIter->node.reclaim(pIter->node.ptr);
+
+    auto freed = static_cast<std::size_t>(deferred.end() - kept);
+    deferred.erase(kept, deferred.end());
+
+    return freed;
+}
+
+//==========================================================
+// Takes ownership of the nodes an exiting thread couldn't
+// free, so that the next collection by any thread frees them
+//
+// \param deferred  - The exiting thread's retire list
+//==========================================================
+inline void Domain::orphan(std::vector<Deferred>& deferred) {
+    if (deferred.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock{ m_OrphanMut };
+    m_Orphans.insert(m_Orphans.end(), deferred.begin(), deferred.end());
+    m_HasOrphans.store(true, std::memory_order_relaxed);
+    deferred.clear();
+}
+
+//==========================================================
+// Adjusts the count of retired nodes awaiting reclamation
+//
+// \param delta   - The number of nodes retired (positive) or
+//                  freed (negative) since the last update
+//==========================================================
+inline void Domain::account(std::ptrdiff_t delta) {
+    m_Pending.fetch_add(delta, std::memory_order_relaxed);
+}
+
+//==========================================================
+// Returns the number of retired nodes awaiting reclamation,
+// as of each thread's most recent collection
+//==========================================================
+inline std::size_t Domain::pending() const {
+    auto pending = m_Pending.load(std::memory_order_relaxed);
+    return pending > 0 ? static_cast<std::size_t>(pending) : 0;
+}
+
+//==========================================================
+// ThreadContext definitions
+//==========================================================
+
+//==========================================================
+// Acquires a record for the calling thread
+//==========================================================
+inline ThreadContext::ThreadContext()
+    : m_pRecord(Domain::instance().acquire()) {}
+
+//==========================================================
+// Releases the thread's record, and frees or orphans the
+// nodes still on its retire list
+//==========================================================
+inline ThreadContext::~ThreadContext() {
+    Domain::instance().release(m_pRecord);
+
+    // Nodes age out after two advances, and this thread no
+    // longer holds the epoch back
+    if (!m_Deferred.empty()) {
+        Domain::instance().try_advance();
+        Domain::instance().try_advance();
+        collect();
+    }
+
+    Domain::instance().orphan(m_Deferred);
+}
+
+//==========================================================
+// Pins the thread to the current epoch. Nested pins are
+// folded into the outermost one
+//==========================================================
+inline void ThreadContext::pin() {
+    if (m_PinDepth++ != 0)
+        return;
+
+    auto current = Domain::instance().epoch();
+    m_pRecord->state.store((current << 1) | 1, std::memory_order_relaxed);
+
+    // Make the pin visible before any reference is loaded
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+}
+
+//==========================================================
+// Unpins the thread once the outermost guard is released
+//==========================================================
+inline void ThreadContext::unpin() {
+    if (--m_PinDepth == 0)
+        m_pRecord->state.store(0, std::memory_order_release);
+}
+
+//==========================================================
+// Tags a node with the current epoch and adds it to the
+// thread's retire list. Once the list is long enough, try to
+// advance the epoch and free the nodes that have aged out.
+// The threshold doubles with the nodes a collection leaves
+// behind, which keeps the cost amortized to O(1) per retire
+//
+// \param ptr       - The unlinked node
+// \param reclaim   - The function that frees the node
+//==========================================================
+inline void ThreadContext::retire(void* ptr, void (*reclaim)(void*)) {
+    m_Deferred.push_back(Deferred{ Retired{ ptr, reclaim }, Domain::instance().epoch() });
+
+    if (m_Deferred.size() >= m_NextCollect) {
+        Domain::instance().try_advance();
+        collect();
+
+        m_NextCollect = std::max(kCollectThreshold, 2 * m_Deferred.size());
+    }
+}
+
+//==========================================================
+// Frees the thread's aged-out nodes, and reports the change
+// in the number of nodes awaiting reclamation to the domain
+//==========================================================
+inline void ThreadContext::collect() {
+    auto& domain = Domain::instance();
+    domain.account(static_cast<std::ptrdiff_t>(m_Deferred.size() - m_Reported));
+
+    auto freed = domain.collect(m_Deferred);
+    domain.account(-static_cast<std::ptrdiff_t>(freed));
+
+    m_Reported = m_Deferred.size();
+}
+
+}  // namespace epoch
+}  // namespace utility
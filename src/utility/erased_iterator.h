@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <iterator>
+#include <type_traits>
+
+namespace utility {
+
+//==========================================================
+// A single-pass input iterator over a caller's [first,
+// last), with the type of the caller's iterators erased, so
+// that a range can be handed to a virtual function without
+// copying it. Each element must be read once, and before
+// the iterator is advanced past it. A default constructed
+// ErasedInput is the end of every range
+//==========================================================
+template<typename T>
+class ErasedInput {
+public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = T*;
+    using reference = T;
+
+    ErasedInput() = default;
+
+    //======================================================
+    // Refers to the caller's iterators, which must outlive
+    // this and every copy of it
+    //
+    // \param first   - The caller's first iterator, which
+    //                  this advances
+    // \param last    - The caller's last iterator
+    //======================================================
+    template<typename InputIt>
+    ErasedInput(InputIt& first, const InputIt& last)
+        : m_pFirst(&first), m_pLast(&last),
+          m_Read(&read<InputIt>), m_Advance(&advance<InputIt>), m_Done(&done<InputIt>) {}
+
+    T operator*() const { return m_Read(m_pFirst); }
+
+    ErasedInput& operator++() {
+        m_Advance(m_pFirst);
+        return *this;
+    }
+
+    bool operator==(const ErasedInput& other) const { return at_end() == other.at_end(); }
+    bool operator!=(const ErasedInput& other) const { return !(*this == other); }
+
+private:
+    bool at_end() const { return m_pFirst == nullptr || m_Done(m_pFirst, m_pLast); }
+
+    template<typename InputIt>
+    static T read(void* pFirst) { return T(**static_cast<InputIt*>(pFirst)); }
+
+    template<typename InputIt>
+    static void advance(void* pFirst) { ++*static_cast<InputIt*>(pFirst); }
+
+    template<typename InputIt>
+    static bool done(void* pFirst, const void* pLast) {
+        return *static_cast<InputIt*>(pFirst) == *static_cast<const InputIt*>(pLast);
+    }
+
+    void* m_pFirst = nullptr;
+    const void* m_pLast = nullptr;
+
+    T (*m_Read)(void*) = nullptr;
+    void (*m_Advance)(void*) = nullptr;
+    bool (*m_Done)(void*, const void*) = nullptr;
+};
+
+//==========================================================
+// An output iterator that moves each value assigned through
+// it into a caller's output iterator, and advances that, so
+// that the caller's iterator type doesn't have to be known
+// to a virtual function. Copies share the caller's iterator
+//==========================================================
+template<typename T>
+class ErasedOutput {
+public:
+    using iterator_category = std::output_iterator_tag;
+    using value_type = void;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = void;
+
+    //======================================================
+    // Refers to the caller's iterator, which must outlive
+    // this and every copy of it
+    //
+    // \param out     - The caller's output iterator
+    //======================================================
+    template<typename OutputIt,
+             typename = typename std::enable_if<!std::is_same<OutputIt, ErasedOutput>::value>::type>
+    explicit ErasedOutput(OutputIt& out)
+        : m_pOut(&out), m_Write(&write<OutputIt>) {}
+
+    ErasedOutput& operator*() { return *this; }
+    ErasedOutput& operator++() { return *this; }
+    ErasedOutput& operator++(int) { return *this; }
+
+    ErasedOutput& operator=(T&& value) {
+        m_Write(m_pOut, std::move(value));
+        return *this;
+    }
+
+private:
+    template<typename OutputIt>
+    static void write(void* pOut, T&& value) {
+        auto& out = *static_cast<OutputIt*>(pOut);
+        *out = std::move(value);
+        ++out;
+    }
+
+    void* m_pOut;
+    void (*m_Write)(void*, T&&);
+};
+
+}  // namespace utility
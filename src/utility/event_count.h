@@ -0,0 +1,238 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <ctime>
+#include <climits>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+#else
+#include <mutex>
+#include <condition_variable>
+#endif
+
+namespace utility {
+
+//==========================================================
+// An eventcount: lets a thread sleep until some condition
+// that it polls for becomes true, without the threads that
+// make it true taking a lock. A waiter follows the protocol
+//
+//   auto key = ec.prepare_wait();
+//   if (condition()) ec.cancel_wait();
+//   else             ec.wait(key);
+//
+// and a notifier makes the condition true, then calls
+// notify_one() or notify_all(). Notifying is a fence and a
+// load while no thread is waiting; only when one is does the
+// notifier bump the epoch and issue a syscall.
+//
+// On Linux, waiters park on a futex over the epoch. Other
+// platforms fall back to a mutex and condition variable
+//==========================================================
+class EventCount {
+public:
+    using Key = std::uint32_t;
+
+    EventCount() = default;
+
+    // Prevent copying
+    EventCount(const EventCount& other) = delete;
+    EventCount& operator=(const EventCount& other) = delete;
+
+    Key prepare_wait();
+    void cancel_wait();
+
+    void wait(Key key);
+
+    template<typename Clock, typename Duration>
+    bool wait_until(Key key, const std::chrono::time_point<Clock, Duration>& deadline);
+
+    void notify_one();
+    void notify_all();
+
+private:
+    void notify(bool all);
+
+    // Bumped by every notification that finds a waiter. It's
+    // the futex word, so it has to be exactly 32 bits wide
+    std::atomic<std::uint32_t> m_Epoch{ 0 };
+
+    // The number of threads between prepare_wait() and the end
+    // of their wait
+    std::atomic<std::uint32_t> m_Waiters{ 0 };
+
+#if !defined(__linux__)
+    std::mutex m_Mut;
+    std::condition_variable m_Cond;
+#endif
+};
+
+#if defined(__linux__)
+
+namespace futex {
+
+//==========================================================
+// Sleeps while \param{word} holds \param{expected}, for at
+// most \param{timeout} if it's given. Returns early on a
+// wake up, a signal, or if the word has already changed
+//==========================================================
+inline void wait(std::atomic<std::uint32_t>& word, std::uint32_t expected,
+                 const timespec* timeout = nullptr) {
+    static_assert(sizeof(std::atomic<std::uint32_t>) == sizeof(std::uint32_t),
+        "The futex word must be a plain 32 bit integer");
+
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+        FUTEX_WAIT_PRIVATE, expected, timeout, nullptr, 0);
+}
+
+//==========================================================
+// Wakes up to \param{count} threads sleeping on \param{word}
+//==========================================================
+inline void wake(std::atomic<std::uint32_t>& word, int count) {
+    ::syscall(SYS_futex, reinterpret_cast<std::uint32_t*>(&word),
+        FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
+}
+
+}  // namespace futex
+
+#endif
+
+//==========================================================
+// Announces that the calling thread is about to wait. The
+// caller must check its condition again before waiting: a
+// notification that raced with the first check is only seen
+// by that second one
+//
+// \return        - The key to pass to wait()
+//==========================================================
+inline EventCount::Key EventCount::prepare_wait() {
+    m_Waiters.fetch_add(1, std::memory_order_seq_cst);
+    auto key = m_Epoch.load(std::memory_order_seq_cst);
+
+    // Pairs with the fence in notify(): either the notifier
+    // sees this waiter, or the caller's recheck sees the
+    // notifier's update
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    return key;
+}
+
+//==========================================================
+// Withdraws a prepare_wait() whose recheck succeeded
+//==========================================================
+inline void EventCount::cancel_wait() {
+    m_Waiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+//==========================================================
+// Sleeps until a notification after the matching
+// prepare_wait(). Returns immediately if one already came
+//
+// \param key     - The key returned by prepare_wait()
+//==========================================================
+inline void EventCount::wait(Key key) {
+#if defined(__linux__)
+    while (m_Epoch.load(std::memory_order_acquire) == key)
+        futex::wait(m_Epoch, key);
+#else
+    {
+        std::unique_lock<std::mutex> lock{ m_Mut };
+        m_Cond.wait(lock, [&] { return m_Epoch.load(std::memory_order_acquire) != key; });
+    }
+#endif
+
+    m_Waiters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+//==========================================================
+// Like wait(), but gives up at \param{deadline}
+//
+// \param key       - The key returned by prepare_wait()
+// \param deadline  - When to stop waiting
+//
+// \return          - False if the deadline passed first
+//==========================================================
+template<typename Clock, typename Duration>
+bool EventCount::wait_until(Key key, const std::chrono::time_point<Clock, Duration>& deadline) {
+    bool notified = true;
+
+#if defined(__linux__)
+    while (m_Epoch.load(std::memory_order_acquire) == key) {
+        auto remaining = deadline - Clock::now();
+        if (remaining <= Duration::zero()) {
+            notified = false;
+            break;
+        }
+
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(remaining).count();
+        if (ns <= 0)
+            ns = 1;
+
+        timespec timeout{};
+        timeout.tv_sec = static_cast<time_t>(ns / 1000000000);
+        timeout.tv_nsec = static_cast<long>(ns % 1000000000);
+
+        futex::wait(m_Epoch, key, &timeout);
+    }
+#else
+    {
+        std::unique_lock<std::mutex> lock{ m_Mut };
+        notified = m_Cond.wait_until(lock, deadline,
+            [&] { return m_Epoch.load(std::memory_order_acquire) != key; });
+    }
+#endif
+
+    m_Waiters.fetch_sub(1, std::memory_order_relaxed);
+    return notified;
+}
+
+//==========================================================
+// Wakes one waiting thread, if there is one
+//==========================================================
+inline void EventCount::notify_one() {
+    notify(false);
+}
+
+//==========================================================
+// Wakes every waiting thread
+//==========================================================
+inline void EventCount::notify_all() {
+    notify(true);
+}
+
+//==========================================================
+// Bumps the epoch and wakes waiters, skipping both when no
+// thread has announced that it's waiting
+//
+// \param all     - Wake every waiter rather than just one
+//==========================================================
+inline void EventCount::notify(bool all) {
+    // Orders the caller's update before the waiter count load,
+    // see prepare_wait()
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (m_Waiters.load(std::memory_order_relaxed) == 0)
+        return;
+
+#if defined(__linux__)
+    m_Epoch.fetch_add(1, std::memory_order_release);
+    futex::wake(m_Epoch, all ? INT_MAX : 1);
+#else
+    {
+        // Bumping the epoch under the lock keeps it from landing
+        // between a waiter's check and its sleep
+        std::lock_guard<std::mutex> lock{ m_Mut };
+        m_Epoch.fetch_add(1, std::memory_order_release);
+    }
+
+    if (all)
+        m_Cond.notify_all();
+    else
+        m_Cond.notify_one();
+#endif
+}
+
+}  // namespace utility
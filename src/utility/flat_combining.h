@@ -0,0 +1,192 @@
+#pragma once
+
+#include "../utility/cache_line.h"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <cstddef>
+#include <utility>
+
+namespace utility { namespace fc {
+
+// The number of publication records in each combiner. More threads
+// than this can use a combiner; they just take turns for a record
+constexpr std::size_t kPublicationSlots = 128;
+
+// The most times the combiner scans the publication list while it
+// holds the lock, as long as each scan finds new requests
+constexpr std::size_t kCombiningPasses = 3;
+
+// The number of polls a waiting thread makes before it yields
+constexpr std::size_t kSpinsBeforeYield = 64;
+
+//==========================================================
+// Returns a small, process-unique id for the calling thread,
+// used to pick the thread's preferred publication record
+//==========================================================
+inline std::size_t thread_id() {
+    static std::atomic<std::size_t> next{ 0 };
+    static thread_local std::size_t id = next.fetch_add(1, std::memory_order_relaxed);
+    return id;
+}
+
+//==========================================================
+// The flat combining synchronization scheme of Hendler,
+// Incze, Shavit and Tzafrir. A thread publishes its request
+// in a publication record, and then either becomes the
+// combiner by taking the lock, or waits for the current
+// combiner to serve it. The combiner applies every published
+// request to the sequential structure in one pass, so the
+// structure stays in the combiner's cache and the lock
+// changes hands once per batch instead of once per request.
+//
+// Op holds a request and its result. Records are borrowed
+// for the length of one request; a thread's preferred record
+// is almost always free, so claiming it doesn't contend
+//==========================================================
+template<typename Op>
+class FlatCombiner {
+public:
+    FlatCombiner();
+
+    // Prevent copying
+    FlatCombiner(const FlatCombiner& other) = delete;
+    FlatCombiner& operator=(const FlatCombiner& other) = delete;
+
+    template<typename Apply>
+    void execute(Op& op, Apply apply);
+
+private:
+    enum State { Idle, Pending, Done };
+
+    struct Record {
+        std::atomic<bool> owned{ false };
+        std::atomic<int> state{ Idle };
+        Op op;
+
+        // Keep neighbouring records off of each other's cache line
+        char padding[utility::kCacheLineSize];
+    };
+
+    Record& claim();
+
+    template<typename Apply>
+    void combine(Apply& apply);
+
+    std::unique_ptr<Record[]> m_pRecords;
+
+    // One past the highest record ever claimed, which bounds the
+    // combiner's scan
+    std::atomic<std::size_t> m_Used{ 0 };
+
+    char m_Pad0[utility::kCacheLineSize];
+    std::atomic<bool> m_Locked{ false };
+    char m_Pad1[utility::kCacheLineSize];
+};
+
+//==========================================================
+// Allocates the publication records
+//==========================================================
+template<typename Op>
+FlatCombiner<Op>::FlatCombiner()
+    : m_pRecords(new Record[kPublicationSlots]) {}
+
+//==========================================================
+// Publishes the request, and returns once it has been
+// applied, either by the calling thread as the combiner or
+// by another thread
+//
+// \param op      - The request. It's assigned the result
+// \param apply   - Applies a request to the sequential
+//                  structure. Only called under the lock
+//==========================================================
+template<typename Op>
+template<typename Apply>
+void FlatCombiner<Op>::execute(Op& op, Apply apply) {
+    auto& record = claim();
+
+    record.op = std::move(op);
+    record.state.store(Pending, std::memory_order_release);
+
+    std::size_t spins = 0;
+    while (record.state.load(std::memory_order_acquire) != Done) {
+        if (!m_Locked.load(std::memory_order_relaxed) &&
+            !m_Locked.exchange(true, std::memory_order_acquire)) {
+            combine(apply);
+            m_Locked.store(false, std::memory_order_release);
+            continue;
+        }
+
+        if (++spins % kSpinsBeforeYield == 0)
+            std::this_thread::yield();
+    }
+
+    op = std::move(record.op);
+
+    record.state.store(Idle, std::memory_order_relaxed);
+    record.owned.store(false, std::memory_order_release);
+}
+
+//==========================================================
+// Claims a publication record for the calling thread,
+// starting from its preferred record
+//
+// \return        - The claimed record
+//==========================================================
+template<typename Op>
+typename FlatCombiner<Op>::Record& FlatCombiner<Op>::claim() {
+    auto index = thread_id() % kPublicationSlots;
+
+    while (true) {
+        for (std::size_t i = 0; i < kPublicationSlots; ++i) {
+            auto slot = (index + i) % kPublicationSlots;
+            auto& record = m_pRecords[slot];
+
+            if (record.owned.load(std::memory_order_relaxed) ||
+                record.owned.exchange(true, std::memory_order_acquire))
+                continue;
+
+            // Make sure the combiner's scan covers the record
+            auto used = m_Used.load(std::memory_order_relaxed);
+            while (used <= slot && !m_Used.compare_exchange_weak(used, slot + 1, std::memory_order_relaxed));
+
+            return record;
+        }
+
+        // Every record is in use, so wait for one to free up
+        std::this_thread::yield();
+    }
+}
+
+//==========================================================
+// Applies every pending request, scanning the records again
+// while the previous scan kept finding requests
+//
+// \param apply   - Applies a request to the sequential
+//                  structure
+//==========================================================
+template<typename Op>
+template<typename Apply>
+void FlatCombiner<Op>::combine(Apply& apply) {
+    for (std::size_t pass = 0; pass < kCombiningPasses; ++pass) {
+        std::size_t served = 0;
+        auto used = m_Used.load(std::memory_order_acquire);
+
+        for (std::size_t i = 0; i < used; ++i) {
+            auto& record = m_pRecords[i];
+            if (record.state.load(std::memory_order_acquire) != Pending)
+                continue;
+
+            apply(record.op);
+            record.state.store(Done, std::memory_order_release);
+            ++served;
+        }
+
+        if (served == 0)
+            break;
+    }
+}
+
+}  // namespace fc
+}  // namespace utility
@@ -0,0 +1,364 @@
+#pragma once
+
+#include "../utility/thread_records.h"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+
+namespace utility { namespace hp {
+
+// The number of hazard slots owned by each thread. The Michael and
+// Scott queue needs two (head and head->next), the stack needs one,
+// and the Harris-Michael list under the hash map needs three (the
+// predecessor, the current node and its successor)
+constexpr std::size_t kSlotsPerThread = 3;
+
+// The minimum number of retired nodes a thread buffers before it
+// scans the hazard records
+constexpr std::size_t kScanThreshold = 64;
+
+//==========================================================
+// A set of hazard slots owned by at most one thread at a
+// time
+//==========================================================
+struct Record {
+    Record()
+        : active(true), next(nullptr) {
+        for (auto& slot : slots)
+            slot.store(nullptr, std::memory_order_relaxed);
+    }
+
+    std::atomic<void*> slots[kSlotsPerThread];
+    std::atomic<bool> active;
+    Record* next;
+
+    // Keep neighbouring records off of each other's cache line
+    char padding[64];
+};
+
+//==========================================================
+// The process-wide hazard pointer domain. It owns the list
+// of hazard records and the nodes orphaned by exited threads
+//==========================================================
+class Domain {
+public:
+    static Domain& instance();
+
+    ~Domain();
+
+    // Prevent copying
+    Domain(const Domain& other) = delete;
+    Domain& operator=(const Domain& other) = delete;
+
+    Record* acquire();
+    void release(Record* record);
+
+    std::size_t record_count() const { return m_Records.size(); }
+
+    std::size_t scan(std::vector<Retired>& retired, std::vector<void*>& hazards);
+    void orphan(std::vector<Retired>& retired);
+
+    void account(std::ptrdiff_t delta);
+    std::size_t pending() const;
+
+private:
+    Domain() = default;
+
+    RecordList<Record> m_Records;
+    std::atomic<std::ptrdiff_t> m_Pending{ 0 };
+
+    std::mutex m_OrphanMut;
+    std::vector<Retired> m_Orphans;
+    std::atomic<bool> m_HasOrphans{ false };
+};
+
+//==========================================================
+// The per-thread view of the domain: the thread's hazard
+// record and its list of retired, not yet reclaimed nodes
+//==========================================================
+class ThreadContext {
+public:
+    ThreadContext();
+    ~ThreadContext();
+
+    // Prevent copying
+    ThreadContext(const ThreadContext& other) = delete;
+    ThreadContext& operator=(const ThreadContext& other) = delete;
+
+    Record* record() const { return m_pRecord; }
+
+    void retire(void* ptr, void (*reclaim)(void*));
+
+private:
+    void collect();
+
+    Record* m_pRecord;
+    std::vector<Retired> m_Retired;
+    std::vector<void*> m_Hazards;
+    std::size_t m_Reported = 0;
+};
+
+//==========================================================
+// Returns the calling thread's context, creating it on the
+// thread's first use of the domain
+//==========================================================
+inline ThreadContext& context() {
+    static thread_local ThreadContext ctx;
+    return ctx;
+}
+
+//==========================================================
+// A scoped owner of the calling thread's hazard slots. Every
+// slot that was published through the guard is cleared when
+// the guard goes out of scope
+//==========================================================
+class Guard {
+public:
+    Guard()
+        : m_pRecord(context().record()) {}
+
+    ~Guard() {
+        for (auto& slot : m_pRecord->slots)
+            slot.store(nullptr, std::memory_order_release);
+    }
+
+    // Prevent copying
+    Guard(const Guard& other) = delete;
+    Guard& operator=(const Guard& other) = delete;
+
+    template<typename Ptr>
+    Ptr protect(std::size_t slot, const std::atomic<Ptr>& src);
+
+    void clear(std::size_t slot) {
+        m_pRecord->slots[slot].store(nullptr, std::memory_order_release);
+    }
+
+private:
+    Record* m_pRecord;
+};
+
+//==========================================================
+// Hands an unlinked node to the calling thread's retire list.
+// The node is freed once no thread holds a hazard on it
+//
+// \param node    - The node that was unlinked
+//==========================================================
+template<typename Node>
+void retire(Node* node) {
+    context().retire(node, &utility::destroy_node<Node>);
+}
+
+//==========================================================
+// Domain definitions
+//==========================================================
+
+//==========================================================
+// Returns the process-wide domain
+//==========================================================
+inline Domain& Domain::instance() {
+    static Domain domain;
+    return domain;
+}
+
+//==========================================================
+// Frees any orphaned nodes. This only runs at static
+// destruction, after every thread has exited
+//==========================================================
+inline Domain::~Domain() {
+    for (auto& retired : m_Orphans)
+        retired.reclaim(retired.ptr);
+}
+
+//==========================================================
+// Hands the calling thread a hazard record
+//
+// \return      - The record owned by the calling thread
+//==========================================================
+inline Record* Domain::acquire() {
+    return m_Records.acquire();
+}
+
+//==========================================================
+// Clears the record's hazards and makes it available for
+// adoption by another thread
+//
+// \param record  - The record to release
+//==========================================================
+inline void Domain::release(Record* record) {
+    for (auto& slot : record->slots)
+        slot.store(nullptr, std::memory_order_release);
+
+    m_Records.release(record);
+}
+
+//==========================================================
+// Reclaims every node in \param{retired} that isn't covered
+// by a published hazard. Nodes that are still protected stay
+// in the list for a later scan
+//
+// \param retired   - The calling thread's retire list
+// \param hazards   - Scratch space for the hazard snapshot
+//
+// \return          - The number of nodes that were freed
+//==========================================================
+inline std::size_t Domain::scan(std::vector<Retired>& retired, std::vector<void*>& hazards) {
+    // Adopt the nodes left behind by exited threads
+    if (m_HasOrphans.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock{ m_OrphanMut };
+        retired.insert(retired.end(), m_Orphans.begin(), m_Orphans.end());
+        m_Orphans.clear();
+        m_HasOrphans.store(false, std::memory_order_relaxed);
+    }
+
+    hazards.clear();
+    for (auto pIter = m_Records.head(); pIter != nullptr; pIter = pIter->next) {
+        for (auto& slot : pIter->slots) {
+            // Sequentially consistent so the read is ordered after the
+            // unlinking of the retired nodes, pairing with protect()
+            auto hazard = slot.load(std::memory_order_seq_cst);
+            if (hazard != nullptr)
+                hazards.push_back(hazard);
+        }
+    }
+
+    std::sort(hazards.begin(), hazards.end());
+
+    auto kept = std::partition(retired.begin(), retired.end(),
+        [&hazards](const Retired& node) {
+            return std::binary_search(hazards.begin(), hazards.end(), node.ptr);
+        });
+
+    for (auto pIter = kept; pIter != retired.end(); ++pIter)
+        pIter->reclaim(pIter->ptr);
+
+    auto freed = static_cast<std::size_t>(retired.end() - kept);
+    retired.erase(kept, retired.end());
+
+    return freed;
+}
+
+//==========================================================
+// Takes ownership of the nodes an exiting thread couldn't
+// reclaim, so that the next scan by any thread frees them
+//
+// \param retired   - The exiting thread's retire list
+//==========================================================
+inline void Domain::orphan(std::vector<Retired>& retired) {
+    if (retired.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock{ m_OrphanMut };
+    m_Orphans.insert(m_Orphans.end(), retired.begin(), retired.end());
+    m_HasOrphans.store(true, std::memory_order_relaxed);
+    retired.clear();
+}
+
+//==========================================================
+// Adjusts the count of retired nodes awaiting reclamation
+//
+// \param delta   - The number of nodes retired (positive) or
+//                  freed (negative) since the last update
+//==========================================================
+inline void Domain::account(std::ptrdiff_t delta) {
+    m_Pending.fetch_add(delta, std::memory_order_relaxed);
+}
+
+//==========================================================
+// Returns the number of retired nodes awaiting reclamation,
+// as of each thread's most recent scan
+//==========================================================
+inline std::size_t Domain::pending() const {
+    auto pending = m_Pending.load(std::memory_order_relaxed);
+    return pending > 0 ? static_cast<std::size_t>(pending) : 0;
+}
+
+//==========================================================
+// ThreadContext definitions
+//==========================================================
+
+//==========================================================
+// Acquires a hazard record for the calling thread
+//==========================================================
+inline ThreadContext::ThreadContext()
+    : m_pRecord(Domain::instance().acquire()) {}
+
+//==========================================================
+// Releases the thread's record, and reclaims or orphans the
+// nodes still on its retire list
+//==========================================================
+inline ThreadContext::~ThreadContext() {
+    Domain::instance().release(m_pRecord);
+
+    if (!m_Retired.empty())
+        collect();
+
+    Domain::instance().orphan(m_Retired);
+}
+
+//==========================================================
+// Adds a node to the thread's retire list, and scans once the
+// list outgrows the number of hazards that could cover it.
+// This keeps the scan cost amortized to O(1) per retire
+//
+// \param ptr       - The unlinked node
+// \param reclaim   - The function that frees the node
+//==========================================================
+inline void ThreadContext::retire(void* ptr, void (*reclaim)(void*)) {
+    m_Retired.push_back(Retired{ ptr, reclaim });
+
+    auto threshold = std::max(kScanThreshold,
+        2 * kSlotsPerThread * Domain::instance().record_count());
+
+    if (m_Retired.size() >= threshold)
+        collect();
+}
+
+//==========================================================
+// Scans the thread's retire list, and reports the change in
+// the number of nodes awaiting reclamation to the domain
+//==========================================================
+inline void ThreadContext::collect() {
+    auto& domain = Domain::instance();
+    domain.account(static_cast<std::ptrdiff_t>(m_Retired.size() - m_Reported));
+
+    auto freed = domain.scan(m_Retired, m_Hazards);
+    domain.account(-static_cast<std::ptrdiff_t>(freed));
+
+    m_Reported = m_Retired.size();
+}
+
+//==========================================================
+// Guard definitions
+//==========================================================
+
+//==========================================================
+// Publishes a hazard on the node referenced by \param{src}
+// and returns the reference once the hazard is known to have
+// been published before the node could be retired
+//
+// \param slot    - The hazard slot to publish into
+// \param src     - The atomic reference to protect
+//
+// \return        - The protected reference
+//==========================================================
+template<typename Ptr>
+Ptr Guard::protect(std::size_t slot, const std::atomic<Ptr>& src) {
+    auto value = src.load(std::memory_order_acquire);
+    while (true) {
+        m_pRecord->slots[slot].store(value.get(), std::memory_order_seq_cst);
+
+        // If the reference is unchanged, then the node wasn't
+        // unlinked before our hazard became visible
+        auto current = src.load(std::memory_order_seq_cst);
+        if (current == value)
+            return value;
+
+        value = current;
+    }
+}
+
+}  // namespace hp
+}  // namespace utility
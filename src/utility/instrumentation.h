@@ -0,0 +1,303 @@
+#pragma once
+
+#include <mutex>
+#include <cstdint>
+#include <cstddef>
+
+//==========================================================
+// CDS_INSTRUMENTATION turns on the contention counters of
+// the stacks and queues. When it's zero, every hook below
+// is an empty inline function or an alias for the plain
+// std type, so the structures compile to the same code as
+// without them. snapshot() then always returns zeros
+//==========================================================
+#ifndef CDS_INSTRUMENTATION
+#define CDS_INSTRUMENTATION 0
+#endif
+
+#if CDS_INSTRUMENTATION
+#include "../utility/thread_records.h"
+
+#include <atomic>
+#include <chrono>
+#endif
+
+namespace utility { namespace instrumentation {
+
+//==========================================================
+// The events that are counted per thread
+//==========================================================
+enum class Counter : std::size_t {
+    CasAttempts,        // CASes on a structure's shared words
+    CasFailures,        // Of those, the ones another thread won
+    TailHelps,          // Times a thread advanced a lagging tail
+    EmptyDequeues,      // Dequeues that found the queue empty
+    EmptyPops,          // Pops that found the stack empty
+    LockAcquisitions,   // Mutex acquisitions
+    LockContended,      // Of those, the ones that had to wait
+    LockWaitNanos,      // Total time spent waiting for mutexes
+    Count
+};
+
+constexpr std::size_t kCounterCount = static_cast<std::size_t>(Counter::Count);
+
+// The retry histogram's buckets hold operations that retried
+// 0, 1, 2-3, 4-7, ... times; the last bucket holds the rest
+constexpr std::size_t kRetryBuckets = 8;
+
+constexpr bool enabled() { return CDS_INSTRUMENTATION != 0; }
+
+//==========================================================
+// Returns the name to export \param{counter} under
+//==========================================================
+inline const char* counter_name(Counter counter) {
+    static const char* const names[kCounterCount] = {
+        "cas_attempts",
+        "cas_failures",
+        "tail_helps",
+        "empty_dequeues",
+        "empty_pops",
+        "lock_acquisitions",
+        "lock_contended",
+        "lock_wait_ns",
+    };
+
+    return names[static_cast<std::size_t>(counter)];
+}
+
+//==========================================================
+// Returns the lowest number of retries that falls into
+// retry histogram bucket \param{bucket}
+//==========================================================
+inline std::uint64_t bucket_floor(std::size_t bucket) {
+    return bucket == 0 ? 0 : std::uint64_t{ 1 } << (bucket - 1);
+}
+
+//==========================================================
+// A point-in-time copy of the counters. Snapshots taken
+// before and after a workload can be subtracted to get the
+// counts for just that workload
+//==========================================================
+struct Snapshot {
+    std::uint64_t counters[kCounterCount] = {};
+    std::uint64_t retries[kRetryBuckets] = {};
+
+    std::uint64_t operator[](Counter counter) const {
+        return counters[static_cast<std::size_t>(counter)];
+    }
+
+    Snapshot& operator+=(const Snapshot& other) {
+        for (std::size_t i = 0; i < kCounterCount; ++i)
+            counters[i] += other.counters[i];
+
+        for (std::size_t i = 0; i < kRetryBuckets; ++i)
+            retries[i] += other.retries[i];
+
+        return *this;
+    }
+
+    Snapshot& operator-=(const Snapshot& other) {
+        for (std::size_t i = 0; i < kCounterCount; ++i)
+            counters[i] -= other.counters[i];
+
+        for (std::size_t i = 0; i < kRetryBuckets; ++i)
+            retries[i] -= other.retries[i];
+
+        return *this;
+    }
+};
+
+inline Snapshot operator-(Snapshot lhs, const Snapshot& rhs) {
+    lhs -= rhs;
+    return lhs;
+}
+
+#if CDS_INSTRUMENTATION
+
+//==========================================================
+// One thread's counters. Only the owning thread writes them,
+// so increments are a relaxed load and store rather than a
+// locked RMW; they're atomic so that snapshots can read them
+// while the owner runs. Records are reused by later threads,
+// which keeps every count in the totals
+//==========================================================
+struct Record {
+    Record()
+        : active(true), next(nullptr) {
+        for (auto& counter : counters)
+            counter.store(0, std::memory_order_relaxed);
+
+        for (auto& bucket : retries)
+            bucket.store(0, std::memory_order_relaxed);
+    }
+
+    std::atomic<std::uint64_t> counters[kCounterCount];
+    std::atomic<std::uint64_t> retries[kRetryBuckets];
+    std::atomic<bool> active;
+    Record* next;
+
+    // Keep neighbouring records off of each other's cache line
+    char padding[64];
+};
+
+//==========================================================
+// Returns the process-wide list of records. It's never
+// destroyed, so threads that exit during static destruction
+// can still release their records
+//==========================================================
+inline utility::RecordList<Record>& records() {
+    static auto pRecords = new utility::RecordList<Record>{};
+    return *pRecords;
+}
+
+//==========================================================
+// Owns the calling thread's record for the thread's lifetime
+//==========================================================
+class ThreadRecord {
+public:
+    ThreadRecord()
+        : m_pRecord(records().acquire()) {}
+
+    ~ThreadRecord() { records().release(m_pRecord); }
+
+    // Prevent copying
+    ThreadRecord(const ThreadRecord& other) = delete;
+    ThreadRecord& operator=(const ThreadRecord& other) = delete;
+
+    Record& get() const { return *m_pRecord; }
+
+private:
+    Record* m_pRecord;
+};
+
+inline Record& local() {
+    static thread_local ThreadRecord record;
+    return record.get();
+}
+
+inline void bump(std::atomic<std::uint64_t>& counter, std::uint64_t n) {
+    counter.store(counter.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+}
+
+//==========================================================
+// Adds \param{n} to the calling thread's \param{counter}
+//==========================================================
+inline void count(Counter counter, std::uint64_t n = 1) {
+    bump(local().counters[static_cast<std::size_t>(counter)], n);
+}
+
+//==========================================================
+// Counts a CAS on a shared word, and passes its result
+// through
+//
+// \param succeeded   - The result of the CAS
+//==========================================================
+inline bool cas(bool succeeded) {
+    auto& record = local();
+    bump(record.counters[static_cast<std::size_t>(Counter::CasAttempts)], 1);
+    if (!succeeded)
+        bump(record.counters[static_cast<std::size_t>(Counter::CasFailures)], 1);
+
+    return succeeded;
+}
+
+//==========================================================
+// Adds an operation that retried \param{count} times to the
+// calling thread's retry histogram
+//==========================================================
+inline void record_retries(std::uint64_t count) {
+    std::size_t bucket = 0;
+    while (count != 0 && bucket + 1 < kRetryBuckets) {
+        count >>= 1;
+        ++bucket;
+    }
+
+    bump(local().retries[bucket], 1);
+}
+
+//==========================================================
+// Sums the counters of every thread, live or exited
+//==========================================================
+inline Snapshot snapshot() {
+    Snapshot total{};
+    for (auto pIter = records().head(); pIter != nullptr; pIter = pIter->next) {
+        for (std::size_t i = 0; i < kCounterCount; ++i)
+            total.counters[i] += pIter->counters[i].load(std::memory_order_relaxed);
+
+        for (std::size_t i = 0; i < kRetryBuckets; ++i)
+            total.retries[i] += pIter->retries[i].load(std::memory_order_relaxed);
+    }
+
+    return total;
+}
+
+//==========================================================
+// Counts the failed attempts of one operation's retry loop,
+// and adds them to the histogram when the operation ends
+//==========================================================
+class RetryLoop {
+public:
+    RetryLoop() = default;
+    ~RetryLoop() { record_retries(m_Retries); }
+
+    // Prevent copying
+    RetryLoop(const RetryLoop& other) = delete;
+    RetryLoop& operator=(const RetryLoop& other) = delete;
+
+    void failed() { ++m_Retries; }
+
+private:
+    std::uint64_t m_Retries = 0;
+};
+
+//==========================================================
+// A std::lock_guard that counts its acquisition, and how
+// long it waited when the mutex was already held
+//==========================================================
+template<typename Mutex>
+class LockGuard {
+public:
+    explicit LockGuard(Mutex& mutex)
+        : m_Mutex(mutex) {
+        count(Counter::LockAcquisitions);
+        if (m_Mutex.try_lock())
+            return;
+
+        auto start = std::chrono::steady_clock::now();
+        m_Mutex.lock();
+        auto waited = std::chrono::steady_clock::now() - start;
+
+        count(Counter::LockContended);
+        count(Counter::LockWaitNanos, static_cast<std::uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count()));
+    }
+
+    ~LockGuard() { m_Mutex.unlock(); }
+
+    // Prevent copying
+    LockGuard(const LockGuard& other) = delete;
+    LockGuard& operator=(const LockGuard& other) = delete;
+
+private:
+    Mutex& m_Mutex;
+};
+
+#else
+
+inline void count(Counter, std::uint64_t = 1) {}
+inline bool cas(bool succeeded) { return succeeded; }
+inline void record_retries(std::uint64_t) {}
+inline Snapshot snapshot() { return Snapshot{}; }
+
+class RetryLoop {
+public:
+    void failed() {}
+};
+
+template<typename Mutex>
+using LockGuard = std::lock_guard<Mutex>;
+
+#endif
+
+}  // namespace instrumentation
+}  // namespace utility
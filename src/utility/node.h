@@ -1,50 +1,35 @@
 #pragma once
 
-namespace utility {
-
-//==========================================================
-// Represents an abstract base class for all node
-// implementations
-//==========================================================
-template<typename T>
-class NodeBase {
-public:
+#include <atomic>
+#include <utility>
 
-    virtual ~NodeBase() { }
-
-    virtual void set_value(T value) = 0;
-    virtual T get_value() = 0;
-
-    virtual void set_next(NodeBase<T>* next) = 0;
-    virtual NodeBase<T>* get_next() = 0;
-};
+namespace utility {
 
 //==========================================================
-// Represents a standard stack node
+// Represents a standard stack node. It's deliberately not
+// polymorphic: nodes carry no vptr, and every accessor is
+// inlined. The next pointer is published with release
+// semantics, so that the two-lock queue's dequeuer sees a
+// fully constructed node even though it's linked in under
+// the other lock
 //==========================================================
 template<typename T>
-class Node : public NodeBase<T> {
+class Node {
 public:
-    Node()
-        : m_value(T{}), m_pNext(nullptr) {}
-
-    explicit Node(T value)
-        : m_value(value), m_pNext(nullptr) {}
-
-    ~Node() {
-        delete m_pNext;
-        m_pNext = nullptr;
-    }
+    // Constructs the value in place from \param{args}
+    template<typename ...Args>
+    explicit Node(Args&& ...args)
+        : m_value(std::forward<Args>(args)...), m_pNext(nullptr) {}
 
-    virtual void set_value(T value) override { m_value = value; }
-    virtual void set_next(NodeBase<T>* next) override { m_pNext = next; }
+    void set_value(T&& value) { m_value = std::move(value); }
+    void set_next(Node<T>* next) { m_pNext.store(next, std::memory_order_release); }
 
-    virtual T get_value() override { return m_value; }
-    virtual NodeBase<T>* get_next() override { return m_pNext; }
+    T& get_value() { return m_value; }
+    Node<T>* get_next() { return m_pNext.load(std::memory_order_acquire); }
 
 private:
     T m_value;
-    NodeBase<T>* m_pNext;
+    std::atomic<Node<T>*> m_pNext;
 };
 
 } // namespace utility
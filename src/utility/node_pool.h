@@ -0,0 +1,386 @@
+#pragma once
+
+#include "../utility/tagged_ptr.h"
+
+#include <new>
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+
+namespace utility {
+
+// The number of blocks in a full magazine
+constexpr std::size_t kMagazineSize = 64;
+
+// The number of blocks carved out of each slab
+constexpr std::size_t kSlabSize = 8 * kMagazineSize;
+
+//==========================================================
+// A fixed-size allocator for the nodes of type T. Each thread
+// caches freed blocks in two magazines, and exchanges full
+// magazines with a lock-free global depot when its cache
+// overflows or runs dry. New blocks are carved sequentially
+// out of slabs, which keeps nodes allocated together close
+// together in memory.
+//
+// Slabs are never returned to the system: the pool lives for
+// the whole process, so that nodes freed during static or
+// thread-local destruction still have somewhere to go
+//==========================================================
+template<typename T>
+class NodePool {
+public:
+    template<typename ...Args>
+    static T* create(Args&& ...args);
+    static void destroy(T* node);
+
+    static void* allocate();
+    static void deallocate(void* ptr);
+
+private:
+    //======================================================
+    // A block's storage holds either a node or its links
+    // while it's free. The depot link lives outside of that
+    // storage: pop reads it from a magazine that another
+    // thread may have already popped and built nodes in, and
+    // that read has to see a block pointer, not a node
+    //======================================================
+    struct Block {
+        union {
+            struct {
+                Block* next;            // The next block in the magazine
+                std::size_t count;      // The magazine's size, while in the depot
+            } link;
+
+            typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        };
+
+        std::atomic<Block*> nextMagazine;   // The next magazine in the depot
+    };
+
+    static_assert(alignof(Block) <= alignof(std::max_align_t),
+        "NodePool doesn't support over-aligned nodes");
+
+    struct Magazine {
+        Block* head;
+        std::size_t count;
+    };
+
+    // The depot's top magazine, and an ABA counter
+    using MagazinePtr = utility::TaggedPtr<Block>;
+
+    struct Depot {
+        std::atomic<MagazinePtr> top;
+        std::atomic<Block*> slabs;
+    };
+
+    enum class State { Unregistered, Active, Exited };
+
+    // Trivially destructible so that it stays usable while
+    // other thread-local objects are being destroyed
+    struct Cache {
+        Magazine loaded;
+        Magazine previous;
+        Block* bump;
+        Block* bumpEnd;
+        State state;
+    };
+
+    // Returns the thread's cached blocks to the depot when the
+    // thread exits
+    struct Flusher {
+        ~Flusher();
+    };
+
+    static Depot& depot();
+    static Cache& cache();
+
+    static void refill(Cache& cache);
+    static void spill(Cache& cache);
+    static void carve(Cache& cache);
+    static void enroll(Cache& cache);
+
+    static void push(Block* head, std::size_t count);
+    static bool pop(Magazine& out);
+    static void push_range(Block* first, Block* last);
+};
+
+//==========================================================
+// Allocates a block and constructs a node in it
+//
+// \param args    - The arguments to construct the node with
+//
+// \return        - The new node
+//==========================================================
+template<typename T>
+template<typename ...Args>
+T* NodePool<T>::create(Args&& ...args) {
+    auto ptr = allocate();
+    try {
+        return new (ptr) T{ std::forward<Args>(args)... };
+    }
+    catch (...) {
+        deallocate(ptr);
+        throw;
+    }
+}
+
+//==========================================================
+// Destroys a node and returns its block to the pool
+//
+// \param node    - A node that was made by create()
+//==========================================================
+template<typename T>
+void NodePool<T>::destroy(T* node) {
+    node->~T();
+    deallocate(node);
+}
+
+//==========================================================
+// Takes a block from the calling thread's loaded magazine,
+// refilling the magazine first if it's empty
+//
+// \return        - Uninitialized storage for a T
+//==========================================================
+template<typename T>
+void* NodePool<T>::allocate() {
+    auto& local = cache();
+    if (local.loaded.count == 0)
+        refill(local);
+
+    auto block = local.loaded.head;
+    local.loaded.head = block->link.next;
+    --local.loaded.count;
+
+    return block;
+}
+
+//==========================================================
+// Returns a block to the calling thread's loaded magazine,
+// spilling to the depot first if the magazine is full
+//
+// \param ptr     - A block that was made by allocate()
+//==========================================================
+template<typename T>
+void NodePool<T>::deallocate(void* ptr) {
+    auto block = static_cast<Block*>(ptr);
+    auto& local = cache();
+
+    if (local.state != State::Active) {
+        // Blocks freed after the thread's cache was flushed go
+        // straight to the depot
+        if (local.state == State::Exited) {
+            block->link.next = nullptr;
+            push(block, 1);
+            return;
+        }
+
+        enroll(local);
+    }
+
+    if (local.loaded.count == kMagazineSize)
+        spill(local);
+
+    block->link.next = local.loaded.head;
+    local.loaded.head = block;
+    ++local.loaded.count;
+}
+
+//==========================================================
+// Returns the process-wide depot. It's deliberately never
+// destroyed, see the class comment
+//==========================================================
+template<typename T>
+typename NodePool<T>::Depot& NodePool<T>::depot() {
+    static Depot* pDepot = new Depot{};
+    return *pDepot;
+}
+
+//==========================================================
+// Returns the calling thread's cache
+//==========================================================
+template<typename T>
+typename NodePool<T>::Cache& NodePool<T>::cache() {
+    static thread_local Cache local{};
+    return local;
+}
+
+//==========================================================
+// Loads the calling thread's empty magazine, preferring the
+// spare magazine, then a full one from the depot, and then
+// fresh blocks from a slab
+//
+// \param local   - The calling thread's cache
+//==========================================================
+template<typename T>
+void NodePool<T>::refill(Cache& local) {
+    if (local.state == State::Unregistered)
+        enroll(local);
+
+    if (local.previous.count != 0) {
+        std::swap(local.loaded, local.previous);
+        return;
+    }
+
+    if (pop(local.loaded))
+        return;
+
+    carve(local);
+}
+
+//==========================================================
+// Makes room in the calling thread's full loaded magazine.
+// The spare magazine is always either empty or full; if it's
+// full, it goes to the depot and the loaded one replaces it
+//
+// \param local   - The calling thread's cache
+//==========================================================
+template<typename T>
+void NodePool<T>::spill(Cache& local) {
+    if (local.previous.count != 0)
+        push(local.previous.head, local.previous.count);
+
+    local.previous = local.loaded;
+    local.loaded = Magazine{ nullptr, 0 };
+}
+
+//==========================================================
+// Fills the loaded magazine with consecutive blocks from the
+// thread's current slab, allocating a new slab if needed
+//
+// \param local   - The calling thread's cache
+//==========================================================
+template<typename T>
+void NodePool<T>::carve(Cache& local) {
+    if (local.bump == local.bumpEnd) {
+        // The first block of each slab links it into the depot's
+        // list of slabs
+        auto slab = static_cast<Block*>(::operator new(sizeof(Block) * (kSlabSize + 1)));
+        auto& slabs = depot().slabs;
+        slab->link.next = slabs.load(std::memory_order_relaxed);
+        while (!slabs.compare_exchange_weak(slab->link.next, slab));
+
+        local.bump = slab + 1;
+        local.bumpEnd = slab + 1 + kSlabSize;
+    }
+
+    // Link the blocks in address order, so that they're handed
+    // out sequentially
+    auto count = std::min<std::size_t>(kMagazineSize, local.bumpEnd - local.bump);
+    for (std::size_t i = 0; i < count; ++i)
+        local.bump[i].link.next = (i + 1 < count) ? &local.bump[i + 1] : nullptr;
+
+    local.loaded = Magazine{ local.bump, count };
+    local.bump += count;
+}
+
+//==========================================================
+// Registers the thread's flusher on its first trip through
+// the slow path
+//
+// \param local   - The calling thread's cache
+//==========================================================
+template<typename T>
+void NodePool<T>::enroll(Cache& local) {
+    static thread_local Flusher flusher;
+    (void)flusher;
+
+    local.state = State::Active;
+}
+
+//==========================================================
+// Pushes a magazine onto the depot
+//
+// \param head    - The first block of the magazine
+// \param count   - The number of blocks in the magazine
+//==========================================================
+template<typename T>
+void NodePool<T>::push(Block* head, std::size_t count) {
+    head->link.count = count;
+
+    auto& top = depot().top;
+    auto current = top.load(std::memory_order_acquire);
+    MagazinePtr wrapper{};
+
+    do
+    {
+        head->nextMagazine.store(current.get(), std::memory_order_relaxed);
+        wrapper = MagazinePtr{ head, current.count() + 1 };
+    }
+    while (!top.compare_exchange_weak(current, wrapper));
+}
+
+//==========================================================
+// Pops a magazine off of the depot. The ABA counter guards
+// against the top being popped and pushed back in between
+// reading its successor and swapping it out. The successor
+// may be stale by the time it's read, but it's always a
+// block or null, and a stale one fails the CAS
+//
+// \param out     - Assigned the popped magazine
+//
+// \return        - False if the depot was empty
+//==========================================================
+template<typename T>
+bool NodePool<T>::pop(Magazine& out) {
+    auto& top = depot().top;
+    auto current = top.load(std::memory_order_acquire);
+    MagazinePtr wrapper{};
+
+    do
+    {
+        if (current.get() == nullptr)
+            return false;
+
+        wrapper = MagazinePtr{ current.get()->nextMagazine.load(std::memory_order_relaxed), current.count() + 1 };
+    }
+    while (!top.compare_exchange_weak(current, wrapper));
+
+    out = Magazine{ current.get(), current.get()->link.count };
+    return true;
+}
+
+//==========================================================
+// Pushes the blocks in [first, last) onto the depot as
+// magazines of up to kMagazineSize blocks
+//
+// \param first   - The first block in the range
+// \param last    - One past the last block in the range
+//==========================================================
+template<typename T>
+void NodePool<T>::push_range(Block* first, Block* last) {
+    while (first != last) {
+        auto count = std::min<std::size_t>(kMagazineSize, last - first);
+        for (std::size_t i = 0; i < count; ++i)
+            first[i].link.next = (i + 1 < count) ? &first[i + 1] : nullptr;
+
+        push(first, count);
+        first += count;
+    }
+}
+
+//==========================================================
+// Returns the exiting thread's magazines and the unused part
+// of its slab to the depot
+//==========================================================
+template<typename T>
+NodePool<T>::Flusher::~Flusher() {
+    auto& local = cache();
+
+    if (local.loaded.count != 0)
+        push(local.loaded.head, local.loaded.count);
+
+    if (local.previous.count != 0)
+        push(local.previous.head, local.previous.count);
+
+    push_range(local.bump, local.bumpEnd);
+
+    local.loaded = Magazine{ nullptr, 0 };
+    local.previous = Magazine{ nullptr, 0 };
+    local.bump = local.bumpEnd = nullptr;
+    local.state = State::Exited;
+}
+
+}  // namespace utility
@@ -0,0 +1,418 @@
+#pragma once
+
+#include "../utility/thread_records.h"
+
+#include <atomic>
+#include <mutex>
+#include <limits>
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+
+namespace utility { namespace qsbr {
+
+// The number of operations a thread completes between announcing
+// quiescent states. Larger values make each operation cheaper, but
+// delay reclamation
+constexpr std::size_t kQuiescentPeriod = 32;
+
+// The number of retired nodes a thread buffers before it seals
+// them into a batch that waits for a grace period
+constexpr std::size_t kBatchSize = 64;
+
+//==========================================================
+// The quiescent state announced by a single thread
+//==========================================================
+struct Record {
+    Record()
+        : quiescent(0), active(true), next(nullptr) {}
+
+    // The global counter as of the owning thread's most recent
+    // quiescent state, or zero while the thread is offline
+    std::atomic<std::uint64_t> quiescent;
+    std::atomic<bool> active;
+    Record* next;
+
+    // Keep neighbouring records off of each other's cache line
+    char padding[64];
+};
+
+//==========================================================
+// A set of retired nodes that can be freed once every online
+// thread has announced a quiescent state newer than the
+// batch's counter
+//==========================================================
+struct Batch {
+    std::uint64_t counter;
+    std::vector<Retired> nodes;
+};
+
+//==========================================================
+// The process-wide QSBR domain. Unlike epochs, operations
+// publish nothing on entry; a thread only pays for a store
+// every kQuiescentPeriod operations. The cost is that a
+// thread which stops operating while online holds back all
+// reclamation, so long-idle threads should go offline
+//==========================================================
+class Domain {
+public:
+    static Domain& instance();
+
+    ~Domain();
+
+    // Prevent copying
+    Domain(const Domain& other) = delete;
+    Domain& operator=(const Domain& other) = delete;
+
+    Record* acquire() { return m_Records.acquire(); }
+    void release(Record* record);
+
+    std::uint64_t counter() const { return m_Counter.load(std::memory_order_acquire); }
+    std::uint64_t advance() { return m_Counter.fetch_add(1, std::memory_order_acq_rel); }
+
+    std::size_t collect(std::vector<Batch>& batches);
+    void orphan(std::vector<Batch>& batches);
+
+    void account(std::ptrdiff_t delta);
+    std::size_t pending() const;
+
+private:
+    Domain() = default;
+
+    std::uint64_t oldest_quiescent() const;
+
+    RecordList<Record> m_Records;
+    std::atomic<std::uint64_t> m_Counter{ 1 };
+    std::atomic<std::ptrdiff_t> m_Pending{ 0 };
+
+    std::mutex m_OrphanMut;
+    std::vector<Batch> m_Orphans;
+    std::atomic<bool> m_HasOrphans{ false };
+};
+
+//==========================================================
+// The per-thread view of the domain: the thread's record,
+// and its retired nodes
+//==========================================================
+class ThreadContext {
+public:
+    ThreadContext();
+    ~ThreadContext();
+
+    // Prevent copying
+    ThreadContext(const ThreadContext& other) = delete;
+    ThreadContext& operator=(const ThreadContext& other) = delete;
+
+    void quiescent();
+    void completed();
+
+    void online();
+    void offline();
+
+    void retire(void* ptr, void (*reclaim)(void*));
+
+private:
+    void seal();
+    void collect();
+
+    Record* m_pRecord;
+    std::size_t m_Operations = 0;
+    std::vector<Retired> m_Pending;
+    std::vector<Batch> m_Batches;
+};
+
+//==========================================================
+// Returns the calling thread's context, bringing the thread
+// online on its first use of the domain
+//==========================================================
+inline ThreadContext& context() {
+    static thread_local ThreadContext ctx;
+    return ctx;
+}
+
+//==========================================================
+// Marks the extent of a single operation. Nothing is
+// published on entry; leaving the guard counts towards the
+// thread's next quiescent state
+//==========================================================
+class Guard {
+public:
+    Guard()
+        : m_Context(context()) {}
+
+    ~Guard() { m_Context.completed(); }
+
+    // Prevent copying
+    Guard(const Guard& other) = delete;
+    Guard& operator=(const Guard& other) = delete;
+
+    //==========================================================
+    // Loads the reference. A node can't be freed until this
+    // thread's next quiescent state, so there's nothing to
+    // publish
+    //==========================================================
+    template<typename Ptr>
+    Ptr protect(std::size_t, const std::atomic<Ptr>& src) {
+        return src.load(std::memory_order_acquire);
+    }
+
+private:
+    ThreadContext& m_Context;
+};
+
+//==========================================================
+// Takes the calling thread offline for the scope's lifetime,
+// so that a thread which blocks or idles doesn't hold back
+// reclamation. No structure may be accessed in the scope
+//==========================================================
+class OfflineScope {
+public:
+    OfflineScope() { context().offline(); }
+    ~OfflineScope() { context().online(); }
+
+    // Prevent copying
+    OfflineScope(const OfflineScope& other) = delete;
+    OfflineScope& operator=(const OfflineScope& other) = delete;
+};
+
+//==========================================================
+// Hands an unlinked node to the calling thread's retire list.
+// The node is freed after every online thread has passed
+// through a quiescent state
+//
+// \param node    - The node that was unlinked
+//==========================================================
+template<typename Node>
+void retire(Node* node) {
+    context().retire(node, &utility::destroy_node<Node>);
+}
+
+//==========================================================
+// Domain definitions
+//==========================================================
+
+//==========================================================
+// Returns the process-wide domain
+//==========================================================
+inline Domain& Domain::instance() {
+    static Domain domain;
+    return domain;
+}
+
+//==========================================================
+// Frees any orphaned nodes. This only runs at static
+// destruction, after every thread has exited
+//==========================================================
+inline Domain::~Domain() {
+    for (auto& batch : m_Orphans)
+        for (auto& node : batch.nodes)
+            node.reclaim(node.ptr);
+}
+
+//==========================================================
+// Takes the record offline and makes it available for
+// adoption by another thread
+//
+// \param record  - The record to release
+//==========================================================
+inline void Domain::release(Record* record) {
+    record->quiescent.store(0, std::memory_order_release);
+    m_Records.release(record);
+}
+
+//==========================================================
+// Returns the oldest quiescent state announced by an online
+// thread, or the maximum value if every thread is offline
+//==========================================================
+inline std::uint64_t Domain::oldest_quiescent() const {
+    auto oldest = std::numeric_limits<std::uint64_t>::max();
+    for (auto pIter = m_Records.head(); pIter != nullptr; pIter = pIter->next) {
+        auto quiescent = pIter->quiescent.load(std::memory_order_acquire);
+        if (quiescent != 0)
+            oldest = std::min(oldest, quiescent);
+    }
+
+    return oldest;
+}
+
+//==========================================================
+// Frees every batch in \param{batches} whose grace period
+// has elapsed
+//
+// \param batches   - The calling thread's sealed batches
+//
+// \return          - The number of nodes that were freed
+//==========================================================
+inline std::size_t Domain::collect(std::vector<Batch>& batches) {
+    // Adopt the batches left behind by exited threads
+    if (m_HasOrphans.load(std::memory_order_relaxed)) {
+        std::lock_guard<std::mutex> lock{ m_OrphanMut };
+        for (auto& batch : m_Orphans)
+            batches.push_back(std::move(batch));
+
+        m_Orphans.clear();
+        m_HasOrphans.store(false, std::memory_order_relaxed);
+    }
+
+    auto oldest = oldest_quiescent();
+    auto kept = std::partition(batches.begin(), batches.end(),
+        [oldest](const Batch& batch) { return batch.counter >= oldest; });
+
+    std::size_t freed = 0;
+    for (auto pIter = kept; pIter != batches.end(); ++pIter) {
+        for (auto& node : pIter->nodes)
+            node.reclaim(node.ptr);
+
+        freed += pIter->nodes.size();
+    }
+
+    batches.erase(kept, batches.end());
+    return freed;
+}
+
+//==========================================================
+// Takes ownership of the batches an exiting thread couldn't
+// free, so that the next collection by any thread frees them
+//
+// \param batches   - The exiting thread's sealed batches
+//==========================================================
+inline void Domain::orphan(std::vector<Batch>& batches) {
+    if (batches.empty())
+        return;
+
+    std::lock_guard<std::mutex> lock{ m_OrphanMut };
+    for (auto& batch : batches)
+        m_Orphans.push_back(std::move(batch));
+
+    m_HasOrphans.store(true, std::memory_order_relaxed);
+    batches.clear();
+}
+
+//==========================================================
+// Adjusts the count of retired nodes awaiting reclamation
+//
+// \param delta   - The number of nodes retired (positive) or
+//                  freed (negative) since the last update
+//==========================================================
+inline void Domain::account(std::ptrdiff_t delta) {
+    m_Pending.fetch_add(delta, std::memory_order_relaxed);
+}
+
+//==========================================================
+// Returns the number of retired nodes awaiting reclamation,
+// as of each thread's most recently sealed batch
+//==========================================================
+inline std::size_t Domain::pending() const {
+    auto pending = m_Pending.load(std::memory_order_relaxed);
+    return pending > 0 ? static_cast<std::size_t>(pending) : 0;
+}
+
+//==========================================================
+// ThreadContext definitions
+//==========================================================
+
+//==========================================================
+// Acquires a record for the calling thread and brings it
+// online
+//==========================================================
+inline ThreadContext::ThreadContext()
+    : m_pRecord(Domain::instance().acquire()) {
+    online();
+}
+
+//==========================================================
+// Takes the thread offline, and frees or orphans the nodes
+// still on its retire list
+//==========================================================
+inline ThreadContext::~ThreadContext() {
+    Domain::instance().release(m_pRecord);
+
+    seal();
+    collect();
+
+    Domain::instance().orphan(m_Batches);
+}
+
+//==========================================================
+// Announces that the thread holds no references into any
+// structure, and frees the batches whose grace period has
+// elapsed
+//==========================================================
+inline void ThreadContext::quiescent() {
+    m_pRecord->quiescent.store(Domain::instance().counter(), std::memory_order_release);
+
+    if (!m_Batches.empty())
+        collect();
+}
+
+//==========================================================
+// Counts a completed operation, announcing a quiescent state
+// every kQuiescentPeriod operations
+//==========================================================
+inline void ThreadContext::completed() {
+    if (++m_Operations < kQuiescentPeriod)
+        return;
+
+    m_Operations = 0;
+    quiescent();
+}
+
+//==========================================================
+// Brings the thread back online. It holds no references
+// yet, so this is also a quiescent state
+//==========================================================
+inline void ThreadContext::online() {
+    m_pRecord->quiescent.store(Domain::instance().counter(), std::memory_order_seq_cst);
+}
+
+//==========================================================
+// Takes the thread offline, so that grace periods no longer
+// wait on it
+//==========================================================
+inline void ThreadContext::offline() {
+    m_pRecord->quiescent.store(0, std::memory_order_release);
+}
+
+//==========================================================
+// Adds a node to the thread's pending list, sealing it into
+// a batch once it's full
+//
+// \param ptr       - The unlinked node
+// \param reclaim   - The function that frees the node
+//==========================================================
+inline void ThreadContext::retire(void* ptr, void (*reclaim)(void*)) {
+    m_Pending.push_back(Retired{ ptr, reclaim });
+
+    if (m_Pending.size() >= kBatchSize)
+        seal();
+}
+
+//==========================================================
+// Seals the pending nodes into a batch. Advancing the
+// counter starts the batch's grace period: it ends once
+// every online thread announces a newer counter
+//==========================================================
+inline void ThreadContext::seal() {
+    if (m_Pending.empty())
+        return;
+
+    auto& domain = Domain::instance();
+    domain.account(static_cast<std::ptrdiff_t>(m_Pending.size()));
+
+    m_Batches.push_back(Batch{ domain.advance(), std::move(m_Pending) });
+    m_Pending.clear();
+    m_Pending.reserve(kBatchSize);
+}
+
+//==========================================================
+// Frees the thread's batches whose grace period elapsed
+//==========================================================
+inline void ThreadContext::collect() {
+    auto& domain = Domain::instance();
+    auto freed = domain.collect(m_Batches);
+    domain.account(-static_cast<std::ptrdiff_t>(freed));
+}
+
+}  // namespace qsbr
+}  // namespace utility
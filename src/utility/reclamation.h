@@ -0,0 +1,108 @@
+#pragma once
+
+#include "../utility/hazard_pointer.h"
+#include "../utility/epoch.h"
+#include "../utility/qsbr.h"
+
+#include <atomic>
+#include <cstddef>
+
+//==========================================================
+// Memory reclamation policies for the lock-free structures.
+// Each policy provides:
+//
+//   Guard          - Scoped around a single operation. Its
+//                    protect(slot, src) loads an atomic node
+//                    reference that stays dereferenceable
+//                    until the guard is destroyed. References
+//                    expose their node through get()
+//   retire(node)   - Frees an unlinked node once no guard
+//                    can still reference it. The node must
+//                    have been made by utility::NodePool
+//   pending()      - The number of retired nodes that are
+//                    still awaiting reclamation
+//==========================================================
+namespace utility { namespace reclaim {
+
+//==========================================================
+// Never frees retired nodes. This is the baseline that the
+// other policies are measured against
+//==========================================================
+struct Leak {
+    class Guard {
+    public:
+        template<typename Ptr>
+        Ptr protect(std::size_t, const std::atomic<Ptr>& src) {
+            return src.load(std::memory_order_acquire);
+        }
+    };
+
+    template<typename Node>
+    static void retire(Node*) {
+        // Count in per-thread batches to keep the shared counter
+        // off of the hot path
+        static thread_local std::size_t leaked = 0;
+        if (++leaked == kReportInterval) {
+            counter().fetch_add(leaked, std::memory_order_relaxed);
+            leaked = 0;
+        }
+    }
+
+    static std::size_t pending() {
+        return counter().load(std::memory_order_relaxed);
+    }
+
+private:
+    static constexpr std::size_t kReportInterval = 64;
+
+    static std::atomic<std::size_t>& counter() {
+        static std::atomic<std::size_t> leaked{ 0 };
+        return leaked;
+    }
+};
+
+//==========================================================
+// Publishes a hazard pointer for every node an operation
+// dereferences. Bounds the number of unreclaimed nodes, at
+// the cost of a fenced store per protected reference
+//==========================================================
+struct HazardPointers {
+    using Guard = utility::hp::Guard;
+
+    template<typename Node>
+    static void retire(Node* node) { utility::hp::retire(node); }
+
+    static std::size_t pending() { return utility::hp::Domain::instance().pending(); }
+};
+
+//==========================================================
+// Pins each operation to the global epoch. Costs one fenced
+// store per operation, but a stalled thread holds back all
+// reclamation while it's pinned
+//==========================================================
+struct Epoch {
+    using Guard = utility::epoch::Guard;
+
+    template<typename Node>
+    static void retire(Node* node) { utility::epoch::retire(node); }
+
+    static std::size_t pending() { return utility::epoch::Domain::instance().pending(); }
+};
+
+//==========================================================
+// Quiescent-state-based reclamation. Operations publish
+// nothing; threads periodically announce that they hold no
+// references. Online threads that idle hold back all
+// reclamation, see utility::qsbr::OfflineScope
+//==========================================================
+struct QSBR {
+    using Guard = utility::qsbr::Guard;
+
+    template<typename Node>
+    static void retire(Node* node) { utility::qsbr::retire(node); }
+
+    static std::size_t pending() { return utility::qsbr::Domain::instance().pending(); }
+};
+
+}  // namespace reclaim
+}  // namespace utility
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstddef>
+
+//==========================================================
+// CDS_TAGGED_POINTERS selects how the lock-free structures
+// pair their pointers with ABA counters. When it's zero, the
+// pair is two words wide, and swapping it needs a double-
+// width CAS (-mcx16 and libatomic with GCC). When it's one,
+// the counter is packed into the bits of the pointer that
+// are always zero, so the pair fits in a single word
+//==========================================================
+#ifndef CDS_TAGGED_POINTERS
+#define CDS_TAGGED_POINTERS 0
+#endif
+
+#if CDS_TAGGED_POINTERS && !(defined(__x86_64__) || defined(_M_X64) || defined(__aarch64__) || defined(_M_ARM64))
+#error "CDS_TAGGED_POINTERS requires a 64-bit target with 48-bit virtual addresses"
+#endif
+
+namespace utility {
+
+#if CDS_TAGGED_POINTERS
+
+namespace tagged {
+
+// User space addresses fit in the low 48 bits on x86-64 and
+// AArch64, which leaves the upper 16 bits for the counter
+constexpr unsigned kAddressBits = 48;
+
+// Nodes are at least 8 byte aligned, so the low 3 bits of
+// their addresses hold the low bits of the counter
+constexpr unsigned kAlignmentBits = 3;
+constexpr std::size_t kMinAlignment = std::size_t{ 1 } << kAlignmentBits;
+
+constexpr std::uintptr_t kLowMask = (std::uintptr_t{ 1 } << kAlignmentBits) - 1;
+constexpr std::uintptr_t kAddressMask = ((std::uintptr_t{ 1 } << kAddressBits) - 1) & ~kLowMask;
+
+}  // namespace tagged
+
+//==========================================================
+// A pointer paired with an ABA counter, packed into a single
+// word. The counter is 19 bits wide and wraps, which is
+// enough for it to change between a thread's load and its
+// CAS; the reclamation policies keep a node that a thread
+// still references from being reused in any case
+//==========================================================
+template<typename T>
+class TaggedPtr {
+public:
+    TaggedPtr() = default;
+
+    TaggedPtr(T* ptr, std::size_t count)
+        : m_Bits(pack(ptr, count)) {}
+
+    T* get() const {
+        return reinterpret_cast<T*>(m_Bits & tagged::kAddressMask);
+    }
+
+    std::size_t count() const {
+        return static_cast<std::size_t>((m_Bits & tagged::kLowMask) |
+            ((m_Bits >> tagged::kAddressBits) << tagged::kAlignmentBits));
+    }
+
+    bool operator==(const TaggedPtr& other) const { return m_Bits == other.m_Bits; }
+    bool operator!=(const TaggedPtr& other) const { return m_Bits != other.m_Bits; }
+
+private:
+    static std::uintptr_t pack(T* ptr, std::size_t count) {
+        static_assert(alignof(T) >= tagged::kMinAlignment,
+            "TaggedPtr needs the low bits of the pointer to be free");
+
+        auto address = reinterpret_cast<std::uintptr_t>(ptr);
+        assert((address & ~tagged::kAddressMask) == 0);
+
+        auto tag = static_cast<std::uintptr_t>(count);
+        return address | (tag & tagged::kLowMask) |
+            ((tag >> tagged::kAlignmentBits) << tagged::kAddressBits);
+    }
+
+    std::uintptr_t m_Bits;
+};
+
+static_assert(sizeof(TaggedPtr<std::uint64_t>) == sizeof(void*),
+    "A tagged pointer must fit in a single word");
+
+#if defined(__cpp_lib_atomic_is_always_lock_free)
+static_assert(std::atomic<TaggedPtr<std::uint64_t>>::is_always_lock_free,
+    "A tagged pointer must be swapped with a single-width CAS");
+#else
+static_assert(ATOMIC_POINTER_LOCK_FREE == 2,
+    "A tagged pointer must be swapped with a single-width CAS");
+#endif
+
+#else
+
+//==========================================================
+// A pointer paired with a full-width ABA counter. Swapping
+// it needs a double-width CAS
+//==========================================================
+template<typename T>
+class alignas(2 * sizeof(void*)) TaggedPtr {
+public:
+    TaggedPtr() = default;
+
+    TaggedPtr(T* ptr, std::size_t count)
+        : m_Ptr(ptr), m_Count(count) {}
+
+    T* get() const { return m_Ptr; }
+    std::size_t count() const { return m_Count; }
+
+    bool operator==(const TaggedPtr& other) const {
+        return m_Ptr == other.m_Ptr && m_Count == other.m_Count;
+    }
+
+    bool operator!=(const TaggedPtr& other) const {
+        return !(*this == other);
+    }
+
+private:
+    T* m_Ptr;
+    std::size_t m_Count;
+};
+
+#endif
+
+}  // namespace utility
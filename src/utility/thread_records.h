@@ -0,0 +1,110 @@
+#pragma once
+
+#include "../utility/node_pool.h"
+
+#include <atomic>
+#include <cstddef>
+
+namespace utility {
+
+//==========================================================
+// A node that has been unlinked from its structure, paired
+// with the function that frees it once it's safe to do so
+//==========================================================
+struct Retired {
+    void* ptr;
+    void (*reclaim)(void*);
+};
+
+//==========================================================
+// Frees a retired node of the given type. Retired nodes are
+// always allocated from the node's NodePool
+//==========================================================
+template<typename Node>
+void destroy_node(void* ptr) {
+    utility::NodePool<Node>::destroy(static_cast<Node*>(ptr));
+}
+
+//==========================================================
+// A grow-only, lock-free list of per-thread records, as used
+// by the memory reclamation schemes. Records are never freed
+// while the list is alive; a thread that exits releases its
+// record so that a later thread can adopt it.
+//
+// Record must be default constructible, and expose an atomic
+// bool named active and a Record* named next
+//==========================================================
+template<typename Record>
+class RecordList {
+public:
+    RecordList() = default;
+    ~RecordList();
+
+    // Prevent copying
+    RecordList(const RecordList& other) = delete;
+    RecordList& operator=(const RecordList& other) = delete;
+
+    Record* acquire();
+    void release(Record* record);
+
+    Record* head() const { return m_pHead.load(std::memory_order_acquire); }
+    std::size_t size() const { return m_Size.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<Record*> m_pHead{ nullptr };
+    std::atomic<std::size_t> m_Size{ 0 };
+};
+
+//==========================================================
+// Frees every record. This only runs once no thread can be
+// using the list
+//==========================================================
+template<typename Record>
+RecordList<Record>::~RecordList() {
+    auto pIter = m_pHead.load(std::memory_order_acquire);
+    while (pIter != nullptr) {
+        auto record = pIter;
+        pIter = pIter->next;
+        delete record;
+    }
+}
+
+//==========================================================
+// Hands the calling thread a record, reusing one that was
+// released by an exited thread where possible
+//
+// \return      - The record owned by the calling thread
+//==========================================================
+template<typename Record>
+Record* RecordList<Record>::acquire() {
+    for (auto pIter = head(); pIter != nullptr; pIter = pIter->next) {
+        bool expected = false;
+        if (!pIter->active.load(std::memory_order_relaxed) &&
+            pIter->active.compare_exchange_strong(expected, true))
+            return pIter;
+    }
+
+    auto record = new Record{};
+    auto top = m_pHead.load(std::memory_order_relaxed);
+    do
+    {
+        record->next = top;
+    }
+    while (!m_pHead.compare_exchange_weak(top, record));
+
+    m_Size.fetch_add(1, std::memory_order_relaxed);
+    return record;
+}
+
+//==========================================================
+// Makes the record available for adoption by another thread.
+// The caller resets the record's state beforehand
+//
+// \param record  - The record to release
+//==========================================================
+template<typename Record>
+void RecordList<Record>::release(Record* record) {
+    record->active.store(false, std::memory_order_release);
+}
+
+}  // namespace utility
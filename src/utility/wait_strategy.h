@@ -0,0 +1,185 @@
+#pragma once
+
+#include "../utility/backoff.h"
+#include "../utility/event_count.h"
+
+#include <chrono>
+#include <thread>
+#include <cstddef>
+
+namespace utility {
+
+//==========================================================
+// Wait strategies for the blocking adapters. Each strategy
+// is owned by the structure it waits on, and provides:
+//
+//   wait(attempt)              - Calls attempt() until it
+//                                returns true
+//   wait_until(attempt, time)  - Likewise, but gives up once
+//                                the deadline has passed and
+//                                returns false
+//   notify_one()               - Called after the structure
+//                                gains a value
+//   notify_all()               - Called after the structure
+//                                gains several values
+//
+// attempt() is the structure's non-blocking operation, such
+// as dequeue(out)
+//==========================================================
+namespace wait {
+
+// The number of times a waiter polls before it starts to
+// yield or park
+constexpr std::size_t kSpinsBeforeBlocking = 128;
+
+//==========================================================
+// Polls without ever giving up the core. The lowest latency
+// wake up, at the cost of a core per waiting thread
+//==========================================================
+struct BusySpin {
+    template<typename Attempt>
+    void wait(Attempt attempt) {
+        while (!attempt())
+            utility::cpu_relax();
+    }
+
+    template<typename Attempt, typename Clock, typename Duration>
+    bool wait_until(Attempt attempt, const std::chrono::time_point<Clock, Duration>& deadline) {
+        while (!attempt()) {
+            if (Clock::now() >= deadline)
+                return false;
+
+            utility::cpu_relax();
+        }
+
+        return true;
+    }
+
+    void notify_one() {}
+    void notify_all() {}
+};
+
+//==========================================================
+// Polls for a while, then yields the core between polls. The
+// waiter stays runnable, so it still shows up as busy, but
+// it doesn't starve the threads that would wake it
+//==========================================================
+struct SpinYield {
+    template<typename Attempt>
+    void wait(Attempt attempt) {
+        for (std::size_t spins = 0; !attempt(); ++spins) {
+            if (spins < kSpinsBeforeBlocking)
+                utility::cpu_relax();
+            else
+                std::this_thread::yield();
+        }
+    }
+
+    template<typename Attempt, typename Clock, typename Duration>
+    bool wait_until(Attempt attempt, const std::chrono::time_point<Clock, Duration>& deadline) {
+        for (std::size_t spins = 0; !attempt(); ++spins) {
+            if (Clock::now() >= deadline)
+                return false;
+
+            if (spins < kSpinsBeforeBlocking)
+                utility::cpu_relax();
+            else
+                std::this_thread::yield();
+        }
+
+        return true;
+    }
+
+    void notify_one() {}
+    void notify_all() {}
+};
+
+//==========================================================
+// Polls for a while, then parks on an eventcount until it's
+// notified. Notifying costs a fence and a load while nobody
+// is parked, so producers only make a syscall when a waiter
+// actually exists
+//==========================================================
+class SpinPark {
+public:
+    SpinPark() = default;
+
+    // Prevent copying
+    SpinPark(const SpinPark& other) = delete;
+    SpinPark& operator=(const SpinPark& other) = delete;
+
+    template<typename Attempt>
+    void wait(Attempt attempt);
+
+    template<typename Attempt, typename Clock, typename Duration>
+    bool wait_until(Attempt attempt, const std::chrono::time_point<Clock, Duration>& deadline);
+
+    void notify_one() { m_Event.notify_one(); }
+    void notify_all() { m_Event.notify_all(); }
+
+private:
+    utility::EventCount m_Event;
+};
+
+//==========================================================
+// Spins, then parks until attempt() succeeds
+//
+// \param attempt   - The non-blocking operation to retry
+//==========================================================
+template<typename Attempt>
+void SpinPark::wait(Attempt attempt) {
+    for (std::size_t spins = 0; spins < kSpinsBeforeBlocking; ++spins) {
+        if (attempt())
+            return;
+
+        utility::cpu_relax();
+    }
+
+    while (true) {
+        auto key = m_Event.prepare_wait();
+        if (attempt()) {
+            m_Event.cancel_wait();
+            return;
+        }
+
+        m_Event.wait(key);
+        if (attempt())
+            return;
+    }
+}
+
+//==========================================================
+// Spins, then parks until attempt() succeeds or the deadline
+// passes
+//
+// \param attempt   - The non-blocking operation to retry
+// \param deadline  - When to give up
+//
+// \return          - False if the deadline passed first
+//==========================================================
+template<typename Attempt, typename Clock, typename Duration>
+bool SpinPark::wait_until(Attempt attempt, const std::chrono::time_point<Clock, Duration>& deadline) {
+    for (std::size_t spins = 0; spins < kSpinsBeforeBlocking; ++spins) {
+        if (attempt())
+            return true;
+
+        utility::cpu_relax();
+    }
+
+    while (true) {
+        auto key = m_Event.prepare_wait();
+        if (attempt()) {
+            m_Event.cancel_wait();
+            return true;
+        }
+
+        if (!m_Event.wait_until(key, deadline))
+            return attempt();
+
+        if (attempt())
+            return true;
+    }
+}
+
+}  // namespace wait
+}  // namespace utility